@@ -0,0 +1,175 @@
+/**
+ * @file        clock.cpp
+ * @brief       Monotonic library clock
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#include "clock.hpp"
+#include <QDebug>
+#include <algorithm>
+
+using namespace OTP::CLOCK;
+
+namespace
+{
+    std::atomic<const source_t*> source = nullptr;
+    std::atomic<virtualClock_t*> installedVirtualClock = nullptr;
+}
+
+void OTP::CLOCK::setSource(const source_t *value)
+{
+    source.store(value, std::memory_order_release);
+}
+
+const source_t *OTP::CLOCK::getSource()
+{
+    return source.load(std::memory_order_acquire);
+}
+
+ticks_t OTP::CLOCK::now()
+{
+    if (const auto current = source.load(std::memory_order_acquire))
+        return current->now();
+
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+                std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+virtualClock_t::virtualClock_t(ticks_t start) :
+    current(start)
+{
+    if (installedVirtualClock.load()) qDebug() << "Virtual clock - Replacing installed virtual clock";
+    installedVirtualClock.store(this);
+    setSource(this);
+}
+
+virtualClock_t::~virtualClock_t()
+{
+    for (const auto &[due, timer] : timers)
+        timer->virtualClock = nullptr;
+    timers.clear();
+
+    if (getSource() == this) setSource(nullptr);
+    virtualClock_t *expected = this;
+    installedVirtualClock.compare_exchange_strong(expected, nullptr);
+}
+
+void virtualClock_t::advance(std::chrono::nanoseconds duration)
+{
+    const auto target = now() + toTicks(duration);
+    while (!timers.empty() && (timers.begin()->first <= target))
+    {
+        const auto [due, timer] = *timers.begin();
+        timers.erase(timers.begin());
+        current.store(due, std::memory_order_release);
+        timer->expire();
+    }
+    current.store(target, std::memory_order_release);
+}
+
+virtualClock_t *virtualClock_t::getInstalled()
+{
+    const auto ret = installedVirtualClock.load();
+    return (ret && (getSource() == ret)) ? ret : nullptr;
+}
+
+void virtualClock_t::schedule(Timer *timer, ticks_t due)
+{
+    timers.insert({due, timer});
+}
+
+void virtualClock_t::cancel(Timer *timer, ticks_t due)
+{
+    auto [it, end] = timers.equal_range(due);
+    for (; it != end; ++it)
+    {
+        if (it->second != timer) continue;
+        timers.erase(it);
+        return;
+    }
+}
+
+Timer::Timer(QObject *parent) :
+    QObject(parent)
+{
+    connect(&timer, &QTimer::timeout, this, &Timer::timeout);
+}
+
+Timer::~Timer()
+{
+    stop();
+}
+
+void Timer::setInterval(std::chrono::milliseconds value)
+{
+    intervalTime = value;
+    timer.setInterval(value);
+
+    // Restart from now, as QTimer does
+    if (virtualClock) start();
+}
+
+void Timer::setSingleShot(bool value)
+{
+    singleShot = value;
+    timer.setSingleShot(value);
+}
+
+void Timer::start(std::chrono::milliseconds value)
+{
+    intervalTime = value;
+    timer.setInterval(value);
+    start();
+}
+
+void Timer::start()
+{
+    stop();
+    virtualClock = virtualClock_t::getInstalled();
+    if (virtualClock)
+    {
+        due = virtualClock->now() + toTicks(intervalTime);
+        virtualClock->schedule(this, due);
+    } else
+        timer.start();
+}
+
+void Timer::stop()
+{
+    timer.stop();
+    if (virtualClock)
+    {
+        virtualClock->cancel(this, due);
+        virtualClock = nullptr;
+        due = never;
+    }
+}
+
+void Timer::expire()
+{
+    if (singleShot)
+    {
+        virtualClock = nullptr;
+        due = never;
+    } else {
+        // A zero interval still waits for the next instant, so advance() always completes
+        due += std::max<ticks_t>(toTicks(intervalTime), 1);
+        virtualClock->schedule(this, due);
+    }
+    emit timeout();
+}
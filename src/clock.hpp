@@ -0,0 +1,302 @@
+/**
+ * @file        clock.hpp
+ * @brief       Monotonic library clock
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef CLOCK_HPP
+#define CLOCK_HPP
+
+#include <QObject>
+#include <QDateTime>
+#include <QTimer>
+#include <atomic>
+#include <chrono>
+#include <limits>
+#include <map>
+
+/**
+ * @internal
+ * @brief Monotonic library clock
+ * @details Liveness is tracked in ticks of a steady clock, which are cheap to read and compare
+ * and are unaffected by changes to the wall clock.
+ *
+ * Ticks are only converted to a QDateTime when returned by the public API.
+ *
+ * The time source can be replaced, such as with a virtualClock_t to run expiry and discovery in accelerated time.
+ * Timers driven by the library clock are created with CLOCK::Timer.
+ */
+namespace OTP::CLOCK
+{
+    /**
+     * @brief Clock ticks, in nanoseconds
+     */
+    typedef qint64 ticks_t;
+
+    /**
+     * @brief Ticks of an event that has never happened
+     * @details Earlier than any other tick
+     */
+    constexpr ticks_t never = std::numeric_limits<ticks_t>::min();
+
+    /**
+     * @brief Source of clock ticks
+     *
+     */
+    class source_t
+    {
+    public:
+        virtual ~source_t() = default;
+
+        /**
+         * @brief Get the current time
+         *
+         * @return Current ticks
+         */
+        virtual ticks_t now() const = 0;
+    };
+
+    /**
+     * @brief Replace the time source
+     * @details The source is not owned, and must outlive its use
+     *
+     * @param source New time source, or nullptr for the steady clock
+     */
+    void setSource(const source_t *source);
+
+    /**
+     * @brief Get the time source
+     *
+     * @return Current time source, or nullptr for the steady clock
+     */
+    const source_t *getSource();
+
+    /**
+     * @brief Get the current time
+     *
+     * @return Current ticks
+     */
+    ticks_t now();
+
+    /**
+     * @brief Convert a duration to ticks
+     *
+     * @param duration Duration to convert
+     * @return Duration in ticks
+     */
+    constexpr ticks_t toTicks(std::chrono::nanoseconds duration) { return duration.count(); }
+
+    /**
+     * @brief Has a timeout elapsed since an event
+     *
+     * @param ticks Time of the event
+     * @param timeout Timeout
+     * @param current Current time
+     * @return true Timeout has elapsed, or the event has never happened
+     * @return false Timeout has not elapsed
+     */
+    inline bool isExpired(ticks_t ticks, std::chrono::nanoseconds timeout, ticks_t current = now())
+    {
+        if (ticks == never) return true;
+        return current - ticks > toTicks(timeout);
+    }
+
+    /**
+     * @brief Get time remaining until a timeout elapses
+     *
+     * @param ticks Time of the event
+     * @param timeout Timeout
+     * @param current Current time
+     * @return Time remaining, zero if elapsed
+     */
+    inline std::chrono::milliseconds remaining(ticks_t ticks, std::chrono::nanoseconds timeout, ticks_t current = now())
+    {
+        if (isExpired(ticks, timeout, current)) return std::chrono::milliseconds(0);
+        return std::chrono::ceil<std::chrono::milliseconds>(
+                    timeout - std::chrono::nanoseconds(current - ticks));
+    }
+
+    /**
+     * @brief Convert ticks to wall clock time
+     *
+     * @param ticks Ticks to convert
+     * @return Local date and time, or a null QDateTime if never
+     */
+    inline QDateTime toDateTime(ticks_t ticks)
+    {
+        if (ticks == never) return QDateTime();
+        const auto age = std::chrono::duration_cast<std::chrono::milliseconds>(
+                    std::chrono::nanoseconds(now() - ticks));
+        return QDateTime::currentDateTime().addMSecs(-age.count());
+    }
+
+    class Timer;
+
+    /**
+     * @brief Virtual time source
+     * @details Time only moves when advanced, firing any CLOCK::Timer due on the way in order.
+     * Installed as the time source for its lifetime; nested virtual clocks are not supported.
+     *
+     * Must be advanced from the thread owning the timers. Queued signals are left for the caller's event loop.
+     */
+    class virtualClock_t : public source_t
+    {
+    public:
+        /**
+         * @brief Construct and install a new virtual clock
+         *
+         * @param start Initial time
+         */
+        explicit virtualClock_t(ticks_t start = 0);
+
+        /**
+         * @brief Uninstall the virtual clock
+         * @details Any timers still scheduled are stopped
+         */
+        ~virtualClock_t() override;
+
+        virtualClock_t(const virtualClock_t&) = delete;
+        virtualClock_t& operator=(const virtualClock_t&) = delete;
+
+        ticks_t now() const override { return current.load(std::memory_order_acquire); }
+
+        /**
+         * @brief Advance time
+         * @details Timers due are fired in order, with the time set to when each was due
+         *
+         * @param duration Time to advance by
+         */
+        void advance(std::chrono::nanoseconds duration);
+
+        /**
+         * @brief Get number of scheduled timers
+         *
+         * @return Scheduled timers
+         */
+        size_t timerCount() const { return timers.size(); }
+
+        /**
+         * @brief Get the installed virtual clock
+         *
+         * @return Virtual clock, or nullptr if another source is installed
+         */
+        static virtualClock_t *getInstalled();
+
+    private:
+        friend Timer;
+        void schedule(Timer *timer, ticks_t due);
+        void cancel(Timer *timer, ticks_t due);
+
+        std::atomic<ticks_t> current;
+        std::multimap<ticks_t, Timer*> timers;
+    };
+
+    /**
+     * @brief Timer driven by the library clock
+     * @details A subset of QTimer. Runs from a QTimer, or from the virtual clock if one is installed when started.
+     */
+    class Timer : public QObject
+    {
+        Q_OBJECT
+    public:
+        /**
+         * @brief Construct a new timer
+         *
+         * @param parent Parent object
+         */
+        explicit Timer(QObject *parent = nullptr);
+        ~Timer();
+
+        /**
+         * @brief Set the timeout interval
+         *
+         * @param value New interval
+         */
+        void setInterval(std::chrono::milliseconds value);
+
+        /**
+         * @brief Get the timeout interval
+         *
+         * @return Interval, in milliseconds
+         */
+        int interval() const { return static_cast<int>(intervalTime.count()); }
+
+        /**
+         * @brief Set if the timer fires only once
+         *
+         * @param value Fire only once
+         */
+        void setSingleShot(bool value);
+
+        /**
+         * @brief Does the timer fire only once
+         *
+         * @return true Timer fires only once
+         * @return false Timer repeats
+         */
+        bool isSingleShot() const { return singleShot; }
+
+        /**
+         * @brief Is the timer running
+         *
+         * @return true Timer is running
+         * @return false Timer is stopped
+         */
+        bool isActive() const { return virtualClock || timer.isActive(); }
+
+        /**
+         * @brief Start, or restart, the timer
+         *
+         * @param value New interval
+         */
+        void start(std::chrono::milliseconds value);
+
+    public slots:
+        /**
+         * @brief Start, or restart, the timer
+         *
+         */
+        void start();
+
+        /**
+         * @brief Stop the timer
+         *
+         */
+        void stop();
+
+    signals:
+        /**
+         * @brief Emitted when the timer times out
+         *
+         */
+        void timeout();
+
+    private:
+        friend virtualClock_t;
+        void expire();
+
+        QTimer timer;
+        std::chrono::milliseconds intervalTime = std::chrono::milliseconds(0);
+        bool singleShot = false;
+
+        virtualClock_t *virtualClock = nullptr;
+        ticks_t due = never;
+    };
+}
+
+#endif // CLOCK_HPP
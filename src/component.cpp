@@ -40,6 +40,11 @@ Component::Component(
     // Component Signals
     connect(otpNetwork.get(), &Container::newComponent, this, &Component::newComponent);
     connect(otpNetwork.get(), &Container::removedComponent, this, &Component::removedComponent);
+    connect(otpNetwork.get(), &Container::removedComponent, this, [this](cid_t cid) {
+            moduleAdvertisementFolios.removeComponent(cid);
+            nameAdvertisementFolios.removeComponent(cid);
+            systemAdvertisementFolios.removeComponent(cid);
+        });
 
     connect(otpNetwork.get(), qOverload<const cid_t&, const name_t&>(&Container::updatedComponent),
             this, qOverload<const cid_t&, const name_t&>(&Component::updatedComponent));
@@ -71,6 +76,7 @@ Component::Component(
     connect(otpNetwork.get(), &Container::updatedPoint, this, &Component::updatedPoint);
     connect(otpNetwork.get(), &Container::expiredPoint, this, &Component::expiredPoint);
     connect(otpNetwork.get(), &Container::removedPoint, this, &Component::removedPoint);
+    connect(otpNetwork.get(), &Container::winnerChanged, this, &Component::winnerChanged);
 }
 
 /* OTP Network */
@@ -132,8 +138,8 @@ void Component::setupListener()
     for (const auto &socket : qAsConst(sockets)) {
         listenerConnections.append(
                     connect(
-                        socket.get(), &SocketManager::newDatagram,
-                        this, &Component::newDatagram));
+                        socket.get(), &SocketManager::newPacket,
+                        this, &Component::newPacket));
         listenerConnections.append(
                     connect(
                         socket.get(), &SocketManager::stateChanged,
@@ -141,18 +147,37 @@ void Component::setupListener()
                         Qt::QueuedConnection));
     }
 }
-void Component::newDatagram(QNetworkDatagram datagram)
+void Component::newPacket(OTP::Packet packet)
 {
     /* Unicast packets to self have no senderAddress */
-    if (datagram.senderAddress().isNull()) datagram.setSender(datagram.destinationAddress());
+    if (packet.senderAddress().isNull()) packet.setSender(packet.destinationAddress());
+
+    // Pass to the decoder for this message type only
+    const auto peek = MESSAGES::peek(packet.view());
+    bool decoded = false;
+    switch (peek.type)
+    {
+        case MESSAGES::TransformMessage:
+            decoded = receiveOTPTransformMessage(packet);
+            break;
+
+        case MESSAGES::ModuleAdvertisementMessage:
+            decoded = receiveOTPModuleAdvertisementMessage(packet);
+            break;
+
+        case MESSAGES::NameAdvertisementMessage:
+            decoded = receiveOTPNameAdvertisementMessage(packet);
+            break;
 
-    // Transform Messages
-    if (receiveOTPTransformMessage(datagram)) return;
+        case MESSAGES::SystemAdvertisementMessage:
+            decoded = receiveOTPSystemAdvertisementMessage(packet);
+            break;
 
-    // Advertisement Messages
-    if (receiveOTPModuleAdvertisementMessage(datagram)) return;
-    if (receiveOTPNameAdvertisementMessage(datagram)) return;
-    if (receiveOTPSystemAdvertisementMessage(datagram)) return;
+        case MESSAGES::Rejected:
+            rejectedPackets[peek.reason]++;
+            return;
+    }
+    if (!decoded) rejectedPackets[MESSAGES::NotDecoded]++;
 }
 
 /* Local CID */
@@ -247,26 +272,21 @@ QString Component::getPointName(cid_t cid, address_t address) const
         cid = otpNetwork->getWinningComponent(address);
 
     if (!isPointValid(cid, address)) return QString();
-    if (!getPoints(cid, address.system, address.group).contains(address.point)) return QString();
     return otpNetwork->PointDetails(cid, address)->getName();
 }
 bool Component::isPointValid(address_t address) const
 {
     if (!address.isValid())
         return false;
-    if (!getPoints(address.system, address.group).contains(address.point))
-        return false;
 
-    return true;
+    return otpNetwork->isValid(address);
 }
 bool Component::isPointValid(cid_t cid, address_t address) const
 {
     if (!address.isValid())
         return false;
-    if (!getPoints(cid, address.system, address.group).contains(address.point))
-        return false;
 
-    return true;
+    return otpNetwork->isValid(cid, address);
 }
 QDateTime Component::getPointLastSeen(cid_t cid, address_t address) const
 {
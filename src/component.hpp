@@ -23,12 +23,17 @@
 #define COMPONENT_H
 
 #include <QObject>
+#include "const.hpp"
 #include "container.hpp"
+#include "folio.hpp"
 #include "socket.hpp"
 #include "types.hpp"
 #include "network/modules/modules.hpp"
+#include "network/messages/message_dispatch.hpp"
+#include "network/messages/message_types.hpp"
 #include <QNetworkInterface>
 #include <QAbstractSocket>
+#include <array>
 
 #if defined MAKE_OTP_LIB
     /**
@@ -125,6 +130,16 @@ namespace OTP
          */
         QAbstractSocket::SocketState getNetworkinterfaceState(QAbstractSocket::NetworkLayerProtocol transport) const;
 
+        /**
+         * @brief Get the number of received packets rejected
+         * @details Packets that are not OTP Messages, or could not be decoded
+         * 
+         * @param reason Reason for rejection
+         * @return Number of packets rejected for this reason
+         */
+        quint64 getRejectedPacketCount(MESSAGES::rejectReason_e reason) const
+            { return ((reason >= 0) && (reason < MESSAGES::RejectReasonCount)) ? rejectedPackets[reason] : 0; }
+
     signals:
         /**
          * @brief Emitted when the container uses a new network interface
@@ -146,51 +161,72 @@ namespace OTP
 
     private slots:
         /**
-         * @brief Emitted when the container receives a new network datagram
+         * @brief Emitted when the container receives a new network packet
          * 
          */
-        virtual void newDatagram(QNetworkDatagram);
+        virtual void newPacket(OTP::Packet);
 
     private:
         /**
-         * @brief Processes new OTP Transform Message datagrams
+         * @brief Processes new OTP Transform Message packets
          * 
-         * @param datagram Datagram to process
+         * @param packet Packet to process
          * @return Success status
          */
-        virtual bool receiveOTPTransformMessage(const QNetworkDatagram &datagram) = 0;
+        virtual bool receiveOTPTransformMessage(const Packet &packet) = 0;
 
         /**
-         * @brief Processes new OTP Module Advertisement Message datagrams
+         * @brief Processes new OTP Module Advertisement Message packets
          * 
-         * @param datagram Datagram to process
+         * @param packet Packet to process
          * @return Success status
          */
-        virtual bool receiveOTPModuleAdvertisementMessage(const QNetworkDatagram &datagram) = 0;
+        virtual bool receiveOTPModuleAdvertisementMessage(const Packet &packet) = 0;
 
         /**
-         * @brief Processes new OTP Name Advertisement Message datagrams
+         * @brief Processes new OTP Name Advertisement Message packets
          * 
-         * @param datagram Datagram to process
+         * @param packet Packet to process
          * @return Success status
          */
-        virtual bool receiveOTPNameAdvertisementMessage(const QNetworkDatagram &datagram) = 0;
+        virtual bool receiveOTPNameAdvertisementMessage(const Packet &packet) = 0;
 
         /**
-         * @brief Processes new OTP System Advertisement Message datagrams
+         * @brief Processes new OTP System Advertisement Message packets
          * 
-         * @param datagram Datagram to process
+         * @param packet Packet to process
          * @return Success status
          */
-        virtual bool receiveOTPSystemAdvertisementMessage(const QNetworkDatagram &datagram) = 0;
+        virtual bool receiveOTPSystemAdvertisementMessage(const Packet &packet) = 0;
+
+        /**
+         * @internal
+         * @brief Received packets rejected, indexed by reason
+         * 
+         */
+        std::array<quint64, MESSAGES::RejectReasonCount> rejectedPackets = {};
 
     protected:
         /**
          * @internal
-         * @brief Temporary storage when assemblying a complete OTP folio 
+         * @brief Reassembly of OTP Module Advertisement Message folios
          * 
          */
-        folioMap_t folioMap;
+        folioReassembler_t<MESSAGES::OTPModuleAdvertisementMessage::list_t> moduleAdvertisementFolios{OTP_ADVERTISEMENT_TIMEOUT};
+
+        /**
+         * @internal
+         * @brief Reassembly of OTP Name Advertisement Message folios
+         * 
+         */
+        folioReassembler_t<MESSAGES::OTPNameAdvertisementMessage::list_t> nameAdvertisementFolios{OTP_ADVERTISEMENT_TIMEOUT};
+
+        /**
+         * @internal
+         * @brief Reassembly of OTP System Advertisement Message folios
+         * 
+         */
+        folioReassembler_t<MESSAGES::OTPSystemAdvertisementMessage::list_t> systemAdvertisementFolios{OTP_ADVERTISEMENT_TIMEOUT};
 
     protected:
         /**
@@ -731,6 +767,13 @@ namespace OTP
          */
         void expiredPoint(OTP::cid_t, OTP::system_t, OTP::group_t, OTP::point_t);
 
+        /**
+         * @brief Emitted when the winning component of a point changes
+         * @details The component is null when no source remains
+         * 
+         */
+        void winnerChanged(OTP::cid_t, OTP::system_t, OTP::group_t, OTP::point_t);
+
     /* Addresses */
     public:
         /**
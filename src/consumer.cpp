@@ -24,11 +24,25 @@
 #include "socket.hpp"
 #include "network/pdu/pdu_const.hpp"
 #include "network/modules/modules.hpp"
-#include <QTimer>
 #include <QDebug>
+#include <algorithm>
 
 using namespace OTP;
 
+namespace
+{
+    // Module data of a point, with the reference frames it is relative to applied
+    template <class T>
+    T resolveModule(const networkSnapshot_t &snapshot, const address_t &address, const pointSnapshot_t &point, bool respectRelative)
+    {
+        auto module = point.standardModules.getModule<T>();
+        if (respectRelative)
+            for (const auto framePoint : snapshot.getReferenceFrames(address, point))
+                module += framePoint->standardModules.getModule<T>();
+        return module;
+    }
+}
+
 Consumer::Consumer(
         QNetworkInterface iface,
         QAbstractSocket::NetworkLayerProtocol transport,
@@ -49,18 +63,31 @@ Consumer::Consumer(
     Consumer::setupListener();
 
     // Module Advertisement Message Timer
-    QTimer *moduleAdvertTimer = new QTimer(this);
+    auto moduleAdvertTimer = new CLOCK::Timer(this);
     moduleAdvertTimer->setInterval(OTP_ADVERTISEMENT_TIMING);
     moduleAdvertTimer->setSingleShot(false);
-    connect(moduleAdvertTimer, &QTimer::timeout, this, [this]() {sendOTPModuleAdvertisementMessage();});
+    connect(moduleAdvertTimer, &CLOCK::Timer::timeout, this, [this]() {sendOTPModuleAdvertisementMessage();});
     moduleAdvertTimer->start();
     sendOTPModuleAdvertisementMessage();
 
+    // Frames
+    framesRetryTimer.setInterval(std::chrono::milliseconds(1));
+    framesRetryTimer.setSingleShot(true);
+    connect(&framesRetryTimer, &CLOCK::Timer::timeout, this, [this]() { publishFrames({}); });
+    connect(otpNetwork.get(), &Container::publishedSnapshot, this, &Consumer::publishFrames);
+
     // Removed components
     connect(otpNetwork.get(), &Container::removedComponent, this,
             [this](cid_t cid)
     {
-        folioMap.removeComponent(cid);
+        transformFolios.removeComponent(cid);
+        for (auto partial = transformPartialFolios.begin(); partial != transformPartialFolios.end();)
+        {
+            if (partial.key().first == cid)
+                partial = transformPartialFolios.erase(partial);
+            else
+                ++partial;
+        }
     });
 };
 
@@ -117,46 +144,42 @@ void Consumer::removeLocalSystem(system_t system)
 
 /* Standard Modules */
 template <class T, class T2>
-T Consumer::getValueHelper(T2 &module, cid_t cid, address_t address, bool respectRelative) const
+T Consumer::getValueHelper(T2 &module, const networkSnapshot_t &snapshot, cid_t cid, address_t address, bool respectRelative) const
 {
     using namespace MODULES::STANDARD;
     T ret;
-    if (!isPointValid(cid, address))
+    if (!address.isValid())
         return ret;
 
-    module = otpNetwork->PointDetails(cid, address)->standardModules.getModule<T2>();
-    if (respectRelative) {
-        QList<address_t> previous({address});
-        auto referenceFrame = getReferenceFrame(cid, address);
-        while (isPointValid(referenceFrame.value) &&
-               !previous.contains(referenceFrame.value))
-        {
-            module += otpNetwork->PointDetails(otpNetwork->getWinningComponent(referenceFrame.value), referenceFrame.value)->standardModules.getModule<T2>();
-            previous << referenceFrame.value;
-            referenceFrame = getReferenceFrame(otpNetwork->getWinningComponent(referenceFrame.value), referenceFrame.value);
-        }
-    }
+    const auto point = snapshot.find(cid, address);
+    if (!point)
+        return ret;
+
+    module = resolveModule<T2>(snapshot, address, *point, respectRelative);
     ret.timestamp = module.getTimestamp();
     ret.sourceCID = cid;
-    ret.priority = otpNetwork->PointDetails(cid, address)->getPriority();
+    ret.priority = point->priority;
 
     return ret;
 }
 
 template <class T>
 QMap<cid_t, T> Consumer::getValuesHelper(
-        std::function<T(cid_t cid, address_t address, axis_t axis, bool respectRelative)> getFunc,
+        std::function<T(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative)> getFunc,
         address_t address,
         axis_t axis,
         bool respectRelative, bool excludeWinner) const
 {
     QMap<cid_t, T> ret;
-    const auto components = otpNetwork->getComponentList();
-    const auto winningComponent = otpNetwork->getWinningComponent(address);
-    for (const auto &cid : components)
-        if (isPointValid(cid, address))
-            if (!(excludeWinner && cid == winningComponent))
-                ret.insert(cid, getFunc(cid, address, axis, respectRelative));
+    if (!address.isValid()) return ret;
+
+    // Every source from the same snapshot
+    const auto snapshot = otpNetwork->readSnapshot();
+    const auto sources = snapshot->getSources(address);
+    const auto winningComponent = snapshot->getWinner(address);
+    for (const auto &cid : sources)
+        if (!(excludeWinner && cid == winningComponent))
+            ret.insert(cid, getFunc(*snapshot, cid, address, axis, respectRelative));
 
     return ret;
 }
@@ -164,10 +187,15 @@ QMap<cid_t, T> Consumer::getValuesHelper(
 
 /* Standard Modules - Position */
 Consumer::PositionValue_t Consumer::getPosition(cid_t cid, address_t address, axis_t axis, bool respectRelative) const
+{
+    return getPosition(*otpNetwork->readSnapshot(), cid, address, axis, respectRelative);
+}
+
+Consumer::PositionValue_t Consumer::getPosition(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const
 {
     using namespace MODULES::STANDARD;
     PositionModule_t module;
-    auto ret = getValueHelper<PositionValue_t>(module, cid, address, respectRelative);
+    auto ret = getValueHelper<PositionValue_t>(module, snapshot, cid, address, respectRelative);
     ret.value = module.getPosition(axis);
     ret.scale = module.getScaling();
     ret.unit = getUnitString(ret.scale, VALUES::POSITION);
@@ -176,16 +204,16 @@ Consumer::PositionValue_t Consumer::getPosition(cid_t cid, address_t address, ax
 
 Consumer::PositionValue_t Consumer::getPosition(address_t address, axis_t axis, bool respectRelative) const
 {
-    auto cid = otpNetwork->getWinningComponent(address);
-    return getPosition(cid, address, axis, respectRelative);
+    const auto snapshot = otpNetwork->readSnapshot();
+    return getPosition(*snapshot, snapshot->getWinner(address), address, axis, respectRelative);
 }
 
 QMap<cid_t, Consumer::PositionValue_t> Consumer::getPositions(address_t address, axis_t axis, bool respectRelative, bool excludeWinner) const
 {
     return (getValuesHelper<PositionValue_t>(
-        [this](cid_t cid, address_t address, axis_t axis, bool respectRelative)
+        [this](const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative)
             {
-                return getPosition(cid, address, axis, respectRelative);
+                return getPosition(snapshot, cid, address, axis, respectRelative);
             },
         address, axis, respectRelative, excludeWinner));
 }
@@ -193,10 +221,15 @@ QMap<cid_t, Consumer::PositionValue_t> Consumer::getPositions(address_t address,
 
 /* Standard Modules - Position Velocity/Acceleration */
 Consumer::PositionVelocity_t Consumer::getPositionVelocity(cid_t cid, address_t address, axis_t axis, bool respectRelative) const
+{
+    return getPositionVelocity(*otpNetwork->readSnapshot(), cid, address, axis, respectRelative);
+}
+
+Consumer::PositionVelocity_t Consumer::getPositionVelocity(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const
 {
     using namespace MODULES::STANDARD;
     PositionVelAccModule_t module;
-    auto ret = getValueHelper<PositionVelocity_t>(module, cid, address, respectRelative);
+    auto ret = getValueHelper<PositionVelocity_t>(module, snapshot, cid, address, respectRelative);
     ret.value = module.getVelocity(axis);
     ret.unit = getUnitString(VALUES::POSITION_VELOCITY);
     return ret;
@@ -204,25 +237,30 @@ Consumer::PositionVelocity_t Consumer::getPositionVelocity(cid_t cid, address_t
 
 Consumer::PositionVelocity_t Consumer::getPositionVelocity(address_t address, axis_t axis, bool respectRelative) const
 {
-    auto cid = otpNetwork->getWinningComponent(address);
-    return getPositionVelocity(cid, address, axis, respectRelative);
+    const auto snapshot = otpNetwork->readSnapshot();
+    return getPositionVelocity(*snapshot, snapshot->getWinner(address), address, axis, respectRelative);
 }
 
 QMap<cid_t, Consumer::PositionVelocity_t> Consumer::getPositionVelocitys(address_t address, axis_t axis, bool respectRelative, bool excludeWinner) const
 {
     return (getValuesHelper<PositionVelocity_t>(
-        [this](cid_t cid, address_t address, axis_t axis, bool respectRelative)
+        [this](const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative)
             {
-                return getPositionVelocity(cid, address, axis, respectRelative);
+                return getPositionVelocity(snapshot, cid, address, axis, respectRelative);
             },
         address, axis, respectRelative, excludeWinner));
 }
 
 Consumer::PositionAcceleration_t Consumer::getPositionAcceleration(cid_t cid, address_t address, axis_t axis, bool respectRelative) const
+{
+    return getPositionAcceleration(*otpNetwork->readSnapshot(), cid, address, axis, respectRelative);
+}
+
+Consumer::PositionAcceleration_t Consumer::getPositionAcceleration(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const
 {
     using namespace MODULES::STANDARD;
     PositionVelAccModule_t module;
-    auto ret = getValueHelper<PositionAcceleration_t>(module, cid, address, respectRelative);
+    auto ret = getValueHelper<PositionAcceleration_t>(module, snapshot, cid, address, respectRelative);
     ret.value = module.getAcceleration(axis);
     ret.unit = getUnitString(VALUES::POSITION_ACCELERATION);
     return ret;
@@ -230,16 +268,16 @@ Consumer::PositionAcceleration_t Consumer::getPositionAcceleration(cid_t cid, ad
 
 Consumer::PositionAcceleration_t Consumer::getPositionAcceleration(address_t address, axis_t axis, bool respectRelative) const
 {
-    auto cid = otpNetwork->getWinningComponent(address);
-    return getPositionAcceleration(cid, address, axis, respectRelative);
+    const auto snapshot = otpNetwork->readSnapshot();
+    return getPositionAcceleration(*snapshot, snapshot->getWinner(address), address, axis, respectRelative);
 }
 
 QMap<cid_t, Consumer::PositionAcceleration_t> Consumer::getPositionAccelerations(address_t address, axis_t axis, bool respectRelative, bool excludeWinner) const
 {
     return (getValuesHelper<PositionAcceleration_t>(
-        [this](cid_t cid, address_t address, axis_t axis, bool respectRelative)
+        [this](const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative)
             {
-                return getPositionAcceleration(cid, address, axis, respectRelative);
+                return getPositionAcceleration(snapshot, cid, address, axis, respectRelative);
             },
         address, axis, respectRelative, excludeWinner));
 }
@@ -247,10 +285,15 @@ QMap<cid_t, Consumer::PositionAcceleration_t> Consumer::getPositionAccelerations
 
 /* Standard Modules - Rotation */
 Consumer::RotationValue_t Consumer::getRotation(cid_t cid, address_t address, axis_t axis, bool respectRelative) const
+{
+    return getRotation(*otpNetwork->readSnapshot(), cid, address, axis, respectRelative);
+}
+
+Consumer::RotationValue_t Consumer::getRotation(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const
 {
     using namespace MODULES::STANDARD;
     RotationModule_t module;
-    auto ret = getValueHelper<RotationValue_t>(module, cid, address, respectRelative);
+    auto ret = getValueHelper<RotationValue_t>(module, snapshot, cid, address, respectRelative);
     ret.value = module.getRotation(axis);
     ret.unit = getUnitString(VALUES::ROTATION);
     return ret;
@@ -258,16 +301,16 @@ Consumer::RotationValue_t Consumer::getRotation(cid_t cid, address_t address, ax
 
 Consumer::RotationValue_t Consumer::getRotation(address_t address, axis_t axis, bool respectRelative) const
 {
-    auto cid = otpNetwork->getWinningComponent(address);
-    return getRotation(cid, address, axis, respectRelative);
+    const auto snapshot = otpNetwork->readSnapshot();
+    return getRotation(*snapshot, snapshot->getWinner(address), address, axis, respectRelative);
 }
 
 QMap<cid_t, Consumer::RotationValue_t> Consumer::getRotations(address_t address, axis_t axis, bool respectRelative, bool excludeWinner) const
 {
     return (getValuesHelper<RotationValue_t>(
-        [this](cid_t cid, address_t address, axis_t axis, bool respectRelative)
+        [this](const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative)
             {
-                return getRotation(cid, address, axis, respectRelative);
+                return getRotation(snapshot, cid, address, axis, respectRelative);
             },
         address, axis, respectRelative, excludeWinner));
 }
@@ -275,10 +318,15 @@ QMap<cid_t, Consumer::RotationValue_t> Consumer::getRotations(address_t address,
 
 /* Standard Modules - Position Velocity/Acceleration */
 Consumer::RotationVelocity_t Consumer::getRotationVelocity(cid_t cid, address_t address, axis_t axis, bool respectRelative) const
+{
+    return getRotationVelocity(*otpNetwork->readSnapshot(), cid, address, axis, respectRelative);
+}
+
+Consumer::RotationVelocity_t Consumer::getRotationVelocity(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const
 {
     using namespace MODULES::STANDARD;
     RotationVelAccModule_t module;
-    auto ret = getValueHelper<RotationVelocity_t>(module, cid, address, respectRelative);
+    auto ret = getValueHelper<RotationVelocity_t>(module, snapshot, cid, address, respectRelative);
     ret.value = module.getVelocity(axis);
     ret.unit = getUnitString(VALUES::ROTATION_VELOCITY);
     return ret;
@@ -286,25 +334,30 @@ Consumer::RotationVelocity_t Consumer::getRotationVelocity(cid_t cid, address_t
 
 Consumer::RotationVelocity_t Consumer::getRotationVelocity(address_t address, axis_t axis, bool respectRelative) const
 {
-    auto cid = otpNetwork->getWinningComponent(address);
-    return getRotationVelocity(cid, address, axis, respectRelative);
+    const auto snapshot = otpNetwork->readSnapshot();
+    return getRotationVelocity(*snapshot, snapshot->getWinner(address), address, axis, respectRelative);
 }
 
 QMap<cid_t, Consumer::RotationVelocity_t> Consumer::getRotationVelocitys(address_t address, axis_t axis, bool respectRelative, bool excludeWinner) const
 {
     return (getValuesHelper<RotationVelocity_t>(
-        [this](cid_t cid, address_t address, axis_t axis, bool respectRelative)
+        [this](const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative)
             {
-                return getRotationVelocity(cid, address, axis, respectRelative);
+                return getRotationVelocity(snapshot, cid, address, axis, respectRelative);
             },
         address, axis, respectRelative, excludeWinner));
 }
 
 Consumer::RotationAcceleration_t Consumer::getRotationAcceleration(cid_t cid, address_t address, axis_t axis, bool respectRelative) const
+{
+    return getRotationAcceleration(*otpNetwork->readSnapshot(), cid, address, axis, respectRelative);
+}
+
+Consumer::RotationAcceleration_t Consumer::getRotationAcceleration(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const
 {
     using namespace MODULES::STANDARD;
     RotationVelAccModule_t module;
-    auto ret = getValueHelper<RotationAcceleration_t>(module, cid, address, respectRelative);
+    auto ret = getValueHelper<RotationAcceleration_t>(module, snapshot, cid, address, respectRelative);
     ret.value = module.getAcceleration(axis);
     ret.unit = getUnitString(VALUES::ROTATION_ACCELERATION);
     return ret;
@@ -312,70 +365,220 @@ Consumer::RotationAcceleration_t Consumer::getRotationAcceleration(cid_t cid, ad
 
 Consumer::RotationAcceleration_t Consumer::getRotationAcceleration(address_t address, axis_t axis, bool respectRelative) const
 {
-    auto cid = otpNetwork->getWinningComponent(address);
-    return getRotationAcceleration(cid, address, axis, respectRelative);
+    const auto snapshot = otpNetwork->readSnapshot();
+    return getRotationAcceleration(*snapshot, snapshot->getWinner(address), address, axis, respectRelative);
 }
 
 QMap<cid_t, Consumer::RotationAcceleration_t> Consumer::getRotationAccelerations(address_t address, axis_t axis, bool respectRelative, bool excludeWinner) const
 {
     return (getValuesHelper<RotationAcceleration_t>(
-        [this](cid_t cid, address_t address, axis_t axis, bool respectRelative)
+        [this](const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative)
             {
-                return getRotationAcceleration(cid, address, axis, respectRelative);
+                return getRotationAcceleration(snapshot, cid, address, axis, respectRelative);
             },
         address, axis, respectRelative, excludeWinner));
 }
 
 Consumer::Scale_t Consumer::getScale(cid_t cid, address_t address, axis_t axis) const
+{
+    return getScale(*otpNetwork->readSnapshot(), cid, address, axis);
+}
+
+Consumer::Scale_t Consumer::getScale(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis) const
 {
     using namespace MODULES::STANDARD;
     Consumer::Scale_t ret;
-    if (!isPointValid(cid, address))
+    if (!address.isValid())
+        return ret;
+
+    const auto point = snapshot.find(cid, address);
+    if (!point)
         return ret;
 
-    ret.value = otpNetwork->PointDetails(cid, address)->standardModules.scale.getScale(axis);
+    ret.value = point->standardModules.scale.getScale(axis);
     ret.unit = getUnitString(VALUES::SCALE);
-    ret.timestamp = otpNetwork->PointDetails(cid, address)->standardModules.scale.getTimestamp();
+    ret.timestamp = point->standardModules.scale.getTimestamp();
     ret.sourceCID = cid;
-    ret.priority = otpNetwork->PointDetails(cid, address)->getPriority();
+    ret.priority = point->priority;
     return ret;
 }
 
 Consumer::Scale_t Consumer::getScale(address_t address, axis_t axis) const
 {
-    auto cid = otpNetwork->getWinningComponent(address);
-    return getScale(cid, address, axis);
+    const auto snapshot = otpNetwork->readSnapshot();
+    return getScale(*snapshot, snapshot->getWinner(address), address, axis);
 }
 
 QMap<cid_t, Consumer::Scale_t> Consumer::getScales(address_t address, axis_t axis, bool excludeWinner) const
 {
     return (getValuesHelper<Scale_t>(
-        [this](cid_t cid, address_t address, axis_t axis, bool)
+        [this](const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool)
             {
-                return getScale(cid, address, axis);
+                return getScale(snapshot, cid, address, axis);
             },
         address, axis, bool(), excludeWinner));
 }
 
 Consumer::ReferenceFrame_t Consumer::getReferenceFrame(cid_t cid, address_t address) const
+{
+    return getReferenceFrame(*otpNetwork->readSnapshot(), cid, address);
+}
+
+Consumer::ReferenceFrame_t Consumer::getReferenceFrame(const networkSnapshot_t &snapshot, cid_t cid, address_t address) const
 {
     using namespace MODULES::STANDARD;
     Consumer::ReferenceFrame_t ret;
-    if (!isPointValid(cid, address))
+    if (!address.isValid())
+        return ret;
+
+    const auto point = snapshot.find(cid, address);
+    if (!point)
         return ret;
 
-    auto module = otpNetwork->PointDetails(cid, address)->standardModules.referenceFrame;
+    const auto &module = point->standardModules.referenceFrame;
     ret.value = {module.getSystem(), module.getGroup(), module.getPoint()};
     ret.timestamp = module.getTimestamp();
     ret.sourceCID = cid;
-    ret.priority = otpNetwork->PointDetails(cid, address)->getPriority();
+    ret.priority = point->priority;
     return ret;
 }
 
 Consumer::ReferenceFrame_t Consumer::getReferenceFrame(address_t address) const
 {
-    auto cid = otpNetwork->getWinningComponent(address);
-    return getReferenceFrame(cid, address);
+    const auto snapshot = otpNetwork->readSnapshot();
+    return getReferenceFrame(*snapshot, snapshot->getWinner(address), address);
+}
+
+/* Standard Modules - Batch */
+int Consumer::getModuleValues(
+        MODULES::STANDARD::VALUES::moduleValue_t module,
+        const address_t *addresses,
+        int count,
+        XYZ_t *values,
+        bool respectRelative) const
+{
+    using namespace MODULES::STANDARD;
+    int found = 0;
+    const auto snapshot = otpNetwork->readSnapshot();
+    for (int index = 0; index < count; index++)
+    {
+        const auto &address = addresses[index];
+        auto &value = values[index];
+        value.fill(0);
+
+        const auto point = snapshot->find(snapshot->getWinner(address), address);
+        if (!point) continue;
+
+        switch (module)
+        {
+            case VALUES::POSITION:
+            {
+                const auto resolved = resolveModule<PositionModule_t>(*snapshot, address, *point, respectRelative);
+                const qint64 multiplier = resolved.isScalingMM() ? 1000 : 1;
+                for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+                    value[axis] = resolved.getPosition(axis) * multiplier;
+            } break;
+
+            case VALUES::POSITION_VELOCITY:
+            {
+                const auto resolved = resolveModule<PositionVelAccModule_t>(*snapshot, address, *point, respectRelative);
+                for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+                    value[axis] = resolved.getVelocity(axis);
+            } break;
+
+            case VALUES::POSITION_ACCELERATION:
+            {
+                const auto resolved = resolveModule<PositionVelAccModule_t>(*snapshot, address, *point, respectRelative);
+                for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+                    value[axis] = resolved.getAcceleration(axis);
+            } break;
+
+            case VALUES::ROTATION:
+            {
+                const auto resolved = resolveModule<RotationModule_t>(*snapshot, address, *point, respectRelative);
+                for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+                    value[axis] = resolved.getRotation(axis);
+            } break;
+
+            case VALUES::ROTATION_VELOCITY:
+            {
+                const auto resolved = resolveModule<RotationVelAccModule_t>(*snapshot, address, *point, respectRelative);
+                for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+                    value[axis] = resolved.getVelocity(axis);
+            } break;
+
+            case VALUES::ROTATION_ACCELERATION:
+            {
+                const auto resolved = resolveModule<RotationVelAccModule_t>(*snapshot, address, *point, respectRelative);
+                for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+                    value[axis] = resolved.getAcceleration(axis);
+            } break;
+
+            case VALUES::SCALE:
+            {
+                for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+                    value[axis] = point->standardModules.scale.getScale(axis);
+            } break;
+
+            case VALUES::REFERENCE_FRAME: continue; // Not an axis value
+        }
+        found++;
+    }
+    return found;
+}
+
+/* Frames */
+void Consumer::publishFrames(const QList<system_t> &systems)
+{
+    for (const auto &system : systems)
+        framesPending.insert(system);
+
+    const auto snapshot = otpNetwork->readSnapshot();
+    for (auto system = framesPending.begin(); system != framesPending.end();)
+    {
+        auto &buffer = frames[*system];
+        const auto sequence = buffer.read()->sequence + 1;
+        auto frame = buffer.beginWrite();
+        if (!frame)
+        {
+            // Older frames still being read
+            ++system;
+            continue;
+        }
+
+        // Overwrite in place, reusing the points storage of an older frame
+        frame->system = *system;
+        frame->sequence = sequence;
+        frame->points.clear();
+        if (const auto entries = snapshot->systems.value(*system))
+        {
+            frame->points.reserve(static_cast<int>(entries->size()));
+            for (auto entry = entries->cbegin(); entry != entries->cend(); ++entry)
+            {
+                const auto point = snapshot->find(entry->winner, entry.key());
+                if (!point) continue;
+
+                frame->points.append({entry.key(), point->cid, point->priority, point->standardModules});
+                auto &standardModules = frame->points.last().standardModules;
+                for (const auto framePoint : snapshot->getReferenceFrames(entry.key(), *point))
+                {
+                    standardModules.position += framePoint->standardModules.position;
+                    standardModules.positionVelAcc += framePoint->standardModules.positionVelAcc;
+                    standardModules.rotation += framePoint->standardModules.rotation;
+                    standardModules.rotationVelAcc += framePoint->standardModules.rotationVelAcc;
+                }
+            }
+            std::sort(frame->points.begin(), frame->points.end(),
+                [](const FramePoint_t &l, const FramePoint_t &r) { return l.address < r.address; });
+        }
+        buffer.publish();
+
+        emit updatedFrame(*system);
+        system = framesPending.erase(system);
+    }
+
+    if (!framesPending.isEmpty() && !framesRetryTimer.isActive())
+        framesRetryTimer.start();
 }
 
 void Consumer::setupListener()
@@ -386,225 +589,258 @@ void Consumer::setupListener()
         Consumer::addLocalSystem(system);
 }
 
-bool Consumer::receiveOTPTransformMessage(const QNetworkDatagram &datagram)
+bool Consumer::receiveOTPTransformMessage(const Packet &packet)
 {
-    if (
-        ((datagram.destinationAddress().toIPv4Address() >= OTP_Transform_Message_IPv4.toIPv4Address()) &&
-            (datagram.destinationAddress().toIPv4Address() <= OTP_Transform_Message_IPv4.toIPv4Address()
-             + RANGES::System.getMax())) ||
-        ((datagram.destinationAddress().toIPv6Address() >= OTP_Transform_Message_IPv6.toIPv6Address()) &&
-            (datagram.destinationAddress().toIPv6Address() <= OTP_Transform_Message_IPv6.toIPv6Address()
-             + static_cast<system_t>(RANGES::System.getMax()))))
+    using reassembler_t = decltype(transformFolios);
+    auto transformMessage = std::make_shared<MESSAGES::OTPTransformMessage::Message>(packet);
+    if (transformMessage->isValid())
     {
-        MESSAGES::OTPTransformMessage::Message transformMessage(datagram);
-        if (transformMessage.isValid())
-        {
-            auto cid = transformMessage.getOTPLayer()->getCID();
-            auto folio = transformMessage.getOTPLayer()->getFolio();
-            auto system = transformMessage.getTransformLayer()->getSystem();
-            if (!folioMap.checkSequence(
+        auto cid = transformMessage->getOTPLayer().getCID();
+        auto folio = transformMessage->getOTPLayer().getFolio();
+        auto system = transformMessage->getTransformLayer().getSystem();
+
+        // Add page to folio, it is not decoded again
+        transformPage_t page = {transformMessage, transformPartialFolioMode ? CLOCK::now() : CLOCK::never};
+        const auto added = transformFolios.addPage(
                     cid,
                     system,
                     PDU::VECTOR_OTP_TRANSFORM_MESSAGE,
-                    folio))
-            {
-                qDebug() << this << "- Out of Sequence OTP Transform Message Request Received From" << datagram.senderAddress();
+                    folio,
+                    transformMessage->getOTPLayer().getPage(),
+                    transformMessage->getOTPLayer().getLastPage(),
+                    page);
+        switch (added)
+        {
+            case reassembler_t::Stale:
+                qDebug() << this << "- Out of Sequence OTP Transform Message Request Received From" << packet.senderAddress();
                 return true;
+            case reassembler_t::Duplicate: return true;
+            case reassembler_t::Invalid: return false;
+            case reassembler_t::Incomplete:
+            case reassembler_t::Complete: break;
+        }
+
+        otpNetwork->addComponent(
+                cid,
+                packet.senderAddress(),
+                transformMessage->getOTPLayer().getComponentName(),
+                component_t::type_t::produder);
+
+        if (added == reassembler_t::Incomplete)
+        {
+            // Apply page now, marking the folio as incomplete
+            if (transformPartialFolioMode)
+            {
+                const auto changes = applyOTPTransformMessage({transformMessage.get()}, packet.senderAddress());
+                transformPartialFolios.insert({cid, system}, folio);
+                notifyOTPTransformChanges(cid, changes);
             }
+            return true;
+        }
 
-            otpNetwork->addComponent(
+        // Last page, process all pages not already applied as a single update
+        const auto folioPages = transformFolios.takePages(
                     cid,
-                    datagram.senderAddress(),
-                    transformMessage.getOTPLayer()->getComponentName(),
-                    component_t::type_t::produder);
+                    system,
+                    PDU::VECTOR_OTP_TRANSFORM_MESSAGE);
+        QVector<const MESSAGES::OTPTransformMessage::Message*> pages;
+        pages.reserve(static_cast<int>(folioPages.size()));
+        for (const auto &folioPage : folioPages)
+        {
+            if ((folioPage.applied != CLOCK::never) && (folioPage.message != transformMessage))
+            {
+                auto &latency = transformPartialFolioLatency[system];
+                latency.pages++;
+                latency.saved += std::chrono::nanoseconds(CLOCK::now() - folioPage.applied);
+                continue;
+            }
+            pages.append(folioPage.message.get());
+        }
+        const auto changes = applyOTPTransformMessage(pages, packet.senderAddress());
+        transformPartialFolios.remove({cid, system});
+        notifyOTPTransformChanges(cid, changes);
+        return true;
+    }
+    return false;
+}
 
-            // Add page to folio map
-            folioMap.addPage(
-                        cid,
-                        system,
-                        PDU::VECTOR_OTP_TRANSFORM_MESSAGE,
-                        folio,
-                        transformMessage.getOTPLayer()->getPage(),
-                        datagram);
-
-            // Last page?
-            if (folioMap.checkAllPages(
-                        cid,
-                        system,
-                        PDU::VECTOR_OTP_TRANSFORM_MESSAGE,
-                        folio,
-                        transformMessage.getOTPLayer()->getLastPage()))
+QVector<Container::pointChange_t> Consumer::applyOTPTransformMessage(
+        const QVector<const MESSAGES::OTPTransformMessage::Message*> &pages,
+        const QHostAddress &sender)
+{
+    if (pages.isEmpty()) return QVector<Container::pointChange_t>();
+    auto cid = pages.first()->getOTPLayer().getCID();
+    auto system = pages.first()->getTransformLayer().getSystem();
+
+    // Process each Point layer, of every page
+    int pointCount = 0;
+    for (const auto &transformMessage : pages)
+        pointCount += static_cast<int>(transformMessage->getPoints().size());
+    QVector<Container::pointUpdate_t> points;
+    points.reserve(pointCount);
+    moduleList_t modules;
+    for (const auto &transformMessage : pages)
+    {
+        for (const auto &point : transformMessage->getPoints())
+        {
+            const auto &pointLayer = point.pointLayer;
+            auto timestamp = pointLayer.getTimestamp();
+            points.append({
+                address_t{system, pointLayer.getGroup(), pointLayer.getPoint()},
+                pointLayer.getPriority(),
+                pointDetails::standardModules_t()});
+            auto &newStandardModules = points.last().standardModules;
+
+            for (const auto &moduleLayer : point.moduleLayers)
             {
-                // Process all pages
-                for (const auto &datagram : folioMap.getDatagrams(cid,
-                            system,
-                            PDU::VECTOR_OTP_TRANSFORM_MESSAGE,
-                            folio))
+                const component_t::ModuleItem_t module = {moduleLayer.getManufacturerID(), moduleLayer.getModuleNumber()};
+                if (!modules.contains(module))
+                    modules.append(module);
+                switch (moduleLayer.getManufacturerID())
                 {
-                    // Process each Point layer
-                    for (const auto &pointLayer : transformMessage.getPointLayers())
+                    case ESTA_MANUFACTURER_ID:
                     {
-                        auto address = address_t{
-                            transformMessage.getTransformLayer()->getSystem(),
-                            pointLayer->getGroup(),
-                            pointLayer->getPoint()};
-                        auto timestamp = pointLayer->getTimestamp();
-                        otpNetwork->addPoint(cid, address, pointLayer->getPriority());
-                        otpNetwork->PointDetails(cid, address)->setPriority(pointLayer->getPriority());
-
-                        pointDetails::standardModules_t newStandardModules;
-                        for (const auto &moduleLayer : transformMessage.getModuleLayers().values(address))
-                        {
-                            otpNetwork->addModule(
-                                        cid,
-                                        {moduleLayer->getManufacturerID(), moduleLayer->getModuleNumber()});
-                            switch (moduleLayer->getManufacturerID())
+                        switch (moduleLayer.getModuleNumber()) {
+                            case MODULES::STANDARD::POSITION:
+                                newStandardModules.position = MODULES::STANDARD::PositionModule_t(moduleLayer.getAdditional(), timestamp);
+                                break;
+
+                            case MODULES::STANDARD::POSITION_VELOCITY_ACCELERATION:
+                                newStandardModules.positionVelAcc = MODULES::STANDARD::PositionVelAccModule_t(moduleLayer.getAdditional(), timestamp);
+                                break;
+
+                            case MODULES::STANDARD::ROTATION:
+                                newStandardModules.rotation = MODULES::STANDARD::RotationModule_t(moduleLayer.getAdditional(), timestamp);
+                                break;
+
+                            case MODULES::STANDARD::ROTATION_VELOCITY_ACCELERATION:
+                                newStandardModules.rotationVelAcc = MODULES::STANDARD::RotationVelAccModule_t(moduleLayer.getAdditional(), timestamp);
+                                break;
+
+                            case MODULES::STANDARD::SCALE:
+                                newStandardModules.scale = MODULES::STANDARD::ScaleModule_t(moduleLayer.getAdditional(), timestamp);
+                                break;
+
+                            case MODULES::STANDARD::REFERENCE_FRAME:
+                                newStandardModules.referenceFrame = MODULES::STANDARD::ReferenceFrameModule_t(moduleLayer.getAdditional(), timestamp);
+                                break;
+
+                            default:
                             {
-                                case ESTA_MANUFACTURER_ID:
-                                {
-                                    switch (moduleLayer->getModuleNumber()) {
-                                        case MODULES::STANDARD::POSITION:
-                                            newStandardModules.position = MODULES::STANDARD::PositionModule_t(moduleLayer->getAdditional(), timestamp);
-                                            break;
-
-                                        case MODULES::STANDARD::POSITION_VELOCITY_ACCELERATION:
-                                            newStandardModules.positionVelAcc = MODULES::STANDARD::PositionVelAccModule_t(moduleLayer->getAdditional(), timestamp);
-                                            break;
-
-                                        case MODULES::STANDARD::ROTATION:
-                                            newStandardModules.rotation = MODULES::STANDARD::RotationModule_t(moduleLayer->getAdditional(), timestamp);
-                                            break;
-
-                                        case MODULES::STANDARD::ROTATION_VELOCITY_ACCELERATION:
-                                            newStandardModules.rotationVelAcc = MODULES::STANDARD::RotationVelAccModule_t(moduleLayer->getAdditional(), timestamp);
-                                            break;
-
-                                        case MODULES::STANDARD::SCALE:
-                                            newStandardModules.scale = MODULES::STANDARD::ScaleModule_t(moduleLayer->getAdditional(), timestamp);
-                                            break;
-
-                                        case MODULES::STANDARD::REFERENCE_FRAME:
-                                            newStandardModules.referenceFrame = MODULES::STANDARD::ReferenceFrameModule_t(moduleLayer->getAdditional(), timestamp);
-                                            break;
-
-                                        default:
-                                        {
-                                        qDebug() << this << "Unknown module ID"
-                                                 << moduleLayer->getManufacturerID() << moduleLayer->getModuleNumber()
-                                                 << "From" << datagram.senderAddress();
-                                        } break;
-                                    }
-
-                                } break;
-                                default:
-                                {
-                                    qDebug() << this << "Unknown module Manufacturer ID"
-                                             << moduleLayer->getManufacturerID()
-                                             << "From" << datagram.senderAddress();
-                                } break;
-                            }
+                            qDebug() << this << "Unknown module ID"
+                                     << moduleLayer.getManufacturerID() << moduleLayer.getModuleNumber()
+                                     << "From" << sender;
+                            } break;
                         }
 
-                        // Update standard module details
-                        auto const oldStandardModules = otpNetwork->PointDetails(cid, address)->standardModules;
-                        for (auto axis = axis_t::first; axis < axis_t::count; axis++)
-                        {
-                            // - MODULES::STANDARD::POSITION
-                            otpNetwork->PointDetails(cid, address)->standardModules.position = newStandardModules.position;
-                            if (oldStandardModules.position.getPosition(axis) != newStandardModules.position.getPosition(axis))
-                                emit updatedPosition(cid, address, axis);
-
-                            // - MODULES::STANDARD::POSITION_VELOCITY_ACCELERATION
-                            otpNetwork->PointDetails(cid, address)->standardModules.positionVelAcc = newStandardModules.positionVelAcc;
-                            if (oldStandardModules.positionVelAcc.getVelocity(axis) != newStandardModules.positionVelAcc.getVelocity(axis))
-                                emit updatedPositionVelocity(cid, address, axis);
-                            if (oldStandardModules.positionVelAcc.getAcceleration(axis) != newStandardModules.positionVelAcc.getAcceleration(axis))
-                                emit updatedPositionAcceleration(cid, address, axis);
-
-                            // - MODULES::STANDARD::ROTATION
-                            otpNetwork->PointDetails(cid, address)->standardModules.rotation = newStandardModules.rotation;
-                            if (oldStandardModules.rotation.getRotation(axis) != newStandardModules.rotation.getRotation(axis))
-                                emit updatedRotation(cid, address, axis);
-
-                            // - MODULES::STANDARD::ROTATION_VELOCITY_ACCELERATION
-                            otpNetwork->PointDetails(cid, address)->standardModules.rotationVelAcc = newStandardModules.rotationVelAcc;
-                            if (oldStandardModules.rotationVelAcc.getVelocity(axis) != newStandardModules.rotationVelAcc.getVelocity(axis))
-                                emit updatedRotationVelocity(cid, address, axis);
-                            if (oldStandardModules.rotationVelAcc.getAcceleration(axis) != newStandardModules.rotationVelAcc.getAcceleration(axis))
-                                emit updatedRotationAcceleration(cid, address, axis);
-
-                            // - MODULES::STANDARD::SCALE
-                            otpNetwork->PointDetails(cid, address)->standardModules.scale = newStandardModules.scale;
-                            if (oldStandardModules.scale.getScale(axis) != newStandardModules.scale.getScale(axis))
-                                emit updatedScale(cid, address, axis);
-
-                            // - MODULES::STANDARD::REFERENCE_FRAME
-                            otpNetwork->PointDetails(cid, address)->standardModules.referenceFrame = newStandardModules.referenceFrame;
-                            if (oldStandardModules.referenceFrame != newStandardModules.referenceFrame)
-                                emit updatedReferenceFrame(cid, address);
-                        }
-                    }
+                    } break;
+                    default:
+                    {
+                        qDebug() << this << "Unknown module Manufacturer ID"
+                                 << moduleLayer.getManufacturerID()
+                                 << "From" << sender;
+                    } break;
                 }
-
-                // Flag system as dirty, to force a merge
-                otpNetwork->setSystemDirty(system);
             }
         }
-        return true;
     }
-    return false;
+
+    // Update all points as a single batch
+    return otpNetwork->applyPointBatch(cid, system, points, modules).points;
 }
 
-bool Consumer::receiveOTPModuleAdvertisementMessage(const QNetworkDatagram &datagram)
+void Consumer::notifyOTPTransformChanges(cid_t cid, const QVector<Container::pointChange_t> &changes)
 {
-    MESSAGES::OTPModuleAdvertisementMessage::Message moduleAdvert(datagram);
+    // Publish before notifying, so getters see the changes
+    otpNetwork->publishSnapshot();
+
+    for (const auto &change : changes)
+    {
+        const auto &address = change.address;
+        const auto &oldStandardModules = change.previous;
+        const auto &newStandardModules = change.current;
+        for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+        {
+            // - MODULES::STANDARD::POSITION
+            if (oldStandardModules.position.getPosition(axis) != newStandardModules.position.getPosition(axis))
+                emit updatedPosition(cid, address, axis);
+
+            // - MODULES::STANDARD::POSITION_VELOCITY_ACCELERATION
+            if (oldStandardModules.positionVelAcc.getVelocity(axis) != newStandardModules.positionVelAcc.getVelocity(axis))
+                emit updatedPositionVelocity(cid, address, axis);
+            if (oldStandardModules.positionVelAcc.getAcceleration(axis) != newStandardModules.positionVelAcc.getAcceleration(axis))
+                emit updatedPositionAcceleration(cid, address, axis);
+
+            // - MODULES::STANDARD::ROTATION
+            if (oldStandardModules.rotation.getRotation(axis) != newStandardModules.rotation.getRotation(axis))
+                emit updatedRotation(cid, address, axis);
+
+            // - MODULES::STANDARD::ROTATION_VELOCITY_ACCELERATION
+            if (oldStandardModules.rotationVelAcc.getVelocity(axis) != newStandardModules.rotationVelAcc.getVelocity(axis))
+                emit updatedRotationVelocity(cid, address, axis);
+            if (oldStandardModules.rotationVelAcc.getAcceleration(axis) != newStandardModules.rotationVelAcc.getAcceleration(axis))
+                emit updatedRotationAcceleration(cid, address, axis);
+
+            // - MODULES::STANDARD::SCALE
+            if (oldStandardModules.scale.getScale(axis) != newStandardModules.scale.getScale(axis))
+                emit updatedScale(cid, address, axis);
+
+            // - MODULES::STANDARD::REFERENCE_FRAME
+            if (oldStandardModules.referenceFrame != newStandardModules.referenceFrame)
+                emit updatedReferenceFrame(cid, address);
+        }
+    }
+}
+
+std::chrono::milliseconds Consumer::getTransformPartialFolioLatencySaved(system_t system) const
+{
+    const auto latency = transformPartialFolioLatency.value(system);
+    if (!latency.pages) return std::chrono::milliseconds(0);
+    return std::chrono::duration_cast<std::chrono::milliseconds>(latency.saved / static_cast<qint64>(latency.pages));
+}
+
+bool Consumer::receiveOTPModuleAdvertisementMessage(const Packet &packet)
+{
+    MESSAGES::OTPModuleAdvertisementMessage::Message moduleAdvert(packet);
 
     // Module Advertisement Message?
     if (moduleAdvert.isValid())
     {
+        using reassembler_t = decltype(moduleAdvertisementFolios);
         auto cid = moduleAdvert.getOTPLayer()->getCID();
-        auto folio = moduleAdvert.getOTPLayer()->getFolio();
-        if (cid != getLocalCID() && !folioMap.checkSequence(
+        const auto added = moduleAdvertisementFolios.addPage(
                     cid,
                     PDU::VECTOR_OTP_ADVERTISEMENT_MODULE,
-                    folio))
+                    moduleAdvert.getOTPLayer()->getFolio(),
+                    moduleAdvert.getOTPLayer()->getPage(),
+                    moduleAdvert.getOTPLayer()->getLastPage(),
+                    moduleAdvert.getModuleAdvertisementLayer()->getList());
+        switch (added)
         {
-            qDebug() << this << "- Out of Sequence OTP Module Advertisement Message Request Received From" << datagram.senderAddress();
-            return true;
+            case reassembler_t::Stale:
+                qDebug() << this << "- Out of Sequence OTP Module Advertisement Message Request Received From" << packet.senderAddress();
+                return true;
+            case reassembler_t::Duplicate: return true;
+            case reassembler_t::Invalid: return false;
+            case reassembler_t::Incomplete:
+            case reassembler_t::Complete: break;
         }
 
-        qDebug() << this << "- OTP Module Advertisement Message Request Received From" << datagram.senderAddress();
+        qDebug() << this << "- OTP Module Advertisement Message Request Received From" << packet.senderAddress();
 
         otpNetwork->addComponent(
                 cid,
-                datagram.senderAddress(),
+                packet.senderAddress(),
                 moduleAdvert.getOTPLayer()->getComponentName(),
                 component_t::type_t::consumer);
 
-        // Add page to folio map
-        folioMap.addPage(
-                    cid,
-                    PDU::VECTOR_OTP_ADVERTISEMENT_MODULE,
-                    folio,
-                    moduleAdvert.getOTPLayer()->getPage(),
-                    datagram);
-
         // Last page?
-        if (folioMap.checkAllPages(
-                    cid,
-                    PDU::VECTOR_OTP_ADVERTISEMENT_MODULE,
-                    folio,
-                    moduleAdvert.getOTPLayer()->getLastPage()))
+        if (added == reassembler_t::Complete)
         {
             // Process all pages
             MESSAGES::OTPModuleAdvertisementMessage::list_t list;
-            for (const auto &datagram : folioMap.getDatagrams(cid,
-                        PDU::VECTOR_OTP_ADVERTISEMENT_MODULE,
-                        folio))
-            {
-                MESSAGES::OTPModuleAdvertisementMessage::Message moduleAdvert(datagram);
-                list.append(moduleAdvert.getModuleAdvertisementLayer()->getList());
-            }
+            for (const auto &page : moduleAdvertisementFolios.takePages(cid, PDU::VECTOR_OTP_ADVERTISEMENT_MODULE))
+                list.append(page);
 
             // Add Modules
             otpNetwork->addModule(cid, list);
@@ -614,60 +850,52 @@ bool Consumer::receiveOTPModuleAdvertisementMessage(const QNetworkDatagram &data
     return false;
 }
 
-bool Consumer::receiveOTPNameAdvertisementMessage(const QNetworkDatagram &datagram)
+bool Consumer::receiveOTPNameAdvertisementMessage(const Packet &packet)
 {
-    MESSAGES::OTPNameAdvertisementMessage::Message nameAdvert(datagram);
+    MESSAGES::OTPNameAdvertisementMessage::Message nameAdvert(packet);
 
     // Name Advertisement Message?
     if (nameAdvert.isValid())
     {
+        using reassembler_t = decltype(nameAdvertisementFolios);
         auto cid = nameAdvert.getOTPLayer()->getCID();
-        auto folio = nameAdvert.getOTPLayer()->getFolio();
-        if (cid != getLocalCID() && !folioMap.checkSequence(
+        const auto added = nameAdvertisementFolios.addPage(
                     cid,
                     PDU::VECTOR_OTP_ADVERTISEMENT_NAME,
-                    folio))
+                    nameAdvert.getOTPLayer()->getFolio(),
+                    nameAdvert.getOTPLayer()->getPage(),
+                    nameAdvert.getOTPLayer()->getLastPage(),
+                    nameAdvert.getNameAdvertisementLayer()->getList());
+        switch (added)
         {
-            qDebug() << this << "- Out of Sequence OTP Name Advertisement Message Request Received From" << datagram.senderAddress();
-            return true;
+            case reassembler_t::Stale:
+                qDebug() << this << "- Out of Sequence OTP Name Advertisement Message Request Received From" << packet.senderAddress();
+                return true;
+            case reassembler_t::Duplicate: return true;
+            case reassembler_t::Invalid: return false;
+            case reassembler_t::Incomplete:
+            case reassembler_t::Complete: break;
         }
 
         auto type = (nameAdvert.getNameAdvertisementLayer()->getOptions().isResponse()) ? component_t::type_t::produder : component_t::type_t::consumer;
         if (type == component_t::type_t::produder)
-            qDebug() << this << "- OTP Name Advertisement Message Response Received From" << datagram.senderAddress();
+            qDebug() << this << "- OTP Name Advertisement Message Response Received From" << packet.senderAddress();
         else if (type == component_t::type_t::consumer)
-            qDebug() << this << "- OTP Name Advertisement Message Request Received From" << datagram.senderAddress();
+            qDebug() << this << "- OTP Name Advertisement Message Request Received From" << packet.senderAddress();
 
         otpNetwork->addComponent(
                 cid,
-                datagram.senderAddress(),
+                packet.senderAddress(),
                 nameAdvert.getOTPLayer()->getComponentName(),
                 type);
 
-        // Add page to folio map
-        folioMap.addPage(
-                    cid,
-                    PDU::VECTOR_OTP_ADVERTISEMENT_NAME,
-                    folio,
-                    nameAdvert.getOTPLayer()->getPage(),
-                    datagram);
-
         // Last page?
-        if (folioMap.checkAllPages(
-                    cid,
-                    PDU::VECTOR_OTP_ADVERTISEMENT_NAME,
-                    folio,
-                    nameAdvert.getOTPLayer()->getLastPage()))
+        if (added == reassembler_t::Complete)
         {
             // Process all pages
             MESSAGES::OTPNameAdvertisementMessage::list_t list;
-            for (const auto &datagram : folioMap.getDatagrams(cid,
-                        PDU::VECTOR_OTP_ADVERTISEMENT_NAME,
-                        folio))
-            {
-                MESSAGES::OTPNameAdvertisementMessage::Message nameAdvert(datagram);
-                list.append(nameAdvert.getNameAdvertisementLayer()->getList());
-            }
+            for (const auto &page : nameAdvertisementFolios.takePages(cid, PDU::VECTOR_OTP_ADVERTISEMENT_NAME))
+                list.append(page);
 
             // Add names
             for (const auto &point : list)
@@ -682,60 +910,52 @@ bool Consumer::receiveOTPNameAdvertisementMessage(const QNetworkDatagram &datagr
     return false;
 }
 
-bool Consumer::receiveOTPSystemAdvertisementMessage(const QNetworkDatagram &datagram)
+bool Consumer::receiveOTPSystemAdvertisementMessage(const Packet &packet)
 {
-    MESSAGES::OTPSystemAdvertisementMessage::Message systemAdvert(datagram);
+    MESSAGES::OTPSystemAdvertisementMessage::Message systemAdvert(packet);
 
     // System Advertisement Message?
     if (systemAdvert.isValid())
     {
+        using reassembler_t = decltype(systemAdvertisementFolios);
         auto cid = systemAdvert.getOTPLayer()->getCID();
-        auto folio = systemAdvert.getOTPLayer()->getFolio();
-        if (cid != getLocalCID() && !folioMap.checkSequence(
+        const auto added = systemAdvertisementFolios.addPage(
                     cid,
                     PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM,
-                    folio))
+                    systemAdvert.getOTPLayer()->getFolio(),
+                    systemAdvert.getOTPLayer()->getPage(),
+                    systemAdvert.getOTPLayer()->getLastPage(),
+                    systemAdvert.getSystemAdvertisementLayer()->getList());
+        switch (added)
         {
-            qDebug() << this << "- Out of Sequence OTP Name Advertisement Message Request Received From" << datagram.senderAddress();
-            return true;
+            case reassembler_t::Stale:
+                qDebug() << this << "- Out of Sequence OTP System Advertisement Message Request Received From" << packet.senderAddress();
+                return true;
+            case reassembler_t::Duplicate: return true;
+            case reassembler_t::Invalid: return false;
+            case reassembler_t::Incomplete:
+            case reassembler_t::Complete: break;
         }
 
         auto type = (systemAdvert.getSystemAdvertisementLayer()->getOptions().isResponse()) ? component_t::type_t::produder : component_t::type_t::consumer;
         if (type == component_t::type_t::produder)
-            qDebug() << this << "- OTP System Advertisement Message Response Received From" << datagram.senderAddress();
+            qDebug() << this << "- OTP System Advertisement Message Response Received From" << packet.senderAddress();
         else if (type == component_t::type_t::consumer)
-            qDebug() << this << "- OTP System Advertisement Message Request Received From" << datagram.senderAddress();
+            qDebug() << this << "- OTP System Advertisement Message Request Received From" << packet.senderAddress();
 
         otpNetwork->addComponent(
                 cid,
-                datagram.senderAddress(),
+                packet.senderAddress(),
                 systemAdvert.getOTPLayer()->getComponentName(),
                 type);
 
-        // Add page to folio map
-        folioMap.addPage(
-                    cid,
-                    PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM,
-                    folio,
-                    systemAdvert.getOTPLayer()->getPage(),
-                    datagram);
-
         // Last page?
-        if (folioMap.checkAllPages(
-                    cid,
-                    PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM,
-                    folio,
-                    systemAdvert.getOTPLayer()->getLastPage()))
+        if (added == reassembler_t::Complete)
         {
             // Process all pages
             MESSAGES::OTPSystemAdvertisementMessage::list_t list;
-            for (const auto &datagram : folioMap.getDatagrams(cid,
-                        PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM,
-                        folio))
-            {
-                MESSAGES::OTPSystemAdvertisementMessage::Message systemAdvert(datagram);
-                list.append(systemAdvert.getSystemAdvertisementLayer()->getList());
-            }
+            for (const auto &page : systemAdvertisementFolios.takePages(cid, PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM))
+                list.append(page);
 
             // Add new systems
             for (const auto &system : list)
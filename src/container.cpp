@@ -22,7 +22,6 @@
 #include "container.hpp"
 #include "otp.hpp"
 #include "merger.hpp"
-#include <QTimer>
 #include <QMutexLocker>
 
 using namespace OTP;
@@ -30,12 +29,14 @@ using namespace OTP;
 Container::Container(QObject *parent) :
     QObject(parent)
 {
-    componentTimeout.start(OTP_COMPONENT_TIMEOUT);
-    connect(&componentTimeout, &QTimer::timeout, this, &Container::pruneComponentList);
+    merger = std::make_unique<Merger>(this);
+    expiryTimer.start(expiryResolution);
+    connect(&expiryTimer, &CLOCK::Timer::timeout, this, &Container::tickExpiry);
 }
 
 Container::~Container()
 {
+    merger.reset();
 }
 
 void Container::clearComponents()
@@ -55,8 +56,20 @@ void Container::addComponent(
     if (!existing)
     {
         componentMap.insert(cid, component_t());
+        QList<system_t> systems;
+        {
+            QMutexLocker lock(&addressMapMutex);
+            mergeComponents.insert(cid);
+            systems = pointStore.getSystems(cid);
+            for (const auto &system : std::as_const(systems))
+                setSnapshotStale(system);
+        }
         qDebug() << parent() << "- New component" << cid << name.toString() << IPAddr;
         emit newComponent(cid);
+
+        // Any points remaining from before the component was removed may win again
+        for (const auto &system : systems)
+            setSystemDirty(system);
     }
 
     if (!name.isNull() && (componentMap.value(cid).getName() != name))
@@ -85,6 +98,7 @@ void Container::addComponent(
     }
 
     componentMap[cid].updateLastSeen();
+    componentExpiry.schedule(cid, OTP_COMPONENT_TIMEOUT);
 }
 
 void Container::removeComponent(const cid_t &cid)
@@ -94,6 +108,20 @@ void Container::removeComponent(const cid_t &cid)
         const auto name = componentMap.value(cid).getName().toString();
         const auto IPAddr = componentMap.value(cid).getIPAddr();
         componentMap.remove(cid);
+        componentExpiry.cancel(cid);
+        moduleExpiry.cancel(cid);
+
+        // Points remain, but may no longer win
+        QList<system_t> systems;
+        {
+            QMutexLocker lock(&addressMapMutex);
+            mergeComponents.remove(cid);
+            systems = pointStore.getSystems(cid);
+            for (const auto &system : std::as_const(systems))
+                setSnapshotStale(system);
+        }
+        for (const auto &system : systems)
+            setSystemDirty(system);
         qDebug() << parent() << "- Removed component" << cid << name << IPAddr;
         emit removedComponent(cid);
     }
@@ -106,11 +134,19 @@ bool Container::changeComponentCID(cid_t oldCID, cid_t newCID)
 
     // Move
     componentMap[newCID] = std::move(componentMap[oldCID]);
+    QList<system_t> systems;
     {
+        // Points keep their rank, so only the CID of the winner changes
         QMutexLocker lock(&addressMapMutex);
-        addressMap[newCID] = std::move(addressMap[oldCID]);
+        pointStore.changeCID(oldCID, newCID);
+        mergeComponents.insert(newCID);
+        systems = pointStore.getSystems(newCID);
+        for (const auto &system : std::as_const(systems))
+            setSnapshotStale(system);
     }
     removeComponent(oldCID);
+    for (const auto &system : systems)
+        setSystemDirty(system);
 
     qDebug() << parent() << "- Changed component CID" << oldCID << newCID;
     emit newComponent(newCID);
@@ -133,13 +169,22 @@ component_t Container::getComponent(cid_t cid) const
 
 cid_t Container::getWinningComponent(address_t address) const
 {
-    return winningSources.value(address);
+    merger->flush(address.system);
+    QMutexLocker lock(&addressMapMutex);
+    return pointStore.getWinner(address);
 }
 
 void Container::clearSystems()
 {
-    QMutexLocker lock(&addressMapMutex);
-    addressMap.clear();
+    const auto systems = getSystemList();
+    {
+        QMutexLocker lock(&addressMapMutex);
+        for (const auto &system : systems)
+            setSnapshotStale(system);
+        pointStore.clear();
+    }
+    for (const auto &system : systems)
+        setSystemDirty(system);
 }
 
 void Container::addSystem(cid_t cid, system_t system)
@@ -150,7 +195,7 @@ void Container::addSystem(cid_t cid, system_t system)
     {
         {
             QMutexLocker lock(&addressMapMutex);
-            addressMap[cid][system];
+            pointStore.addSystem(cid, system);
         }
 
         qDebug() << parent() << "- New system" << cid << system;
@@ -160,27 +205,22 @@ void Container::addSystem(cid_t cid, system_t system)
 
 void Container::removeSystem(cid_t cid, system_t system)
 {
-    QMutexLocker lock(&addressMapMutex);
-    if (addressMap[cid].contains(system))
     {
-        addressMap[cid].remove(system);
-        lock.unlock();
-        qDebug() << parent() << "- Removed system" << cid << system;
-        emit removedSystem(cid, system);
+        QMutexLocker lock(&addressMapMutex);
+        if (!pointStore.removeSystem(cid, system)) return;
+        setSnapshotStale(system);
     }
-
-    mergerThreads.remove(system);
+    qDebug() << parent() << "- Removed system" << cid << system;
+    emit removedSystem(cid, system);
+    setSystemDirty(system);
 }
 
 QList<system_t> Container::getSystemList() const
 {
     QMutexLocker lock(&addressMapMutex);
     QList<system_t> ret;
-    QHashIterator<cid_t, systemMap_t> i(addressMap);
-    while (i.hasNext()) {
-        i.next();
-        ret << getSystemList(i.key());
-    }
+    for (const auto &cid : pointStore.getComponents())
+        ret << pointStore.getSystems(cid);
 
     std::sort(ret.begin(),ret.end());
     ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
@@ -190,19 +230,54 @@ QList<system_t> Container::getSystemList() const
 QList<system_t> Container::getSystemList(cid_t cid) const
 {
     QMutexLocker lock(&addressMapMutex);
-    if (!addressMap.contains(cid)) return QList<system_t>();
-
-    QList<system_t> ret = addressMap[cid].keys();
+    QList<system_t> ret = pointStore.getSystems(cid);
     std::sort(ret.begin(),ret.end());
     return ret;
 }
 
 void Container::setSystemDirty(system_t system)
 {
-    if (!mergerThreads.contains(system))
-        mergerThreads[system] = std::make_shared<Merger>(system, this);
+    {
+        QMutexLocker lock(&dirtyAddressesMutex);
+        auto &dirty = dirtyAddresses[system];
+        dirty.all = true;
+        dirty.addresses.clear();
+    }
+    merger->setDirty(system);
+}
 
-    mergerThreads.value(system)->setDirty();
+void Container::setAddressesDirty(system_t system, const QVector<address_t> &addresses)
+{
+    if (addresses.isEmpty()) return;
+    {
+        QMutexLocker lock(&dirtyAddressesMutex);
+        auto &dirty = dirtyAddresses[system];
+        if (!dirty.all)
+            for (const auto &address : addresses)
+                dirty.addresses.insert(address);
+    }
+    merger->setDirty(system);
+}
+
+Container::mergeStatistics_t Container::getMergeStatistics() const
+{
+    return merger->getStatistics();
+}
+
+int Container::getMergeWorkers() const
+{
+    return merger->getWorkers();
+}
+
+void Container::setMergeWorkers(int count)
+{
+    merger->setWorkers(count);
+}
+
+Container::dirtyAddresses_t Container::takeDirtyAddresses(system_t system)
+{
+    QMutexLocker lock(&dirtyAddressesMutex);
+    return dirtyAddresses.take(system);
 }
 
 void Container::addGroup(cid_t cid, system_t system, group_t group)
@@ -216,7 +291,7 @@ void Container::addGroup(cid_t cid, system_t system, group_t group)
     {
         {
             QMutexLocker lock(&addressMapMutex);
-            addressMap[cid][system][group] = pointMap_t();
+            pointStore.addGroup(cid, system, group);
         }
         if (updated)
         {
@@ -234,10 +309,15 @@ void Container::removeGroup(cid_t cid, system_t system, group_t group)
 {
     if (getGroupList(cid, system).contains(group))
     {
+        QVector<address_t> addresses;
         {
             QMutexLocker lock(&addressMapMutex);
-            addressMap[cid][system].remove(group);
+            for (const auto &point : pointStore.getPoints(cid, system, group))
+                addresses.append({system, group, point});
+            pointStore.removeGroup(cid, system, group);
+            setSnapshotStale(system);
         }
+        setAddressesDirty(system, addresses);
         qDebug() << parent() << "- Removed Group" << cid << system << group;
         emit removedGroup(cid, system, group);
     }
@@ -245,12 +325,10 @@ void Container::removeGroup(cid_t cid, system_t system, group_t group)
 
 QList<group_t> Container::getGroupList(system_t system) const
 {
+    QMutexLocker lock(&addressMapMutex);
     QList<group_t> ret;
-    QHashIterator<cid_t, systemMap_t> i(addressMap);
-    while (i.hasNext()) {
-        i.next();
-        ret << getGroupList(i.key(), system);
-    }
+    for (const auto &cid : pointStore.getComponents())
+        ret << pointStore.getGroups(cid, system);
 
     std::sort(ret.begin(),ret.end());
     ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
@@ -260,10 +338,7 @@ QList<group_t> Container::getGroupList(system_t system) const
 QList<group_t> Container::getGroupList(cid_t cid, system_t system) const
 {
     QMutexLocker lock(&addressMapMutex);
-    if (!addressMap.contains(cid)) return QList<group_t>();
-    if (!addressMap[cid].contains(system)) return QList<group_t>();
-
-    QList<group_t> ret = addressMap[cid][system].keys();
+    QList<group_t> ret = pointStore.getGroups(cid, system);
     std::sort(ret.begin(),ret.end());
     return ret;
 }
@@ -284,18 +359,7 @@ void Container::addModule(cid_t cid, const component_t::ModuleItem_t &item)
         emit updatedComponent(cid, componentMap[cid].getModuleList());
     }
 
-    if (!moduleListTimeoutMap.contains(cid)) {
-        moduleListTimeoutMap[cid]= std::make_shared<QTimer>(this);
-        moduleListTimeoutMap[cid]->setSingleShot(true);
-        moduleListTimeoutMap[cid]->start(OTP_ADVERTISEMENT_TIMEOUT);
-        connect(moduleListTimeoutMap[cid].get(), &QTimer::timeout,
-                this, [this, cid]()
-        {
-            pruneModuleList(cid);
-        });
-    }
-
-    pruneModuleList(cid);
+    moduleExpiry.schedule(cid, OTP_ADVERTISEMENT_TIMEOUT);
 }
 void Container::removeModule(cid_t cid, const component_t::ModuleList_t &list)
 {
@@ -320,50 +384,43 @@ void Container::addPoint(cid_t cid, address_t address, priority_t priority)
     if (!address.point.isValid()) return;
     if (!priority.isValid()) return;
     componentMap[cid].updateLastSeen();
+    componentExpiry.schedule(cid, OTP_COMPONENT_TIMEOUT);
 
     addGroup(cid, address.system, address.group);
-    bool existing = getPointList(cid, address.system, address.group).contains(address.point);
-    if (existing)
+    bool inserted;
+    bool revived = false;
     {
+        QMutexLocker lock(&addressMapMutex);
+        auto &record = pointStore.findOrInsert(cid, address, inserted);
+        if (!inserted)
         {
-            QMutexLocker lock(&addressMapMutex);
-            addressMap[cid][address.system][address.group][address.point]->updateLastSeen();
+            revived = record.details->isExpired();
+            record.details->updateLastSeen();
         }
+        setSnapshotStale(address.system);
+    }
+    if (inserted || revived) setAddressDirty(address);
+    if (!inserted)
+    {
         emit updatedPoint(cid, address.system, address.group, address.point);
     } else
     {
-        auto newDetails = pointDetails_t(new pointDetails);
-        {
-            QMutexLocker lock(&addressMapMutex);
-            addressMap[cid][address.system][address.group].insert(address.point, newDetails);
-        }
         qDebug() << parent() << "- New point" << cid << address.system << address.group << address.point << "(Priority: " << priority << ")";
         emit newPoint(cid, address.system, address.group, address.point);
     }
 
-    if (!pointTimeoutMap.contains(address)) {
-        pointTimeoutMap[address] = std::make_shared<QTimer>(this);
-        pointTimeoutMap[address]->setSingleShot(true);
-        connect(pointTimeoutMap[address].get(), &QTimer::timeout, this,
-            [this, cid, address]() {
-                if(!isValid(address) || isExpired(cid, address))
-                {
-                    prunePointList(cid, address);
-                }
-            });
-    }
-    pointTimeoutMap[address]->start(OTP_TRANSFORM_DATA_LOSS_TIMEOUT); // (re)set the timeout
+    pointExpiry.schedule({cid, address}, OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
 }
 
 void Container::removePoint(cid_t cid, address_t address)
 {
     if (!address.point.isValid()) return;
-    if (!getPointList(address.system, address.group).contains(address.point)) return;
-
     {
         QMutexLocker lock(&addressMapMutex);
-        addressMap[cid][address.system][address.group].remove(address.point);
+        if (!pointStore.remove(cid, address)) return;
+        setSnapshotStale(address.system);
     }
+    setAddressDirty(address);
     qDebug() << parent() << "- Removed point" << cid << address.system << address.group << address.point;
     emit removedPoint(cid, address.system, address.group, address.point);
 }
@@ -371,17 +428,23 @@ void Container::removePoint(cid_t cid, address_t address)
 void Container::movePoint(cid_t cid, address_t oldAddress, address_t newAddress)
 {
     if (!oldAddress.point.isValid()) return;
-    if (!getPointList(oldAddress.system, oldAddress.group).contains(oldAddress.point)) return;
+    if (!isValid(oldAddress)) return;
 
     if (!newAddress.point.isValid()) return;
-    if (getPointList(newAddress.system, newAddress.group).contains(newAddress.point)) return;
+    if (isValid(newAddress)) return;
 
     addPoint(cid, newAddress);
     {
         QMutexLocker lock(&addressMapMutex);
-        addressMap[cid][newAddress.system][newAddress.group][newAddress.point] =
-                std::move(addressMap[cid][oldAddress.system][oldAddress.group][oldAddress.point]);
+        const auto details = pointStore.find(cid, oldAddress);
+        bool inserted;
+        if (details)
+        {
+            pointStore.findOrInsert(cid, newAddress, inserted).details = details;
+            setSnapshotStale(newAddress.system);
+        }
     }
+    setAddressDirty(newAddress);
     removePoint(cid, oldAddress);
 
     qDebug() << parent() << "- Moved point" << cid
@@ -389,14 +452,129 @@ void Container::movePoint(cid_t cid, address_t oldAddress, address_t newAddress)
              << "To" << newAddress.system << newAddress.group << newAddress.point;
 }
 
+void Container::setPointPriority(cid_t cid, address_t address, priority_t priority)
+{
+    {
+        QMutexLocker lock(&addressMapMutex);
+        const auto details = pointStore.find(cid, address);
+        if (!details) return;
+        details->setPriority(priority);
+        setSnapshotStale(address.system);
+    }
+    setAddressDirty(address);
+}
+
+Container::batchResult_t Container::applyPointBatch(
+        cid_t cid,
+        system_t system,
+        const QVector<pointUpdate_t> &points,
+        const moduleList_t &modules)
+{
+    batchResult_t ret;
+    if (!system.isValid()) return ret;
+    componentMap[cid].updateLastSeen();
+    componentExpiry.schedule(cid, OTP_COMPONENT_TIMEOUT);
+
+    // Modules
+    const auto existingModules = componentMap.value(cid).getModuleList();
+    for (const auto &item : modules)
+    {
+        if (!existingModules.contains(item) && !ret.newModules.contains(item))
+            ret.newModules.append(item);
+        componentMap[cid].addModuleItem(item);
+    }
+
+    // Points, all located and updated under a single lock
+    bool newSystem = false;
+    QList<std::pair<group_t, bool>> newGroups; // Group, and is it known to another component
+    QList<std::pair<address_t, bool>> updatedPoints; // Address, and is it new to the component
+    QVector<address_t> dirty; // Addresses which may have a new winner
+    ret.points.reserve(points.size());
+    {
+        QMutexLocker lock(&addressMapMutex);
+        newSystem = !pointStore.getSystems(cid).contains(system);
+        pointStore.addSystem(cid, system);
+        QSet<group_t> groups;
+        for (const auto &group : pointStore.getGroups(cid, system))
+            groups.insert(group);
+        for (const auto &update : points)
+        {
+            const auto &address = update.address;
+            if (address.system != system) continue;
+            if (!address.group.isValid() || !address.point.isValid()) continue;
+            if (!update.priority.isValid()) continue;
+
+            if (!groups.contains(address.group))
+            {
+                bool known = false;
+                for (const auto &other : pointStore.getComponents())
+                    known |= pointStore.getGroups(other, system).contains(address.group);
+                newGroups.append({address.group, known});
+                groups.insert(address.group);
+            }
+
+            bool inserted;
+            auto &details = pointStore.findOrInsert(cid, address, inserted).details;
+            updatedPoints.append({address, inserted});
+            if (inserted || details->isExpired() || (details->getPriority() != update.priority))
+                dirty.append(address);
+            details->setPriority(update.priority);
+
+            ret.points.append({address, details->standardModules, update.standardModules});
+            details->standardModules = update.standardModules;
+        }
+        if (!updatedPoints.isEmpty()) setSnapshotStale(system);
+    }
+
+    setAddressesDirty(system, dirty);
+
+    // Notify
+    if (newSystem)
+    {
+        qDebug() << parent() << "- New system" << cid << system;
+        emit newSystem(cid, system);
+    }
+    for (const auto &[group, known] : newGroups)
+    {
+        if (known)
+        {
+            // New to this CID
+            qDebug() << parent() << "- Updated group" << cid << system << group;
+            emit updatedGroup(cid, system, group);
+        } else {
+            qDebug() << parent() << "- New group" << cid << system << group;
+            emit newGroup(cid, system, group);
+        }
+    }
+    for (const auto &[address, isNew] : updatedPoints)
+    {
+        if (isNew)
+        {
+            qDebug() << parent() << "- New point" << cid << address.system << address.group << address.point;
+            emit newPoint(cid, address.system, address.group, address.point);
+        } else
+            emit updatedPoint(cid, address.system, address.group, address.point);
+        pointExpiry.schedule({cid, address}, OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
+    }
+
+    if (!ret.newModules.isEmpty())
+    {
+        for (const auto &item : ret.newModules)
+            qDebug() << parent() << "- Added module" << item.ManufacturerID << item.ModuleNumber << cid;
+        emit updatedComponent(cid, componentMap[cid].getModuleList());
+    }
+    if (!modules.isEmpty())
+        moduleExpiry.schedule(cid, OTP_ADVERTISEMENT_TIMEOUT);
+
+    return ret;
+}
+
 QList<point_t> Container::getPointList(system_t system, group_t group) const
 {
+    QMutexLocker lock(&addressMapMutex);
     QList<point_t> ret;
-    QHashIterator<cid_t, systemMap_t> i(addressMap);
-    while (i.hasNext()) {
-        i.next();
-        ret << getPointList(i.key(), system, group);
-    }
+    for (const auto &cid : pointStore.getComponents())
+        ret << pointStore.getPoints(cid, system, group);
 
     std::sort(ret.begin(),ret.end());
     ret.erase(std::unique(ret.begin(), ret.end()), ret.end());
@@ -406,33 +584,47 @@ QList<point_t> Container::getPointList(system_t system, group_t group) const
 QList<point_t> Container::getPointList(cid_t cid, system_t system, group_t group) const
 {
     QMutexLocker lock(&addressMapMutex);
-
-    if (!addressMap.contains(cid)) return QList<point_t>();
-    if (!addressMap[cid].contains(system)) return QList<point_t>();
-    if (!addressMap[cid][system].contains(group)) return QList<point_t>();
-
-    QList<point_t> ret = addressMap[cid][system][group].keys();
+    QList<point_t> ret = pointStore.getPoints(cid, system, group);
     std::sort(ret.begin(),ret.end());
     return ret;
 }
 
 pointDetails_t Container::PointDetails(cid_t cid, address_t address)
 {
-    QMutexLocker lock(&addressMapMutex);
-    return addressMap[cid][address.system][address.group][address.point];
+    return std::as_const(*this).PointDetails(cid, address);
 }
 pointDetails_t Container::PointDetails(cid_t cid, address_t address) const
 {
     QMutexLocker lock(&addressMapMutex);
-    if (addressMap[cid][address.system][address.group].contains(address.point))
-        return addressMap[cid][address.system][address.group].value(address.point);
+    if (auto details = pointStore.find(cid, address))
+        return details;
     else
         return std::make_shared<pointDetails>();
 }
 
 bool Container::isValid(const address_t address) const
 {
-    return getPointList(address.system, address.group).contains(address.point);
+    QMutexLocker lock(&addressMapMutex);
+    return pointStore.contains(address);
+}
+
+bool Container::isValid(cid_t cid, address_t address) const
+{
+    QMutexLocker lock(&addressMapMutex);
+    return pointStore.find(cid, address) != nullptr;
+}
+
+QList<cid_t> Container::getSourceList(address_t address) const
+{
+    QList<cid_t> ret;
+    {
+        QMutexLocker lock(&addressMapMutex);
+        ret = pointStore.getSources(address);
+    }
+    ret.erase(std::remove_if(ret.begin(), ret.end(),
+                             [this](const cid_t &cid) { return !componentMap.contains(cid); }),
+              ret.end());
+    return ret;
 }
 
 void Container::prunePointList(const cid_t &cid, address_t address)
@@ -460,15 +652,154 @@ void Container::pruneModuleList(const cid_t &cid)
     if (itemsRemoved)
         emit updatedComponent(cid, componentMap.value(cid).getModuleList());
 
-    moduleListTimeoutMap[cid]->start(OTP_ADVERTISEMENT_TIMEOUT); // (re)start the timer
+    if (!componentMap.value(cid).getModuleList().isEmpty())
+        moduleExpiry.schedule(cid, OTP_ADVERTISEMENT_TIMEOUT); // Check again
 }
 
-void Container::pruneComponentList()
+void Container::tickExpiry()
 {
-    const auto componentList = getComponentList();
-    for (const auto &cid : componentList)
-        if (componentMap[cid].isExpired()) {
+    const auto now = CLOCK::now();
+
+    pointExpiry.tick([this, now](const std::pair<cid_t, address_t> &key)
+    {
+        const auto &[cid, address] = key;
+        pointDetails_t details;
+        {
+            QMutexLocker lock(&addressMapMutex);
+            details = pointStore.find(cid, address);
+        }
+        if (!details) return; // Removed
+
+        const auto lastSeen = details->getLastSeenTicks();
+        if (CLOCK::isExpired(lastSeen, OTP_TRANSFORM_DATA_LOSS_TIMEOUT, now))
+        {
+            setAddressDirty(address);
+            prunePointList(cid, address);
+        } else
+            pointExpiry.schedule(key, CLOCK::remaining(lastSeen, OTP_TRANSFORM_DATA_LOSS_TIMEOUT, now));
+    });
+
+    moduleExpiry.tick([this](const cid_t &cid)
+    {
+        if (componentMap.contains(cid)) pruneModuleList(cid);
+    });
+
+    componentExpiry.tick([this, now](const cid_t &cid)
+    {
+        if (!componentMap.contains(cid)) return;
+
+        const auto lastSeen = componentMap.value(cid).getLastSeenTicks();
+        if (CLOCK::isExpired(lastSeen, OTP_COMPONENT_TIMEOUT, now))
+        {
             qDebug() << parent() << "- Expired Component" << cid;
             removeComponent(cid);
-        }
+        } else
+            componentExpiry.schedule(cid, CLOCK::remaining(lastSeen, OTP_COMPONENT_TIMEOUT, now));
+    });
+}
+
+void Container::rankAddress(const address_t &address, winnerChanges_t &changes)
+{
+    for (const auto &cid : pointStore.getSources(address))
+    {
+        const auto handle = pointStore.getHandle(cid);
+        const auto details = pointStore.find(handle, address);
+        if (details && mergeComponents.contains(cid) && details->getPriority().isValid() && !details->isExpired())
+            pointStore.rank(handle, address, details->getPriority());
+        else
+            pointStore.unrank(handle, address);
+    }
+
+    const auto winner = pointStore.getWinner(address);
+    if (winner == winningSources.value(address)) return;
+    if (winner.isNull())
+        winningSources.remove(address);
+    else
+        winningSources.insert(address, winner);
+    changes.append({address, winner});
+    setSnapshotStale(address.system);
+}
+
+void Container::queueWinnerChanges(const winnerChanges_t &changes)
+{
+    if (changes.isEmpty()) return;
+
+    QMutexLocker lock(&pendingWinnerChangesMutex);
+    const bool queued = !pendingWinnerChanges.isEmpty();
+    pendingWinnerChanges.append(changes);
+    if (!queued)
+        QMetaObject::invokeMethod(this, [this]() { notifyWinnerChanges(); }, Qt::QueuedConnection);
+}
+
+void Container::notifyWinnerChanges()
+{
+    winnerChanges_t changes;
+    {
+        QMutexLocker lock(&pendingWinnerChangesMutex);
+        changes.swap(pendingWinnerChanges);
+    }
+    for (const auto &[address, cid] : std::as_const(changes))
+        emit winnerChanged(cid, address.system, address.group, address.point);
+}
+
+void Container::setSnapshotStale(system_t system)
+{
+    staleSystems.insert(system);
+    if (snapshotQueued) return;
+    snapshotQueued = true;
+    QMetaObject::invokeMethod(this, &Container::publishSnapshot, Qt::QueuedConnection);
+}
+
+void Container::publishSnapshot()
+{
+    // Merge the stale systems first, so winners are current
+    QList<system_t> stale;
+    {
+        QMutexLocker lock(&addressMapMutex);
+        stale = staleSystems.values();
+    }
+    for (const auto &system : std::as_const(stale))
+        merger->flush(system);
+    notifyWinnerChanges();
+
+    QMutexLocker lock(&addressMapMutex);
+    snapshotQueued = false;
+    if (staleSystems.isEmpty()) return;
+
+    // Copy only the changed systems
+    QHash<system_t, std::shared_ptr<systemSnapshot_t>> changed;
+    for (const auto &system : std::as_const(staleSystems))
+        changed.insert(system, std::make_shared<systemSnapshot_t>());
+    staleSystems.clear();
+
+    for (const auto &record : pointStore.records())
+    {
+        const auto system = changed.constFind(record.address.system);
+        if (system == changed.cend()) continue;
+
+        const auto cid = pointStore.getCID(record.handle);
+        auto &entry = (**system)[record.address];
+        entry.points.append({
+                cid,
+                componentMap.contains(cid),
+                record.details->getPriority(),
+                record.details->standardModules});
+    }
+
+    auto next = std::make_unique<networkSnapshot_t>();
+    next->systems = snapshot.read()->systems;
+    for (auto system = changed.begin(); system != changed.end(); ++system)
+    {
+        for (auto entry = system.value()->begin(); entry != system.value()->end(); ++entry)
+            entry->winner = pointStore.getWinner(entry.key());
+
+        if (system.value()->isEmpty())
+            next->systems.remove(system.key());
+        else
+            next->systems.insert(system.key(), system.value());
+    }
+    lock.unlock();
+
+    snapshot.publish(std::move(next));
+    emit publishedSnapshot(changed.keys());
 }
@@ -25,6 +25,10 @@
 #include <QObject>
 #include <QMutex>
 #include "types.hpp"
+#include "pointstore.hpp"
+#include "timingwheel.hpp"
+#include "epochpointer.hpp"
+#include "snapshot.hpp"
 
 namespace OTP
 {
@@ -122,7 +126,8 @@ namespace OTP
 
         /**
          * @brief Get the winning component for a specific address
-         * @details Winning component is based upon advertised priority level
+         * @details Winning component is based upon advertised priority level, ties are won by the most recently ranked source.
+         * A pending merge of the address's system is run first, so the winner is never stale
          * 
          * @param address Address to query
          * @return Winning Component IDenifier
@@ -170,11 +175,55 @@ namespace OTP
 
         /**
          * @brief Flag a system as dirty and in need of merging
+         * @details Every address in the system is merged
          * 
          * @param system System to flag
          */
         void setSystemDirty(system_t system);
 
+        /**
+         * @brief Flag an address as dirty and in need of merging
+         * @details Addresses are flagged as points are changed, expired or removed.
+         * Only dirty addresses are merged
+         * 
+         * @param address Address to flag
+         */
+        void setAddressDirty(const address_t &address) { setAddressesDirty(address.system, {address}); }
+
+        /**
+         * @brief Merge statistics
+         * 
+         */
+        typedef struct mergeStatistics_t
+        {
+            int workers = 0; /*!< Merge worker threads */
+            quint64 merges = 0; /*!< System merges run */
+            quint64 addresses = 0; /*!< Addresses merged */
+            int pending = 0; /*!< Systems waiting to be merged */
+        } mergeStatistics_t;
+
+        /**
+         * @brief Get the merge statistics
+         * 
+         * @return Merge statistics
+         */
+        mergeStatistics_t getMergeStatistics() const;
+
+        /**
+         * @brief Get the number of merge worker threads
+         * 
+         * @return Worker threads
+         */
+        int getMergeWorkers() const;
+
+        /**
+         * @brief Set the number of merge worker threads
+         * @details Workers are shared by all systems
+         * 
+         * @param count Worker threads, at least 1
+         */
+        void setMergeWorkers(int count);
+
         /**
          * @brief Add a group for a component
          * @details If the group already exists in the component, then it's updated
@@ -323,6 +372,63 @@ namespace OTP
                        system_t newSystem, group_t newGroup, point_t newPoint)
             { movePoint(cid, {oldSystem, oldGroup, oldPoint}, {newSystem, newGroup, newPoint}); }
 
+        /**
+         * @brief Set the priority of a point
+         * @details The address is merged, to rank the new priority
+         * 
+         * @param cid Component IDenifier
+         * @param address Address of point
+         * @param priority New priority
+         */
+        void setPointPriority(cid_t cid, address_t address, priority_t priority);
+
+        /**
+         * @brief Point update, applied by applyPointBatch()
+         * 
+         */
+        typedef struct {
+            address_t address; /**< Point address */
+            priority_t priority; /**< Point priority */
+            pointDetails::standardModules_t standardModules; /**< Standard module data received for point */
+        } pointUpdate_t;
+
+        /**
+         * @brief Point changed by applyPointBatch()
+         * 
+         */
+        typedef struct {
+            address_t address; /**< Point address */
+            pointDetails::standardModules_t previous; /**< Standard module data before the batch */
+            pointDetails::standardModules_t current; /**< Standard module data after the batch */
+        } pointChange_t;
+
+        /**
+         * @brief applyPointBatch() result
+         * 
+         */
+        typedef struct {
+            QVector<pointChange_t> points; /**< Points updated, in batch order */
+            moduleList_t newModules; /**< Modules new to the component */
+        } batchResult_t;
+
+        /**
+         * @brief Add, or update, a batch of points and modules for a component's system
+         * @details Equivalent to addPoint(), PointDetails() and addModule() for each item,
+         * but the point details are located and updated under a single lock.
+         * Points not within the system, or with an invalid address or priority, are ignored.
+         * 
+         * @param cid Component IDenifier
+         * @param system System containing all the points
+         * @param points Point updates
+         * @param modules Modules used by the points
+         * @return Changed points and modules, for notification
+         */
+        batchResult_t applyPointBatch(
+                cid_t cid,
+                system_t system,
+                const QVector<pointUpdate_t> &points,
+                const moduleList_t &modules);
+
         /**
          * @brief Get a list of all known point for a system's group
          * 
@@ -389,6 +495,24 @@ namespace OTP
         bool isValid(system_t system, group_t group, point_t point) const
             { return isValid(address_t{system, group, point}); }
 
+        /**
+         * @brief Is the point valid (i.e. known) for a specfic component?
+         * 
+         * @param cid Component IDenifier
+         * @param address Address of the point to query
+         * @return true The point is known to the component
+         * @return false The point is unknown to the component
+         */
+        bool isValid(cid_t cid, address_t address) const;
+
+        /**
+         * @brief Get all known components with a point at an address
+         * 
+         * @param address Address of the point to query
+         * @return Component IDenifiers, unsorted
+         */
+        QList<cid_t> getSourceList(address_t address) const;
+
         /**
          * @brief Has the point expired?
          * 
@@ -413,6 +537,31 @@ namespace OTP
         bool isExpired(cid_t cid, system_t system, group_t group, point_t point) const
             { return isExpired(cid, {system, group, point}); }
 
+        /**
+         * @brief Reader of the published snapshot
+         * @details The snapshot is unchanged for the lifetime of the reader
+         */
+        typedef epochPointer_t<networkSnapshot_t>::reader_t snapshotReader_t;
+
+        /**
+         * @brief Read the published snapshot of point data
+         * @details Does not lock, so never blocks or is blocked by changes to the container.
+         * Readers should be short lived, as snapshots replaced while being read are kept until released
+         * 
+         * @return Snapshot reader
+         */
+        snapshotReader_t readSnapshot() const { return snapshot.read(); }
+
+        /**
+         * @brief Publish a new snapshot of point data
+         * @details Only systems changed since the last snapshot are copied, after merging any of their pending changes.
+         * Called by Consumer after each applied folio. Other changes are published from the event loop,
+         * with each change queuing a publish if one is not already pending.
+         * 
+         * Must be called from the container's thread.
+         */
+        void publishSnapshot();
+
     signals:
         /**
          * @brief Emitted when a new Component is discovered/added
@@ -511,6 +660,21 @@ namespace OTP
          */
         void removedPoint(OTP::cid_t, OTP::system_t, OTP::group_t, OTP::point_t);
 
+        /**
+         * @brief Emitted when the winning source of a Point changes
+         * @details Component IDenifier is null when no source remains.
+         * Emitted from the container's thread, once the address is merged
+         * 
+         */
+        void winnerChanged(OTP::cid_t, OTP::system_t, OTP::group_t, OTP::point_t);
+
+        /**
+         * @brief Emitted after a new snapshot is published
+         * 
+         * @param systems Systems changed, or removed, since the previous snapshot
+         */
+        void publishedSnapshot(QList<OTP::system_t> systems);
+
     private slots:
         /**
          * @brief Check for, and prune, expired points for specified component and address
@@ -528,20 +692,21 @@ namespace OTP
         void pruneModuleList(const OTP::cid_t &cid);
 
         /**
-         * @brief Check for, and prune, expired components
-         * @details Called regularly by QTimer componentTimeout
+         * @brief Advance the expiry timing wheels, checking any points, modules and components due
+         * @details Called regularly by expiryTimer.
+         * Anything seen since it was scheduled is scheduled again for its remaining time.
          */
-        void pruneComponentList();
+        void tickExpiry();
 
     private:
         /**
-         * @brief Mutex to protect addressMap
+         * @brief Mutex to protect pointStore
          */
         mutable QMutex addressMapMutex;
         /**
-         * @brief Container of point details indexed by CID, system, group, point
+         * @brief Container of point details indexed by CID and address
          */
-        addressMap_t addressMap;
+        pointStore_t pointStore;
 
         /**
          * @brief Container of component details indexed by CID
@@ -549,33 +714,145 @@ namespace OTP
         componentMap_t componentMap;
 
         /**
-         * @brief Regularly calls pruneComponentList()
+         * @brief Period of expiryTimer
+         */
+        static constexpr std::chrono::milliseconds expiryResolution = std::chrono::milliseconds(100);
+
+        /**
+         * @brief Regularly calls tickExpiry()
          */
-        QTimer componentTimeout;
+        CLOCK::Timer expiryTimer;
 
         /**
-         * @brief Container of QTimers to prune expired modules
-         * @details Modules are pruned by pruneModuleList() called from lambda function created in addModule()
+         * @brief Points due an expiry check by prunePointList()
+         * @details Scheduled when a point is first seen, received packets only update the point's last seen time
          */
-        QMap<cid_t, std::shared_ptr<QTimer>> moduleListTimeoutMap;
+        timingWheel_t<std::pair<cid_t, address_t>> pointExpiry{expiryResolution};
 
         /**
-         * @brief Container of QTimers to prune expired points
-         * @details Points are pruned by prunePointList() called from lambda function created in addPoint()
+         * @brief Components due a module expiry check by pruneModuleList()
          */
-        QMap<address_t, std::shared_ptr<QTimer>> pointTimeoutMap;
+        timingWheel_t<cid_t> moduleExpiry{expiryResolution};
 
         /**
-         * @brief Container of Merger threads, to determine winning source for each address
-         * @details winningSources is updated by this thread
+         * @brief Components due an expiry check
          */
-        QMap<system_t, std::shared_ptr<Merger>> mergerThreads;
+        timingWheel_t<cid_t> componentExpiry{expiryResolution};
+
+        /**
+         * @brief Components in componentMap, which may win a merge
+         * @details Protected by addressMapMutex, so can be read by Merger workers
+         */
+        QSet<cid_t> mergeComponents;
+
+        /**
+         * @brief Addresses awaiting a merge
+         */
+        typedef struct {
+            bool all = false; /**< Every address in the system */
+            QSet<address_t> addresses; /**< Only these addresses, if not all */
+        } dirtyAddresses_t;
+
+        /**
+         * @brief Flag addresses as dirty, and queue the system for merging
+         * 
+         * @param system System of addresses
+         * @param addresses Addresses to flag
+         */
+        void setAddressesDirty(system_t system, const QVector<address_t> &addresses);
+
+        /**
+         * @brief Take, and clear, the addresses awaiting a merge
+         * @details Called by Merger workers
+         * 
+         * @param system System to take
+         * @return Dirty addresses
+         */
+        dirtyAddresses_t takeDirtyAddresses(system_t system);
+
+        /**
+         * @brief Mutex to protect dirtyAddresses
+         */
+        QMutex dirtyAddressesMutex;
+
+        /**
+         * @brief Addresses awaiting a merge, indexed by system
+         */
+        QHash<system_t, dirtyAddresses_t> dirtyAddresses;
+
+        /**
+         * @brief Merger pool, to rank the sources of dirty addresses
+         */
+        std::unique_ptr<Merger> merger;
 
         /**
          * @brief Container of winning component indexed by address
-         * @details Updated by mergerThread
+         * @details Winners as last merged, to detect changes. Protected by addressMapMutex
          */
         QHash<address_t, cid_t> winningSources;
+
+        /**
+         * @brief Addresses with a new winning source, and the new winner
+         */
+        typedef QVector<std::pair<address_t, cid_t>> winnerChanges_t;
+
+        /**
+         * @brief Rank, or unrank, each source of an address
+         * @details Called by Merger workers, which hold addressMapMutex.
+         * A source is eligible to win if the component is known, and its point is unexpired with a valid priority.
+         * 
+         * @param address Address to rank
+         * @param changes Appended with the address if the winner changes
+         */
+        void rankAddress(const address_t &address, winnerChanges_t &changes);
+
+        /**
+         * @brief Queue winnerChanged() for each change, to be emitted from the container's thread
+         * 
+         * @param changes Addresses with a new winner
+         */
+        void queueWinnerChanges(const winnerChanges_t &changes);
+
+        /**
+         * @brief Emit winnerChanged() for each queued change
+         * @details Must be called from the container's thread
+         */
+        void notifyWinnerChanges();
+
+        /**
+         * @brief Mutex to protect pendingWinnerChanges
+         */
+        QMutex pendingWinnerChangesMutex;
+
+        /**
+         * @brief Changes awaiting notifyWinnerChanges()
+         */
+        winnerChanges_t pendingWinnerChanges;
+
+        /**
+         * @brief Flag a system as changed since the last snapshot, and queue a publish
+         * @details Caller must hold addressMapMutex
+         * 
+         * @param system Changed system
+         */
+        void setSnapshotStale(system_t system);
+
+        /**
+         * @brief Systems changed since the last snapshot
+         * @details Protected by addressMapMutex
+         */
+        QSet<system_t> staleSystems;
+
+        /**
+         * @brief Is a publishSnapshot() queued
+         * @details Protected by addressMapMutex
+         */
+        bool snapshotQueued = false;
+
+        /**
+         * @brief Published snapshot of point data
+         */
+        epochPointer_t<networkSnapshot_t> snapshot;
     };
 }
 
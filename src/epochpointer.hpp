@@ -0,0 +1,203 @@
+/**
+ * @file        epochpointer.hpp
+ * @brief       Epoch protected pointer, for lock free reads
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef EPOCHPOINTER_HPP
+#define EPOCHPOINTER_HPP
+
+#include <QtGlobal>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <thread>
+#include <vector>
+
+namespace OTP
+{
+    /**
+     * @internal
+     * @brief Epoch protected pointer to an immutable value
+     * @details Read, copy, update: readers never block, and a single writer publishes replacement values.
+     *
+     * A reader announces the current epoch in a free slot before loading the pointer.
+     * Each publish advances the epoch, and replaced values are only deleted once no reader
+     * announced an epoch from before they were replaced.
+     *
+     * Reclaiming is done by the writer as it publishes, so a reader holding a value for a long time only delays it.
+     *
+     * @tparam T Value type
+     */
+    template <typename T>
+    class epochPointer_t
+    {
+    public:
+        /**
+         * @brief Read access to the current value
+         * @details The value remains valid, and unchanged, for the lifetime of the reader
+         */
+        class reader_t
+        {
+        public:
+            /**
+             * @brief Start reading
+             *
+             * @param owner Pointer to read
+             */
+            explicit reader_t(const epochPointer_t &owner)
+            {
+                auto index = std::hash<std::thread::id>()(std::this_thread::get_id()) % slotCount;
+                while (true)
+                {
+                    auto expected = idle;
+                    const auto epoch = owner.epoch.load();
+                    if (owner.slots[index].epoch.compare_exchange_weak(expected, epoch)) break;
+                    index = (index + 1) % slotCount; // Slot in use by another reader
+                }
+                slot = &owner.slots[index].epoch;
+                value = owner.current.load();
+            }
+
+            ~reader_t() { slot->store(idle, std::memory_order_release); }
+
+            reader_t(const reader_t&) = delete;
+            reader_t& operator=(const reader_t&) = delete;
+
+            /**
+             * @brief Get the value
+             *
+             * @return Value
+             */
+            const T *get() const { return value; }
+            const T *operator->() const { return value; }
+            const T &operator*() const { return *value; }
+
+        private:
+            std::atomic<quint64> *slot;
+            const T *value;
+        };
+
+        /**
+         * @brief Construct a new epoch pointer
+         *
+         * @param value Initial value
+         */
+        explicit epochPointer_t(std::unique_ptr<const T> value = std::make_unique<const T>()) :
+            current(value.release())
+        {}
+
+        /**
+         * @brief Delete the current and all replaced values
+         * @details There must be no readers remaining
+         */
+        ~epochPointer_t()
+        {
+            for (const auto &[epoch, value] : retired)
+                delete value;
+            delete current.load();
+        }
+
+        epochPointer_t(const epochPointer_t&) = delete;
+        epochPointer_t& operator=(const epochPointer_t&) = delete;
+
+        /**
+         * @brief Read the current value
+         *
+         * @return Reader, holding the value
+         */
+        reader_t read() const { return reader_t(*this); }
+
+        /**
+         * @brief Replace the current value
+         * @details Not thread safe, publishing must be serialised by the caller.
+         * Replaced values no longer being read are deleted.
+         *
+         * @param value New value
+         */
+        void publish(std::unique_ptr<const T> value)
+        {
+            const auto replaced = current.exchange(value.release());
+            retired.push_back({epoch.fetch_add(1) + 1, replaced});
+            reclaim();
+        }
+
+        /**
+         * @brief Get the current epoch
+         * @details Advanced by each publish()
+         *
+         * @return Epoch
+         */
+        quint64 getEpoch() const { return epoch.load(); }
+
+        /**
+         * @brief Get number of replaced values not yet deleted
+         *
+         * @return Values waiting for readers
+         */
+        size_t retiredCount() const { return retired.size(); }
+
+    private:
+        static constexpr size_t slotCount = 128;
+        static constexpr quint64 idle = 0;
+
+        void reclaim()
+        {
+            // Oldest epoch still being read
+            auto oldest = std::numeric_limits<quint64>::max();
+            for (const auto &slot : slots)
+            {
+                const auto epoch = slot.epoch.load();
+                if (epoch != idle) oldest = std::min(oldest, epoch);
+            }
+
+            auto it = retired.begin();
+            while (it != retired.end())
+            {
+                if (it->first <= oldest)
+                {
+                    delete it->second;
+                    it = retired.erase(it);
+                } else
+                    ++it;
+            }
+        }
+
+        std::atomic<const T*> current;
+        std::atomic<quint64> epoch{1};
+
+        /**
+         * @brief Epoch announced by each reader, or idle
+         * @details Each on its own cache line, so readers do not contend
+         */
+        struct alignas(64) slot_t {
+            std::atomic<quint64> epoch{idle};
+        };
+        mutable std::array<slot_t, slotCount> slots;
+
+        /**
+         * @brief Replaced values, and the epoch they were replaced in
+         */
+        std::vector<std::pair<quint64, const T*>> retired;
+    };
+}
+
+#endif // EPOCHPOINTER_HPP
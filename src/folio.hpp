@@ -0,0 +1,235 @@
+/**
+ * @file        folio.hpp
+ * @brief       Folio reassembly
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef FOLIO_HPP
+#define FOLIO_HPP
+
+#include "types.hpp"
+#include <QMap>
+#include <chrono>
+#include <utility>
+#include <vector>
+
+namespace OTP
+{
+    /**
+     * @internal
+     * @brief Folio reassembly
+     * @details Used to assemble folios split over several messages, each page being decoded once before it is added.
+     * 
+     * <b>OTP Folio:</b> An OTP Folio is a set of OTP Messages with the same folio number. 
+     * Together they make up a snapshot of information which due to its size has to be split across multiple messages.
+     * 
+     * Each source of folios, a Component IDentifier, System and Vector, has a single slot.
+     * Received pages are tracked with a bitmap, so pages may arrive in any order, and duplicates are dropped.
+     * Page storage grows with the highest page received, not the last page claimed by the folio.
+     * An incomplete folio is evicted when a page of a newer folio arrives, or when no page has arrived within the timeout.
+     * 
+     * @tparam Page Decoded page
+     */
+    template <typename Page>
+    class folioReassembler_t
+    {
+    public:
+        /**
+         * @brief addPage() result
+         * 
+         */
+        typedef enum {
+            Incomplete, /**< Page added, more pages are required */
+            Complete, /**< Page added, all pages are present and ready for takePages() */
+            Duplicate, /**< Page was already present, and was dropped */
+            Stale, /**< Page is from a folio older than the current folio, and was dropped */
+            Invalid /**< Page numbers are not valid for this folio, and the page was dropped */
+        } addPage_ret;
+
+        /**
+         * @brief Construct a folio reassembler
+         * 
+         * @param timeout Time after which an incomplete folio is evicted, and the folio sequence restarted
+         */
+        explicit folioReassembler_t(std::chrono::milliseconds timeout) : timeout(timeout) {}
+
+        /**
+         * @brief Add a decoded page
+         * @details 
+         * The Folio Number for the relevant OTP Advertisement Message type shall be incremented by one 
+         * for every OTP Folio sent of that type. 
+         * The Folio Number for the relevant System shall be incremented by one for every OTP Folio sent for that System.
+         * Folio Numbers shall roll over from 0xFFFFFFFF to 0x00000000.
+         * 
+         * @param cid Component IDentifier of folio source
+         * @param system System of folio source
+         * @param vector OTP Message type
+         * @param folio Folio number
+         * @param page Page number
+         * @param lastPage Last page number
+         * @param value Decoded page
+         * @return Result
+         */
+        addPage_ret addPage(
+                cid_t cid,
+                system_t system,
+                PDU::vector_t vector,
+                PDU::OTPLayer::folio_t folio,
+                PDU::OTPLayer::page_t page,
+                PDU::OTPLayer::page_t lastPage,
+                Page value)
+        {
+            if (page > lastPage) return Invalid;
+            auto &slot = folios[{cid, {system, vector}}];
+
+            // Idle too long, evict anything incomplete and restart the sequence
+            if ((slot.updated != CLOCK::never) && CLOCK::isExpired(slot.updated, timeout))
+            {
+                slot.assembling = false;
+                slot.hasCompleted = false;
+            }
+            slot.updated = CLOCK::now();
+
+            // Older than, or the same as, the last completed folio
+            if (slot.hasCompleted && !slot.completed.checkSequence(folio)) return Stale;
+
+            if (!slot.assembling || (slot.folio != folio))
+            {
+                // Older than the folio being assembled
+                if (slot.assembling && !slot.folio.checkSequence(folio)) return Stale;
+
+                // Start a new folio, evicting any incomplete folio
+                slot.assembling = true;
+                slot.folio = folio;
+                slot.lastPage = lastPage;
+                slot.received = 0;
+                slot.bitmap.clear();
+                slot.pages.clear();
+            }
+            else if (slot.lastPage != lastPage)
+                return Invalid;
+
+            // Grow to the highest page received, rather than trusting lastPage from the wire
+            if (page / 64 >= slot.bitmap.size()) slot.bitmap.resize((page / 64) + 1, 0);
+            if (page >= slot.pages.size()) slot.pages.resize(page + 1);
+
+            const quint64 bit = quint64(1) << (page % 64);
+            auto &word = slot.bitmap[page / 64];
+            if (word & bit) return Duplicate;
+            word |= bit;
+            slot.pages[page] = std::move(value);
+
+            if (++slot.received <= slot.lastPage) return Incomplete;
+            slot.assembling = false;
+            slot.hasCompleted = true;
+            slot.completed = folio;
+            return Complete;
+        }
+
+        /**
+         * @brief Add a decoded page, for a folio without a system
+         * 
+         * @param cid Component IDentifier of folio source
+         * @param vector OTP Message type
+         * @param folio Folio number
+         * @param page Page number
+         * @param lastPage Last page number
+         * @param value Decoded page
+         * @return Result
+         */
+        addPage_ret addPage(
+                cid_t cid,
+                PDU::vector_t vector,
+                PDU::OTPLayer::folio_t folio,
+                PDU::OTPLayer::page_t page,
+                PDU::OTPLayer::page_t lastPage,
+                Page value)
+        {
+            return addPage(cid, noSystem(), vector, folio, page, lastPage, std::move(value));
+        }
+
+        /**
+         * @brief Take the pages of the last completed folio
+         * @details Pages are only available once, directly after addPage() returns Complete
+         * 
+         * @param cid Component IDentifier of folio source
+         * @param system System of folio source
+         * @param vector OTP Message type
+         * @return Decoded pages, in page order
+         */
+        std::vector<Page> takePages(cid_t cid, system_t system, PDU::vector_t vector)
+        {
+            auto slot = folios.find({cid, {system, vector}});
+            if ((slot == folios.end()) || slot->assembling) return std::vector<Page>();
+            auto ret = std::move(slot->pages);
+            slot->pages.clear();
+            return ret;
+        }
+
+        /**
+         * @brief Take the pages of the last completed folio, for a folio without a system
+         * @details Pages are only available once, directly after addPage() returns Complete
+         * 
+         * @param cid Component IDentifier of folio source
+         * @param vector OTP Message type
+         * @return Decoded pages, in page order
+         */
+        std::vector<Page> takePages(cid_t cid, PDU::vector_t vector)
+        {
+            return takePages(cid, noSystem(), vector);
+        }
+
+        /**
+         * @brief Remove all folios owned by a specfic component
+         * 
+         * @param cid Component IDentifier of folio source
+         */
+        void removeComponent(cid_t cid)
+        {
+            for (auto slot = folios.begin(); slot != folios.end();)
+            {
+                if (slot.key().first == cid)
+                    slot = folios.erase(slot);
+                else
+                    ++slot;
+            }
+        }
+
+    private:
+        static system_t noSystem() { return system_t::getMin() - 1; }
+
+        typedef std::pair<cid_t, std::pair<system_t, PDU::vector_t>> key_t;
+        struct slot_t {
+            bool assembling = false;
+            PDU::OTPLayer::folio_t folio;
+            PDU::OTPLayer::page_t lastPage = 0;
+            int received = 0;
+            std::vector<quint64> bitmap;
+            std::vector<Page> pages;
+
+            bool hasCompleted = false;
+            PDU::OTPLayer::folio_t completed;
+
+            CLOCK::ticks_t updated = CLOCK::never;
+        };
+        QMap<key_t, slot_t> folios;
+        const std::chrono::milliseconds timeout;
+    };
+}
+
+#endif // FOLIO_HPP
@@ -1,6 +1,6 @@
 /**
  * @file        merger.cpp
- * @brief       Merger thread to determine winning component for each address
+ * @brief       Merger pool to determine winning component for each address
  * @details     Part of OTPLib - A QT interface for E1.59
  * @authors     Marcus Birkin
  * @copyright   Copyright (C) 2022 Marcus Birkin
@@ -20,82 +20,165 @@
  *
  */
 #include "merger.hpp"
+#include <algorithm>
 
 using namespace OTP;
-Merger::Merger(system_t system, Container *parent)
-    : QThread(parent),
-      running(true),
-      system(system),
-      dirty(true)
+Merger::Merger(Container *parent, int workers)
+    : parent(parent)
 {
-    QThread::setObjectName(QString("Merger system %1").arg(system));
-    QThread::start();
+    startWorkers(workers);
 }
 
 Merger::~Merger()
 {
-    running = false;
-    wait();
+    stopWorkers();
 }
 
-void Merger::run()
+int Merger::defaultWorkers()
+{
+    return std::clamp(QThread::idealThreadCount() / 2, 1, 4);
+}
+
+int Merger::getWorkers() const
+{
+    return static_cast<int>(workers.size());
+}
+
+void Merger::setWorkers(int count)
 {
-    qDebug() << parent()->parent() << "Started merger thread system" << system;
+    count = std::max(count, 1);
+    if (count == getWorkers()) return;
 
-    while (running)
+    stopWorkers();
+    startWorkers(count);
+    qDebug() << parent->parent() << "Merger workers" << count;
+}
+
+void Merger::startWorkers(int count)
+{
     {
-        dirty.waitFor(std::chrono::seconds(1));
-        doMerge();
-        dirty = false;
+        std::lock_guard lock(mutex);
+        stopping = false;
     }
+    for (int n = 0; n < std::max(count, 1); n++)
+    {
+        workers.emplace_back(QThread::create([this]() { run(); }));
+        workers.back()->setObjectName(QString("Merger %1").arg(n));
+        workers.back()->start();
+    }
+}
 
-    qDebug() << parent()->parent() << "Stopping merger thread system" << system;
+void Merger::stopWorkers()
+{
+    {
+        std::lock_guard lock(mutex);
+        stopping = true;
+    }
+    wake.notify_all();
+    for (auto &worker : workers)
+        worker->wait();
+    workers.clear();
 }
 
-void Merger::quit()
+void Merger::setDirty(system_t system)
 {
-    running = false;
+    {
+        std::lock_guard lock(mutex);
+        if (queued.contains(system)) return;
+        queued.insert(system);
+
+        // Systems being merged are queued again once finished
+        if (active.contains(system)) return;
+        queue.push_back(system);
+    }
+    wake.notify_one();
 }
 
-void Merger::setDirty()
+Container::mergeStatistics_t Merger::getStatistics() const
 {
-    dirty = true;
+    std::lock_guard lock(mutex);
+    Container::mergeStatistics_t ret;
+    ret.workers = static_cast<int>(workers.size());
+    ret.merges = merges;
+    ret.addresses = addresses;
+    ret.pending = static_cast<int>(queued.size());
+    return ret;
 }
 
-void Merger::doMerge()
+void Merger::flush(system_t system)
 {
-    // Winning source for each address, based on priority
-    const auto &componentMap = parent()->componentMap;
-    const auto &addressMap = parent()->addressMap;
-    auto &winningSources = parent()->winningSources;
+    std::unique_lock lock(mutex);
+    finished.wait(lock, [this, system]() { return !active.contains(system); });
+    if (!queued.contains(system)) return;
+    queue.erase(std::remove(queue.begin(), queue.end(), system), queue.end());
+    take(system);
+
+    lock.unlock();
+    const auto merged = doMerge(system);
+    lock.lock();
 
-    for (auto component = componentMap.cbegin(); component != componentMap.cend(); component++)
+    finish(system, merged);
+}
+
+void Merger::run()
+{
+    std::unique_lock lock(mutex);
+    while (true)
     {
-        if (!running) return;
+        wake.wait(lock, [this]() { return stopping || !queue.empty(); });
+        if (stopping) return;
 
-        QMutexLocker addressLock(&parent()->addressMapMutex);
-        cid_t cid = component.key();
-        const auto groups = addressMap.value(cid).value(system);
-        for (auto group = groups.cbegin(); group != groups.cend(); group++)
-        {
-            if (!running) return;
+        const auto system = queue.front();
+        queue.pop_front();
+        take(system);
 
-            for (auto point = group->cbegin(); point != group->cend(); point++)
-            {
-                if (!running) return;
+        lock.unlock();
+        const auto merged = doMerge(system);
+        lock.lock();
+
+        finish(system, merged);
+    }
+}
+
+void Merger::take(system_t system)
+{
+    queued.remove(system);
+    active.insert(system);
+}
 
-                auto address = address_t(system, group.key(), point.key());
+void Merger::finish(system_t system, quint64 merged)
+{
+    active.remove(system);
+    merges++;
+    addresses += merged;
+    if (queued.contains(system))
+    {
+        queue.push_back(system);
+        wake.notify_one();
+    }
+    finished.notify_all();
+}
 
-                auto pdA = addressMap[winningSources[address]][address.system][address.group][address.point];
-                const auto pdB = addressMap[cid][address.system][address.group][address.point];
+quint64 Merger::doMerge(system_t system)
+{
+    auto dirty = parent->takeDirtyAddresses(system);
+    if (!dirty.all && dirty.addresses.isEmpty()) return 0;
 
-                if (!pdB || pdB->isExpired()) continue;
-                if (!pdA || pdA->isExpired() || pdB->getPriority() > pdA->getPriority())
-                {
-                    winningSources[address] = cid;
-                    pdA = pdB;
-                }
-            }
+    Container::winnerChanges_t changes;
+    {
+        QMutexLocker lock(&parent->addressMapMutex);
+        if (dirty.all)
+        {
+            for (const auto &record : parent->pointStore.records())
+                if (record.address.system == system) dirty.addresses.insert(record.address);
+            for (auto it = parent->winningSources.cbegin(); it != parent->winningSources.cend(); ++it)
+                if (it.key().system == system) dirty.addresses.insert(it.key());
         }
+
+        for (const auto &address : std::as_const(dirty.addresses))
+            parent->rankAddress(address, changes);
     }
+    parent->queueWinnerChanges(changes);
+
+    return static_cast<quint64>(dirty.addresses.size());
 }
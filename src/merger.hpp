@@ -1,6 +1,6 @@
 /**
  * @file        merger.hpp
- * @brief       Merger thread to determine winning component for each address
+ * @brief       Merger pool to determine winning component for each address
  * @details     Part of OTPLib - A QT interface for E1.59
  * @authors     Marcus Birkin
  * @copyright   Copyright (C) 2022 Marcus Birkin
@@ -23,56 +23,134 @@
 #define MERGER_HPP
 
 #include <QThread>
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <vector>
 #include "container.hpp"
-#include "eventflag.hpp"
 
 namespace OTP
 {
     /**
      * @internal
-     * @brief Merger thread to determine winning component for each address
-     * @details Winner is determined by source priority
-     * Updates winningSource container in parent class
+     * @brief Merger pool to determine winning component for each address
+     * @details Only addresses flagged dirty in the parent class are merged.
+     * The sources of each are ranked in the parent's priority heap for the address, so the winner is read from the top.
+     * Changed winners are notified by the parent
+     *
+     * Dirty systems are queued for a fixed pool of worker threads, each system is merged by one worker at a time.
+     * Workers sleep while the queue is empty.
      */
-    class Merger : public QThread
+    class Merger
     {
         public:
             /**
-             * @brief Construct a new merger
+             * @brief Construct a new merger pool
              * 
-             * @param system System to merge
              * @param parent Parent container
+             * @param workers Number of worker threads
              */
-            explicit Merger(system_t system, Container *parent);
+            explicit Merger(Container *parent, int workers = defaultWorkers());
             ~Merger();
 
             /**
-             * @brief Stop merger loop
+             * @brief Get the default number of worker threads
+             * 
+             * @return Half the ideal thread count, between 1 and 4
+             */
+            static int defaultWorkers();
+
+            /**
+             * @brief Get the number of worker threads
+             * 
+             * @return Worker threads
              */
-            void quit();
+            int getWorkers() const;
 
             /**
-             * @brief Flag system as dirty, needing merging
+             * @brief Set the number of worker threads
+             * @details Workers finish their current merge before being replaced, queued systems are kept
+             * 
+             * @param count Worker threads, at least 1
              */
-            void setDirty();
+            void setWorkers(int count);
 
-        protected:
             /**
-             * @brief QThread entry point
+             * @brief Flag system as dirty, queuing it for merging
+             * 
+             * @param system System to merge
              */
-            void run() override final;
+            void setDirty(system_t system);
+
+            /**
+             * @brief Merge a dirty system now, in the calling thread
+             * @details Waits for a worker already merging the system.
+             * Parent addressMapMutex must not be held
+             * 
+             * @param system System to merge
+             */
+            void flush(system_t system);
+
+            /**
+             * @brief Get the merge statistics
+             * 
+             * @return Merge statistics
+             */
+            Container::mergeStatistics_t getStatistics() const;
 
         private:
-            inline Container *parent() const { return static_cast<Container*>(QThread::parent()); }
-            std::atomic<bool> running;
+            Container *const parent;
 
-            const system_t system;
-            EventFlag dirty;
+            void startWorkers(int count);
+            void stopWorkers();
 
             /**
-             * @brief Run a single merge for the system
+             * @brief Worker thread entry point
              */
-            void doMerge();
+            void run();
+
+            /**
+             * @brief Take a queued system to merge
+             * @details Mutex must be held
+             * 
+             * @param system System to take
+             */
+            void take(system_t system);
+
+            /**
+             * @brief Finish merging a system, queuing it again if flagged dirty during the merge
+             * @details Mutex must be held
+             * 
+             * @param system System merged
+             * @param merged Number of addresses merged
+             */
+            void finish(system_t system, quint64 merged);
+
+            /**
+             * @brief Run a single merge for the dirty addresses of the system
+             * 
+             * @param system System to merge
+             * @return Number of addresses merged
+             */
+            quint64 doMerge(system_t system);
+
+            std::vector<std::unique_ptr<QThread>> workers;
+
+            /**
+             * @brief Mutex to protect the queue, and statistics
+             */
+            mutable std::mutex mutex;
+            std::condition_variable wake;
+            std::condition_variable finished; /**< Notified as each system merge finishes */
+            bool stopping = false;
+
+            std::deque<system_t> queue; /**< Systems waiting for a worker */
+            QSet<system_t> queued; /**< Systems dirty since last taken by a worker */
+            QSet<system_t> active; /**< Systems being merged */
+
+            quint64 merges = 0;
+            quint64 addresses = 0;
     };
 }
 
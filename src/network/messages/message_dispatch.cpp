@@ -0,0 +1,52 @@
+/**
+ * @file        message_dispatch.cpp
+ * @brief       Identify OTP Messages from their headers
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#include "message_dispatch.hpp"
+#include "../pdu/pdu_const.hpp"
+#include <QtEndian>
+#include <cstring>
+
+using namespace OTP::PDU;
+
+OTP::MESSAGES::peek_t OTP::MESSAGES::peek(const PacketView &view)
+{
+    /* 6.1 Packet Identifier */
+    if (view.size < OTPLayer::SIZE) return {Rejected, TooShort};
+    if (std::memcmp(view.data, OTPLayer::OTP_PACKET_IDENT.constData(), OTPLayer::OTP_PACKET_IDENT.size()))
+        return {Rejected, InvalidPacketIdent};
+
+    /* 6.2 Vector, and 6.3 Length */
+    const auto header = view.data + OTPLayer::OTP_PACKET_IDENT.size();
+    const auto vector = qFromBigEndian<vector_t>(header);
+    const auto length = qFromBigEndian<pduLength_t>(header + sizeof(vector_t));
+    if ((length + OTPLayer::LENGTHOFFSET) > view.size) return {Rejected, InvalidLength};
+
+    if (vector == VECTOR_OTP_TRANSFORM_MESSAGE) return {TransformMessage, Accepted};
+    if (vector != VECTOR_OTP_ADVERTISEMENT_MESSAGE) return {Rejected, UnknownVector};
+
+    /* 11.1 Advertisement Layer Vector */
+    if (view.size < (OTPLayer::SIZE + OTPAdvertisementLayer::SIZE)) return {Rejected, TooShort};
+    const auto advertisementVector = qFromBigEndian<vector_t>(view.data + OTPLayer::SIZE);
+    if (advertisementVector == VECTOR_OTP_ADVERTISEMENT_MODULE) return {ModuleAdvertisementMessage, Accepted};
+    if (advertisementVector == VECTOR_OTP_ADVERTISEMENT_NAME) return {NameAdvertisementMessage, Accepted};
+    if (advertisementVector == VECTOR_OTP_ADVERTISEMENT_SYSTEM) return {SystemAdvertisementMessage, Accepted};
+    return {Rejected, UnknownAdvertisementVector};
+}
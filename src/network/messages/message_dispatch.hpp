@@ -0,0 +1,80 @@
+/**
+ * @file        message_dispatch.hpp
+ * @brief       Identify OTP Messages from their headers
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANY WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef MESSAGE_DISPATCH_HPP
+#define MESSAGE_DISPATCH_HPP
+
+#include "../../packet.hpp"
+
+namespace OTP::MESSAGES
+{
+    /**
+     * @internal
+     * @brief Message type, as identified by peek()
+     * 
+     */
+    typedef enum {
+        Rejected, /**< Not an OTP Message, see peek_t::reason */
+        TransformMessage, /**< OTP Transform Message */
+        ModuleAdvertisementMessage, /**< OTP Module Advertisement Message */
+        NameAdvertisementMessage, /**< OTP Name Advertisement Message */
+        SystemAdvertisementMessage /**< OTP System Advertisement Message */
+    } messageType_e;
+
+    /**
+     * @internal
+     * @brief Reason a packet was rejected by peek()
+     * 
+     */
+    typedef enum {
+        Accepted, /**< Not rejected */
+        TooShort, /**< Shorter than the layers required to identify it */
+        InvalidPacketIdent, /**< Not an OTP packet */
+        InvalidLength, /**< OTP Layer length exceeds the packet */
+        UnknownVector, /**< Unknown OTP Layer vector */
+        UnknownAdvertisementVector, /**< Unknown Advertisement Layer vector */
+        NotDecoded, /**< Identified, but invalid or ignored by the message decoder */
+        RejectReasonCount /**< Number of reasons */
+    } rejectReason_e;
+
+    /**
+     * @internal
+     * @brief Result of peek()
+     * 
+     */
+    typedef struct {
+        messageType_e type; /**< Message type */
+        rejectReason_e reason; /**< Reason for rejection, when type is Rejected */
+    } peek_t;
+
+    /**
+     * @internal
+     * @brief Identify a message from its packet ident, OTP Layer and Advertisement Layer vectors
+     * @details Reads only the fixed header fields from the raw packet, in constant time.
+     * The message itself is not validated, that is left to its decoder.
+     * 
+     * @param view Raw packet
+     * @return Message type, or reason for rejection
+     */
+    peek_t peek(const PacketView &view);
+}
+
+#endif // MESSAGE_DISPATCH_HPP
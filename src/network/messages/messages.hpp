@@ -30,6 +30,7 @@
  */
 namespace OTP::MESSAGES {}
 
+#include "message_dispatch.hpp"
 #include "otp_transform_message.hpp"
 #include "otp_module_advertisement_message.hpp"
 #include "otp_name_advertisement_message.hpp"
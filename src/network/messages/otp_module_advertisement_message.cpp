@@ -33,13 +33,13 @@ Message::Message(
     QObject(parent),  
     otpLayer(
         new OTPLayer::Layer(
-            VECTOR_OTP_ADVERTISEMENT_MESSAGE, 0, CID, 0, 0, 0, ComponentName, this)),
+            VECTOR_OTP_ADVERTISEMENT_MESSAGE, 0, CID, 0, 0, 0, ComponentName)),
     advertisementLayer(
         new OTP::PDU::OTPAdvertisementLayer::Layer(
-            OTP::PDU::VECTOR_OTP_ADVERTISEMENT_MODULE, 0, this)),
+            OTP::PDU::VECTOR_OTP_ADVERTISEMENT_MODULE, 0)),
     moduleAdvertisementLayer(
         new OTP::PDU::OTPModuleAdvertisementLayer::Layer(
-            0, ModuleList, this))
+            0, ModuleList))
 {
     Q_UNUSED(mode)
     updatePduLength();
@@ -52,21 +52,38 @@ Message::Message(
     otpLayer(new OTP::PDU::OTPLayer::Layer()),
     advertisementLayer(new OTP::PDU::OTPAdvertisementLayer::Layer()),
     moduleAdvertisementLayer(new OTP::PDU::OTPModuleAdvertisementLayer::Layer())
+{
+    fromByteArray(message.data());
+}
+
+Message::Message(
+        const Packet &packet,
+        QObject *parent) :
+    QObject(parent),
+    otpLayer(new OTP::PDU::OTPLayer::Layer()),
+    advertisementLayer(new OTP::PDU::OTPAdvertisementLayer::Layer()),
+    moduleAdvertisementLayer(new OTP::PDU::OTPModuleAdvertisementLayer::Layer())
+{
+    // Parse directly from the pooled buffer
+    fromByteArray(packet.toByteArray());
+}
+
+void Message::fromByteArray(const QByteArray &message)
 {
     int idx = 0;
 
     // OTP Layer
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx, otpLayer->toPDUByteArray().size())).size();
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx, OTPLayer::SIZE);
+        idx += layer.size();
         otpLayer->fromPDUByteArray(layer);
         if (!otpLayer->isValid()) return;
     }
 
     // Advertisment Layer
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx, advertisementLayer->toPDUByteArray().size())).size();
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx, OTPAdvertisementLayer::SIZE);
+        idx += layer.size();
         advertisementLayer->fromPDUByteArray(layer);
         if (!advertisementLayer->isValid()) return;
     }
@@ -74,8 +91,8 @@ Message::Message(
     // Module Advertisment Layer
     if (advertisementLayer->getVector() == PDU::VECTOR_OTP_ADVERTISEMENT_MODULE)
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx)).size();
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx);
+        idx += layer.size();
         moduleAdvertisementLayer->fromPDUByteArray(layer);
         if (!moduleAdvertisementLayer->isValid()) return;
     }
@@ -88,13 +105,13 @@ bool Message::isValid()
         return false;
     if (!otpLayer->isValid()) return false;
 
-    lengthCheck -= otpLayer->toPDUByteArray().length();
+    lengthCheck -= otpLayer->getSize();
     if (lengthCheck != static_cast<size_t>(advertisementLayer->getPDULength() + OTPAdvertisementLayer::LENGTHOFFSET))
         return false;
     if (advertisementLayer->getVector() != PDU::VECTOR_OTP_ADVERTISEMENT_MODULE) return false;
     if (!advertisementLayer->isValid()) return false;
 
-    lengthCheck -= advertisementLayer->toPDUByteArray().length();
+    lengthCheck -= advertisementLayer->getSize();
     if (lengthCheck != static_cast<size_t>(moduleAdvertisementLayer->getPDULength() + OTPModuleAdvertisementLayer::LENGTHOFFSET))
         return false;
     if (!moduleAdvertisementLayer->isValid()) return false;
@@ -117,12 +134,12 @@ QNetworkDatagram Message::toQNetworkDatagram(
 
 QByteArray Message::toByteArray()
 {   
-    QByteArray ba;
-    ba.append(otpLayer->toPDUByteArray());
-    ba.append(advertisementLayer->toPDUByteArray());
+    PDUByteArray ba;
+    otpLayer->toPDUByteArray(ba);
+    advertisementLayer->toPDUByteArray(ba);
     ba.append(moduleAdvertisementLayer->toPDUByteArray());
 
-    return ba;
+    return std::move(ba);
 }
 
 void Message::updatePduLength()
@@ -132,10 +149,10 @@ void Message::updatePduLength()
     moduleAdvertisementLayer->setPDULength(length - OTPModuleLayer::LENGTHOFFSET);
 
     /* 11.2 Length */
-    length += advertisementLayer->toPDUByteArray().size();
+    length += advertisementLayer->getSize();
     advertisementLayer->setPDULength(length - OTPAdvertisementLayer::LENGTHOFFSET);
 
     /* 6.3 Length */
-    length += otpLayer->toPDUByteArray().size();
+    length += otpLayer->getSize();
     otpLayer->setPDULength(length - OTPLayer::LENGTHOFFSET);
 }
@@ -32,13 +32,13 @@ Message::Message(OTP::mode_e mode,
     QObject(parent),
     otpLayer(
         new OTPLayer::Layer(
-            VECTOR_OTP_ADVERTISEMENT_MESSAGE, 0, CID, 0, 0, 0, ComponentName, this)),
+            VECTOR_OTP_ADVERTISEMENT_MESSAGE, 0, CID, 0, 0, 0, ComponentName)),
     advertisementLayer(
         new OTP::PDU::OTPAdvertisementLayer::Layer(
-            OTP::PDU::VECTOR_OTP_ADVERTISEMENT_NAME, 0, this)),
+            OTP::PDU::VECTOR_OTP_ADVERTISEMENT_NAME, 0)),
     nameAdvertisementLayer(
         new OTP::PDU::OTPNameAdvertisementLayer::Layer(
-            0, OTP::PDU::OTPNameAdvertisementLayer::options_t(), PointDescriptionList, this))
+            0, OTP::PDU::OTPNameAdvertisementLayer::options_t(), PointDescriptionList))
 {
     OTP::PDU::OTPNameAdvertisementLayer::options_t options;
     switch (mode) {
@@ -57,21 +57,38 @@ Message::Message(
     otpLayer(new OTP::PDU::OTPLayer::Layer()),
     advertisementLayer(new OTP::PDU::OTPAdvertisementLayer::Layer()),
     nameAdvertisementLayer(new OTP::PDU::OTPNameAdvertisementLayer::Layer())
+{
+    fromByteArray(message.data());
+}
+
+Message::Message(
+        const Packet &packet,
+        QObject *parent) :
+    QObject(parent),
+    otpLayer(new OTP::PDU::OTPLayer::Layer()),
+    advertisementLayer(new OTP::PDU::OTPAdvertisementLayer::Layer()),
+    nameAdvertisementLayer(new OTP::PDU::OTPNameAdvertisementLayer::Layer())
+{
+    // Parse directly from the pooled buffer
+    fromByteArray(packet.toByteArray());
+}
+
+void Message::fromByteArray(const QByteArray &message)
 {
     int idx = 0;
 
     // OTP Layer
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx, otpLayer->toPDUByteArray().size())).size();
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx, OTPLayer::SIZE);
+        idx += layer.size();
         otpLayer->fromPDUByteArray(layer);
         if (!otpLayer->isValid()) return;
     }
 
     // Advertisment Layer
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx, advertisementLayer->toPDUByteArray().size())).size();
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx, OTPAdvertisementLayer::SIZE);
+        idx += layer.size();
         advertisementLayer->fromPDUByteArray(layer);
         if (!advertisementLayer->isValid()) return;
     }
@@ -79,8 +96,8 @@ Message::Message(
     // Name Advertisment Layer
     if (advertisementLayer->getVector() == PDU::VECTOR_OTP_ADVERTISEMENT_NAME)
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx)).size();
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx);
+        idx += layer.size();
         nameAdvertisementLayer->fromPDUByteArray(layer);
         if (!nameAdvertisementLayer->isValid()) return;
     }
@@ -93,13 +110,13 @@ bool Message::isValid()
         return false;
     if (!otpLayer->isValid()) return false;
 
-    lengthCheck -= otpLayer->toPDUByteArray().length();
+    lengthCheck -= otpLayer->getSize();
     if (lengthCheck != static_cast<size_t>(advertisementLayer->getPDULength() + OTPAdvertisementLayer::LENGTHOFFSET))
         return false;
     if (advertisementLayer->getVector() != PDU::VECTOR_OTP_ADVERTISEMENT_NAME) return false;
     if (!advertisementLayer->isValid()) return false;
 
-    lengthCheck -= advertisementLayer->toPDUByteArray().length();
+    lengthCheck -= advertisementLayer->getSize();
     if (lengthCheck != static_cast<size_t>(nameAdvertisementLayer->getPDULength() + OTPNameAdvertisementLayer::LENGTHOFFSET))
         return false;
     if (!nameAdvertisementLayer->isValid()) return false;
@@ -122,12 +139,12 @@ QNetworkDatagram Message::toQNetworkDatagram(
 
 QByteArray Message::toByteArray()
 {
-    QByteArray ba;
-    ba.append(otpLayer->toPDUByteArray());
-    ba.append(advertisementLayer->toPDUByteArray());
+    PDUByteArray ba;
+    otpLayer->toPDUByteArray(ba);
+    advertisementLayer->toPDUByteArray(ba);
     ba.append(nameAdvertisementLayer->toPDUByteArray());
 
-    return ba;
+    return std::move(ba);
 }
 
 void Message::updatePduLength()
@@ -137,10 +154,10 @@ void Message::updatePduLength()
     nameAdvertisementLayer->setPDULength(length - OTPNameAdvertisementLayer::LENGTHOFFSET);
 
     /* 11.2 Length */
-    length += advertisementLayer->toPDUByteArray().size();
+    length += advertisementLayer->getSize();
     advertisementLayer->setPDULength(length - OTPAdvertisementLayer::LENGTHOFFSET);
 
     /* 6.3 Length */
-    length += otpLayer->toPDUByteArray().size();
+    length += otpLayer->getSize();
     otpLayer->setPDULength(length - OTPLayer::LENGTHOFFSET);
 }
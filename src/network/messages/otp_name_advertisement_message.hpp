@@ -27,6 +27,7 @@
 #include "message_types.hpp"
 #include "message_const.hpp"
 #include "../pdu/pdu.hpp"
+#include "../../packet.hpp"
 
 /**
  * @internal
@@ -74,6 +75,17 @@ public:
             QNetworkDatagram message,
             QObject *parent = nullptr);
 
+    /**
+     * @brief Construct a new Message from a received packet
+     * @details Used to dissect an on-the wire message, without copying the packet
+     * 
+     * @param packet Received packet
+     * @param parent Parent object
+     */
+    explicit Message(
+            const Packet &packet,
+            QObject *parent = nullptr);
+
     /**
      * @brief Is the message valid
      * 
@@ -165,6 +177,13 @@ public:
     std::shared_ptr<OTP::PDU::OTPNameAdvertisementLayer::Layer> getNameAdvertisementLayer() { return nameAdvertisementLayer; }
 
 private:
+    /**
+     * @brief Dissect an on-the wire message
+     * 
+     * @param message Raw message
+     */
+    void fromByteArray(const QByteArray &message);
+
     /**
      * @brief Update all PDU lengths to match the data contained
      * 
@@ -33,13 +33,13 @@ Message::Message(
     QObject(parent),
     otpLayer(
         new OTPLayer::Layer(
-            VECTOR_OTP_ADVERTISEMENT_MESSAGE, 0, CID, 0, 0, 0, ComponentName, this)),
+            VECTOR_OTP_ADVERTISEMENT_MESSAGE, 0, CID, 0, 0, 0, ComponentName)),
     advertisementLayer(
         new OTP::PDU::OTPAdvertisementLayer::Layer(
-            OTP::PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM, 0, this)),
+            OTP::PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM, 0)),
     systemAdvertisementLayer(
         new OTP::PDU::OTPSystemAdvertisementLayer::Layer(
-            0, OTP::PDU::OTPSystemAdvertisementLayer::options_t(), SystemList, this))
+            0, OTP::PDU::OTPSystemAdvertisementLayer::options_t(), SystemList))
 {
 
     OTP::PDU::OTPSystemAdvertisementLayer::options_t options;
@@ -59,21 +59,38 @@ Message::Message(
     otpLayer(new OTP::PDU::OTPLayer::Layer()),
     advertisementLayer(new OTP::PDU::OTPAdvertisementLayer::Layer()),
     systemAdvertisementLayer(new OTP::PDU::OTPSystemAdvertisementLayer::Layer())
+{
+    fromByteArray(message.data());
+}
+
+Message::Message(
+        const Packet &packet,
+        QObject *parent) :
+    QObject(parent),
+    otpLayer(new OTP::PDU::OTPLayer::Layer()),
+    advertisementLayer(new OTP::PDU::OTPAdvertisementLayer::Layer()),
+    systemAdvertisementLayer(new OTP::PDU::OTPSystemAdvertisementLayer::Layer())
+{
+    // Parse directly from the pooled buffer
+    fromByteArray(packet.toByteArray());
+}
+
+void Message::fromByteArray(const QByteArray &message)
 {
     int idx = 0;
 
     // OTP Layer
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx, otpLayer->toPDUByteArray().size())).size();
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx, OTPLayer::SIZE);
+        idx += layer.size();
         otpLayer->fromPDUByteArray(layer);
         if (!otpLayer->isValid()) return;
     }
 
     // Advertisment Layer
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx, advertisementLayer->toPDUByteArray().size())).size();
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx, OTPAdvertisementLayer::SIZE);
+        idx += layer.size();
         advertisementLayer->fromPDUByteArray(layer);
         if (!advertisementLayer->isValid()) return;
     }
@@ -81,8 +98,8 @@ Message::Message(
     // System Advertisment Layer
     if (advertisementLayer->getVector() == PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM)
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx)).size();
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx);
+        idx += layer.size();
         systemAdvertisementLayer->fromPDUByteArray(layer);
         if (!systemAdvertisementLayer->isValid()) return;
     }
@@ -95,13 +112,13 @@ bool Message::isValid()
         return false;
     if (!otpLayer->isValid()) return false;
 
-    lengthCheck -= otpLayer->toPDUByteArray().length();
+    lengthCheck -= otpLayer->getSize();
     if (lengthCheck != static_cast<size_t>(advertisementLayer->getPDULength() + OTPAdvertisementLayer::LENGTHOFFSET))
         return false;
     if (advertisementLayer->getVector() != PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM) return false;
     if (!advertisementLayer->isValid()) return false;
 
-    lengthCheck -= advertisementLayer->toPDUByteArray().length();
+    lengthCheck -= advertisementLayer->getSize();
     if (lengthCheck != static_cast<size_t>(systemAdvertisementLayer->getPDULength() + OTPSystemAdvertisementLayer::LENGTHOFFSET))
         return false;
     if (!systemAdvertisementLayer->isValid()) return false;
@@ -126,12 +143,12 @@ QByteArray Message::toByteArray()
 {
     updatePduLength();
 
-    QByteArray ba;
-    ba.append(otpLayer->toPDUByteArray());
-    ba.append(advertisementLayer->toPDUByteArray());
+    PDUByteArray ba;
+    otpLayer->toPDUByteArray(ba);
+    advertisementLayer->toPDUByteArray(ba);
     ba.append(systemAdvertisementLayer->toPDUByteArray());
 
-    return ba;
+    return std::move(ba);
 }
 
 void Message::updatePduLength()
@@ -141,10 +158,10 @@ void Message::updatePduLength()
     systemAdvertisementLayer->setPDULength(length - OTPSystemAdvertisementLayer::LENGTHOFFSET);
 
     /* 11.2 Length */
-    length += advertisementLayer->toPDUByteArray().size();
+    length += advertisementLayer->getSize();
     advertisementLayer->setPDULength(length - OTPAdvertisementLayer::LENGTHOFFSET);
 
     /* 6.3 Length */
-    length += otpLayer->toPDUByteArray().size();
+    length += otpLayer->getSize();
     otpLayer->setPDULength(length - OTPLayer::LENGTHOFFSET);
 }
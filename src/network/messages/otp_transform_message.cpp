@@ -20,6 +20,8 @@
  *
  */
 #include "otp_transform_message.hpp"
+#include <QDebug>
+#include <algorithm>
 
 using namespace OTP::PDU;
 using namespace OTP::MESSAGES::OTPTransformMessage;
@@ -31,11 +33,9 @@ Message::Message(OTP::cid_t CID,
         QObject *parent) :
     QObject(parent),
     otpLayer(
-        new OTPLayer::Layer(
-            VECTOR_OTP_TRANSFORM_MESSAGE, 0, CID, 0, 0, 0, ComponentName, this)),
+        VECTOR_OTP_TRANSFORM_MESSAGE, 0, CID, 0, 0, 0, ComponentName),
     transformLayer(
-        new OTPTransformLayer::Layer(
-            0, System, static_cast<timestamp_t>(QDateTime::currentMSecsSinceEpoch() * 1000), OTPTransformLayer::options_t(FullPointSet), this))
+        0, System, static_cast<timestamp_t>(QDateTime::currentMSecsSinceEpoch() * 1000), OTPTransformLayer::options_t(FullPointSet))
 {
     updatePduLength();
 }
@@ -43,84 +43,91 @@ Message::Message(OTP::cid_t CID,
 Message::Message(
         QNetworkDatagram message,
         QObject *parent) :
-    QObject(parent),
-    otpLayer(new OTP::PDU::OTPLayer::Layer()),
-    transformLayer(new OTP::PDU::OTPTransformLayer::Layer())
+    QObject(parent)
+{
+    fromByteArray(message.data());
+}
+
+Message::Message(
+        const Packet &packet,
+        QObject *parent) :
+    QObject(parent)
+{
+    // Parse directly from the pooled buffer
+    fromByteArray(packet.toByteArray());
+}
+
+void Message::fromByteArray(const QByteArray &message)
 {
     int idx = 0;
     // OTP Layer
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx, otpLayer->toPDUByteArray().size())).size();
-        otpLayer->fromPDUByteArray(layer);
-        if (!otpLayer->isValid()) return;
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx, OTPLayer::SIZE);
+        idx += layer.size();
+        otpLayer.fromPDUByteArray(layer);
+        if (!otpLayer.isValid()) return;
     }
 
     // Transform Layer
     {
-        PDU::PDUByteArray layer;
-        idx += layer.append(message.data().mid(idx, transformLayer->toPDUByteArray().size())).size();
-        transformLayer->fromPDUByteArray(layer);
-        if (!transformLayer->isValid()) return;
+        auto layer = PDU::PDUByteArray::fromRawData(message, idx, OTPTransformLayer::SIZE);
+        idx += layer.size();
+        transformLayer.fromPDUByteArray(layer);
+        if (!transformLayer.isValid()) return;
     }
 
     // Point PDU
-    while (idx < message.data().size()) {
+    while (idx < message.size()) {
         // Point Layer
-        auto pointLayer = std::make_shared<OTP::PDU::OTPPointLayer::Layer>();
+        auto &point = points.emplace_back();
         {
-            PDU::PDUByteArray layer;
-            idx += layer.append(message.data().mid(idx, pointLayer->toPDUByteArray().size())).size();
-            pointLayer->fromPDUByteArray(layer);
-            if (!pointLayer->isValid()) return;
-
-            address_t address = {transformLayer->getSystem(), pointLayer->getGroup(), pointLayer->getPoint()};
-            pointLayers.insert(address, pointLayer);
+            auto layer = PDU::PDUByteArray::fromRawData(message, idx, OTPPointLayer::SIZE);
+            idx += layer.size();
+            point.pointLayer.fromPDUByteArray(layer);
+            if (!point.pointLayer.isValid()) return;
         }
 
         // Module Layer
-        int pduRemaining = (pointLayer->getPDULength() + OTPPointLayer::LENGTHOFFSET) - pointLayer->toPDUByteArray().size();
-        while (pduRemaining) {
-            address_t address = {transformLayer->getSystem(), pointLayer->getGroup(), pointLayer->getPoint()};
-            auto moduleLayer = std::make_shared<OTP::PDU::OTPModuleLayer::Layer>();
-            {
-                PDU::PDUByteArray layer;
-                // Obtain, reported, layer size
-                layer.append(message.data().mid(idx, pduRemaining));
-                auto layerSize =
-                        static_cast<int>(OTP::PDU::OTPModuleLayer::Layer::getPDULength(layer) + OTPModuleLayer::LENGTHOFFSET);
-
-                // Get layer
-                layer.clear();
-                idx += layer.append(message.data().mid(idx, layerSize)).size();
-                moduleLayer->fromPDUByteArray(layer);
-                if (!moduleLayer->isValid()) return;
-
-                pduRemaining -= moduleLayer->toPDUByteArray().size();
-            }
-            moduleLayers.insert(address, moduleLayer);
+        int pduRemaining = (point.pointLayer.getPDULength() + OTPPointLayer::LENGTHOFFSET) - OTPPointLayer::SIZE;
+        while (pduRemaining > 0) {
+            point.moduleLayers.append(OTPModuleLayer::Layer());
+            auto &moduleLayer = point.moduleLayers.last();
+
+            // Obtain, reported, layer size
+            auto layerSize =
+                    static_cast<int>(OTP::PDU::OTPModuleLayer::Layer::getPDULength(
+                        PDU::PDUByteArray::fromRawData(message, idx, pduRemaining)) + OTPModuleLayer::LENGTHOFFSET);
+
+            // Get layer
+            auto layer = PDU::PDUByteArray::fromRawData(message, idx, layerSize);
+            idx += layer.size();
+            moduleLayer.fromPDUByteArray(layer);
+            if (!moduleLayer.isValid()) return;
+
+            pduRemaining -= moduleLayer.getSize();
         }
     }
 }
 
 bool Message::isValid() const
 {
-    size_t lengthCheck = toByteArray().length();
-    if (lengthCheck != static_cast<size_t>(otpLayer->getPDULength() + OTPLayer::LENGTHOFFSET))
+    size_t lengthCheck = getSize();
+    if (lengthCheck != static_cast<size_t>(otpLayer.getPDULength() + OTPLayer::LENGTHOFFSET))
         return false;
-    if (!otpLayer->isValid()) return false;
+    if (!otpLayer.isValid()) return false;
 
-    lengthCheck -= otpLayer->toPDUByteArray().length();
-    if (lengthCheck != static_cast<size_t>(transformLayer->getPDULength() + OTPTransformLayer::LENGTHOFFSET))
+    lengthCheck -= otpLayer.getSize();
+    if (lengthCheck != static_cast<size_t>(transformLayer.getPDULength() + OTPTransformLayer::LENGTHOFFSET))
         return false;
-    if (!transformLayer->isValid()) return false;
+    if (!transformLayer.isValid()) return false;
 
-    for (const auto &pointLayer : pointLayers)
-        if (!pointLayer->isValid()) return false;
-
-    for (const auto &moduleLayer : moduleLayers)
-        if (!moduleLayer->isValid()) return false;
-    if (!RANGES::MESSAGE_SIZE.isValid(toByteArray().size() - otpLayer->getFooter().getLength()))
+    for (const auto &point : points)
+    {
+        if (!point.pointLayer.isValid()) return false;
+        for (const auto &moduleLayer : point.moduleLayers)
+            if (!moduleLayer.isValid()) return false;
+    }
+    if (!RANGES::MESSAGE_SIZE.isValid(getSize() - otpLayer.getFooter().getLength()))
         return false;
     return true;
 }
@@ -131,99 +138,228 @@ QNetworkDatagram Message::toQNetworkDatagram(
         page_t thisPage,
         page_t lastPage)
 {
-    otpLayer->setFolio(folio);
-    otpLayer->setPage(thisPage);
-    otpLayer->setLastPage(lastPage);
+    otpLayer.setFolio(folio);
+    otpLayer.setPage(thisPage);
+    otpLayer.setLastPage(lastPage);
     updatePduLength();
     return QNetworkDatagram(toByteArray(), destAddr, OTP_PORT);
 }
 
 Message::addModule_ret Message::addModule(addModule_t &moduleData)
 {
-    if (moduleData.address.system != transformLayer->getSystem()) return InvalidSystem;
+    if (moduleData.address.system != transformLayer.getSystem()) return InvalidSystem;
     if (moduleData.additional.isEmpty()) return InvalidAdditional;
     if (moduleData.sampleTime == 0) return InvalidTimestamp;
 
-    if (!pointLayers.contains(moduleData.address))
+    /* Index any points not added by addModule(), such as those from fromByteArray() */
+    for (; indexedPoints < points.size(); indexedPoints++)
+    {
+        const auto &layer = points[indexedPoints].pointLayer;
+        pointIndex.insert(pointKey(layer.getGroup(), layer.getPoint()), indexedPoints);
+    }
+
+    const auto key = pointKey(moduleData.address.group, moduleData.address.point);
+    const auto existing = pointIndex.constFind(key);
+
+    /* Size of this module, plus its point layer if not already present */
+    const bool newPoint = (existing == pointIndex.constEnd());
+    const pduLength_t moduleSize = static_cast<pduLength_t>(OTPModuleLayer::SIZE + moduleData.additional.size());
+    const pduLength_t requiredSize = static_cast<pduLength_t>(moduleSize + (newPoint ? OTPPointLayer::SIZE : 0));
+    if (requiredSize > getAvailableSize())
+        return MessageToBig;
+
+    if (newPoint)
+    {
+        points.push_back({OTPPointLayer::Layer(
+                OTPPointLayer::SIZE - OTPPointLayer::LENGTHOFFSET,
+                moduleData.priority, moduleData.address.group, moduleData.address.point, moduleData.sampleTime), {}});
+        pointIndex.insert(key, points.size() - 1);
+        indexedPoints = points.size();
+    }
+    auto &point = newPoint ? points.back() : points[existing.value()];
+    if (!newPoint)
     {
-        auto pointLayer = std::make_shared<OTP::PDU::OTPPointLayer::Layer>
-                (0, moduleData.priority, moduleData.address.group, moduleData.address.point, moduleData.sampleTime, this);
-        if ((pointLayer->toPDUByteArray().size() + this->toByteArray().size()) > RANGES::MESSAGE_SIZE.getMax())
-            return MessageToBig;
-        pointLayers.insert(moduleData.address, pointLayer);
-    } else {
         /**
          * @todo Seperate modules with differing sample times into different point layers
          */
-        if (moduleData.sampleTime > pointLayers.value(moduleData.address)->getTimestamp())
-            pointLayers.value(moduleData.address)->setTimestamp(moduleData.sampleTime);
+        if (moduleData.sampleTime > point.pointLayer.getTimestamp())
+            point.pointLayer.setTimestamp(moduleData.sampleTime);
     }
 
-    auto moduleLayer = std::make_shared<OTP::PDU::OTPModuleLayer::Layer>(moduleData.ident.ManufacturerID, 0, moduleData.ident.ModuleNumber);
-    moduleLayer->setAdditional(moduleData.additional);
+    point.moduleLayers.append(OTPModuleLayer::Layer(
+                moduleData.ident.ManufacturerID, moduleSize - OTPModuleLayer::LENGTHOFFSET, moduleData.ident.ModuleNumber));
+    point.moduleLayers.last().setAdditional(moduleData.additional);
 
-    if ((moduleLayer->toPDUByteArray().size() + this->toByteArray().size()) > RANGES::MESSAGE_SIZE.getMax())
-        return MessageToBig;
-    moduleLayers.insert(moduleData.address, moduleLayer);
-
-    updatePduLength();
+    /* 9.2, 8.2, and 6.3 Length, updated in place rather than recalculating the whole message */
+    point.pointLayer.setPDULength(point.pointLayer.getPDULength() + moduleSize);
+    transformLayer.setPDULength(transformLayer.getPDULength() + requiredSize);
+    otpLayer.setPDULength(otpLayer.getPDULength() + requiredSize);
 
     return OK;
 }
 
-QByteArray Message::toByteArray() const
+OTP::PDU::PDUByteArray Message::packPoint(const QVector<addModule_t> &modules)
+{
+    PDUByteArray ret;
+    if (modules.isEmpty()) return ret;
+    const auto &address = modules.first().address;
+
+    /* 9.2 Length, and point sample time */
+    pduLength_t modulesLength = 0;
+    timestamp_t sampleTime = 0;
+    for (const auto &moduleData : modules)
+    {
+        if (moduleData.additional.isEmpty() || (moduleData.sampleTime == 0)) continue;
+        modulesLength += OTPModuleLayer::SIZE + moduleData.additional.size();
+        sampleTime = std::max(sampleTime, moduleData.sampleTime);
+    }
+    if (!modulesLength) return ret;
+
+    ret.reserve(OTPPointLayer::SIZE + modulesLength);
+    OTPPointLayer::Layer(
+                OTPPointLayer::SIZE - OTPPointLayer::LENGTHOFFSET + modulesLength,
+                modules.first().priority, address.group, address.point, sampleTime).toPDUByteArray(ret);
+
+    for (const auto &moduleData : modules)
+    {
+        if (moduleData.additional.isEmpty() || (moduleData.sampleTime == 0)) continue;
+
+        /* 10.2 Length */
+        OTPModuleLayer::Layer moduleLayer(
+                    moduleData.ident.ManufacturerID,
+                    OTPModuleLayer::SIZE - OTPModuleLayer::LENGTHOFFSET + moduleData.additional.size(),
+                    moduleData.ident.ModuleNumber);
+        moduleLayer.setAdditional(moduleData.additional);
+        moduleLayer.toPDUByteArray(ret);
+    }
+
+    return ret;
+}
+
+QList<QByteArray> Message::packFolio(
+        cid_t CID,
+        name_t ComponentName,
+        system_t System,
+        bool FullPointSet,
+        folio_t folio,
+        const QVector<QByteArray> &points)
 {
-    QByteArray ba;
-    ba.append(otpLayer->toPDUByteArray());
-    ba.append(transformLayer->toPDUByteArray());
-    for (const auto &pointLayer : pointLayers)
+    const int headerSize = OTPLayer::SIZE + OTPTransformLayer::SIZE;
+    const int pageCapacity = static_cast<int>(RANGES::MESSAGE_SIZE.getMax()) - headerSize;
+
+    // Split points into pages
+    QVector<std::pair<int, int>> pages; // First point index, and length of points
+    for (int idx = 0; idx < points.count(); idx++)
     {
-        ba.append(pointLayer->toPDUByteArray());
-        address_t address = {transformLayer->getSystem(), pointLayer->getGroup(), pointLayer->getPoint()};
-        auto iterator = moduleLayers.find(address);
-        while (iterator != moduleLayers.end() && iterator.key() == address)
+        const int pointSize = points.at(idx).size();
+        if (pointSize > pageCapacity)
+        {
+            qDebug() << "OTP Transform - Point too big for message, skipped";
+            continue;
+        }
+        if (pages.isEmpty() || ((pages.back().second + pointSize) > pageCapacity))
+            pages.append({idx, 0});
+        pages.back().second += pointSize;
+    }
+    if (pages.isEmpty()) return QList<QByteArray>();
+
+    // Pack pages
+    QList<QByteArray> ret;
+    const auto timestamp = static_cast<timestamp_t>(QDateTime::currentMSecsSinceEpoch() * 1000);
+    const page_t lastPage = static_cast<page_t>(pages.count() - 1);
+    for (page_t page = 0; page <= lastPage; page++)
+    {
+        const int pointsSize = pages.at(page).second;
+        PDUByteArray ba;
+        ba.reserve(headerSize + pointsSize);
+
+        /* 6.3 Length */
+        OTPLayer::Layer(
+                    VECTOR_OTP_TRANSFORM_MESSAGE,
+                    static_cast<pduLength_t>(headerSize + pointsSize - OTPLayer::LENGTHOFFSET),
+                    CID, folio, page, lastPage, ComponentName).toPDUByteArray(ba);
+
+        /* 8.2 Length */
+        OTPTransformLayer::Layer(
+                    static_cast<pduLength_t>(OTPTransformLayer::SIZE + pointsSize - OTPTransformLayer::LENGTHOFFSET),
+                    System, timestamp, OTPTransformLayer::options_t(FullPointSet)).toPDUByteArray(ba);
+
+        // Copy point runs
+        const int first = pages.at(page).first;
+        const int end = (page < lastPage) ? pages.at(page + 1).first : points.count();
+        for (int idx = first; idx < end; idx++)
         {
-            ba.append(iterator.value()->toPDUByteArray());
-            ++iterator;
+            if (points.at(idx).size() <= pageCapacity)
+                ba.append(points.at(idx));
         }
+
+        ret.append(std::move(ba));
     }
 
-    return ba;
+    return ret;
+}
+
+int Message::getAvailableSize() const
+{
+    /* OTP Layer length covers the complete message, less the fields preceding it */
+    return static_cast<int>(RANGES::MESSAGE_SIZE.getMax())
+            - (otpLayer.getPDULength() + OTPLayer::LENGTHOFFSET);
+}
+
+QByteArray Message::toByteArray() const
+{
+    PDUByteArray ba;
+    ba.reserve(getSize());
+    otpLayer.toPDUByteArray(ba);
+    transformLayer.toPDUByteArray(ba);
+    for (const auto &point : points)
+    {
+        point.pointLayer.toPDUByteArray(ba);
+        for (const auto &moduleLayer : point.moduleLayers)
+            moduleLayer.toPDUByteArray(ba);
+    }
+
+    return std::move(ba);
+}
+
+int Message::getSize() const
+{
+    int size = otpLayer.getSize() + transformLayer.getSize();
+    size += static_cast<int>(points.size()) * OTPPointLayer::SIZE;
+    for (const auto &point : points)
+        for (const auto &moduleLayer : point.moduleLayers)
+            size += moduleLayer.getSize();
+
+    return size;
 }
 
 void Message::updatePduLength()
 {
     pduLength_t length = 0;
 
-    for (const auto &pointLayer : qAsConst(pointLayers))
+    for (auto &point : points)
     {
         pduLength_t modulesLength = 0;
-        address_t address = {transformLayer->getSystem(), pointLayer->getGroup(), pointLayer->getPoint()};
-        auto iterator = moduleLayers.find(address);
-        while (iterator != moduleLayers.end() && iterator.key() == address)
+        for (auto &moduleLayer : point.moduleLayers)
         {
-            auto moduleLayer = iterator.value();
-
             /* 10.2 Length */
-            modulesLength += moduleLayer->toPDUByteArray().size();
-            moduleLayer->setPDULength(
-                        moduleLayer->toPDUByteArray().size() - OTPModuleLayer::LENGTHOFFSET);
-
-            ++iterator;
+            const auto moduleSize = moduleLayer.getSize();
+            modulesLength += moduleSize;
+            moduleLayer.setPDULength(moduleSize - OTPModuleLayer::LENGTHOFFSET);
         }
 
         /* 9.2 Length */
-        length += pointLayer->toPDUByteArray().size() + modulesLength;
-        pointLayer->setPDULength(
-                    (pointLayer->toPDUByteArray().size() - OTPPointLayer::LENGTHOFFSET)
+        length += point.pointLayer.getSize() + modulesLength;
+        point.pointLayer.setPDULength(
+                    (point.pointLayer.getSize() - OTPPointLayer::LENGTHOFFSET)
                     + modulesLength);
     }
 
     /* 8.2 Length */
-    length += transformLayer->toPDUByteArray().size();
-    transformLayer->setPDULength(length - OTPTransformLayer::LENGTHOFFSET);
+    length += transformLayer.getSize();
+    transformLayer.setPDULength(length - OTPTransformLayer::LENGTHOFFSET);
 
     /* 6.3 Length */
-    length += otpLayer->toPDUByteArray().size();
-    otpLayer->setPDULength(length - OTPLayer::LENGTHOFFSET);
+    length += otpLayer.getSize();
+    otpLayer.setPDULength(length - OTPLayer::LENGTHOFFSET);
 }
@@ -24,9 +24,13 @@
 
 #include <QObject>
 #include <QNetworkDatagram>
+#include <QHash>
+#include <QVarLengthArray>
+#include <vector>
 #include "message_types.hpp"
 #include "message_const.hpp"
 #include "../pdu/pdu.hpp"
+#include "../../packet.hpp"
 
 /**
  * @internal
@@ -38,6 +42,18 @@
 namespace OTP::MESSAGES::OTPTransformMessage
 {
 
+/**
+ * @internal
+ * @brief Point PDU
+ * @details A Point Layer, followed by the Module Layers it contains
+ * 
+ */
+typedef struct pointPDU_t {
+    static constexpr int PREALLOC_MODULES = 6; /**< Module Layers stored inline, enough for every ESTA standard module */
+    OTP::PDU::OTPPointLayer::Layer pointLayer; /**< Point Layer */
+    QVarLengthArray<OTP::PDU::OTPModuleLayer::Layer, PREALLOC_MODULES> moduleLayers; /**< Module Layers */
+} pointPDU_t;
+
 /**
  * @internal
  * @brief Transform Message
@@ -74,6 +90,17 @@ public:
             QNetworkDatagram message,
             QObject *parent = nullptr);
 
+    /**
+     * @brief Construct a new Message from a received packet
+     * @details Used to dissect an on-the wire message, without copying the packet
+     * 
+     * @param packet Received packet
+     * @param parent Parent object
+     */
+    explicit Message(
+            const Packet &packet,
+            QObject *parent = nullptr);
+
     /**
      * @brief Is the message valid
      * 
@@ -115,20 +142,33 @@ public:
             page_t lastPage)
     {
         QList<QNetworkDatagram> ret;
-        if ((transport == QAbstractSocket::IPv4Protocol) || (transport == QAbstractSocket::AnyIPProtocol))
+        for (const auto &destAddr : getMulticastAddresses(transport, transformLayer.getSystem()))
             ret.append(toQNetworkDatagram(
-                            QHostAddress(OTP_Transform_Message_IPv4.toIPv4Address()
-                                         + transformLayer->getSystem()),
+                            destAddr,
                             folio,
                             thisPage,
                             lastPage));
+        return ret;
+    }
+
+    /**
+     * @brief Get multicast destination addresses for a system
+     * 
+     * @param transport IPv4 or IPv6
+     * @param system System number
+     * @return Multicast addresses
+     */
+    static QList<QHostAddress> getMulticastAddresses(
+            QAbstractSocket::NetworkLayerProtocol transport,
+            system_t system)
+    {
+        QList<QHostAddress> ret;
+        if ((transport == QAbstractSocket::IPv4Protocol) || (transport == QAbstractSocket::AnyIPProtocol))
+            ret.append(QHostAddress(OTP_Transform_Message_IPv4.toIPv4Address()
+                                    + system));
         if ((transport == QAbstractSocket::IPv6Protocol) || (transport == QAbstractSocket::AnyIPProtocol))
-            ret.append(toQNetworkDatagram(
-                            QHostAddress(OTP_Transform_Message_IPv6.toIPv6Address()
-                                        + transformLayer->getSystem()),
-                            folio,
-                            thisPage,
-                            lastPage));
+            ret.append(QHostAddress(OTP_Transform_Message_IPv6.toIPv6Address()
+                                    + system));
         return ret;
     }
 
@@ -165,35 +205,73 @@ public:
      */
     addModule_ret addModule(addModule_t &moduleData);
 
+    /**
+     * @brief Pack a point, and its modules, ready to be placed in a message
+     * @details Modules that addModule() would reject are omitted
+     * 
+     * @param modules Modules for a single point address
+     * @return Packed Point Layer followed by its Module Layers, or empty if there are no valid modules
+     */
+    static PDUByteArray packPoint(const QVector<addModule_t> &modules);
+
+    /**
+     * @brief Pack a folio of messages from packed points
+     * @details Each point is copied in to a page as a single run, and is never split across pages.
+     * Only the OTP and Transform Layers are packed per page.
+     * 
+     * @param CID Component IDentifer
+     * @param ComponentName Component Name
+     * @param System System number
+     * @param FullPointSet Flag as containing A Full Point Set Point for a the System
+     * @param folio Folio Number
+     * @param points Points packed by packPoint()
+     * @return Packed pages, as transmitted "on-the-wire"
+     */
+    static QList<QByteArray> packFolio(
+            cid_t CID,
+            name_t ComponentName,
+            system_t System,
+            bool FullPointSet,
+            folio_t folio,
+            const QVector<QByteArray> &points);
+
+    /**
+     * @brief Get space remaining in message
+     * @details Tracked as modules are added, without packing the message
+     *
+     * @return Octets available before the message reaches its maximum size
+     */
+    int getAvailableSize() const;
+
     /**
      * @brief Get only the OTP Layer of the Message
      * 
      * @return OTP Layer
      */
-    std::shared_ptr<OTP::PDU::OTPLayer::Layer> getOTPLayer() { return otpLayer; }
+    const OTP::PDU::OTPLayer::Layer &getOTPLayer() const { return otpLayer; }
 
     /**
      * @brief Get only the OTP Transform Layer of the Message
      * 
      * @return OTP Transform Layer
      */
-    std::shared_ptr<OTP::PDU::OTPTransformLayer::Layer> getTransformLayer() { return transformLayer; }
+    const OTP::PDU::OTPTransformLayer::Layer &getTransformLayer() const { return transformLayer; }
 
     /**
-     * @brief Get the OTP Point Layers of the Message
+     * @brief Get the Point PDUs of the Message
      * 
-     * @return OTP Point Layers
+     * @return Point PDUs, in the order they appear in the message
      */
-    QMap<address_t, std::shared_ptr<OTP::PDU::OTPPointLayer::Layer>> getPointLayers() { return pointLayers; }
+    const std::vector<pointPDU_t> &getPoints() const { return points; }
 
+private:
     /**
-     * @brief Get the OTP Module Layers of the Message
+     * @brief Dissect an on-the wire message
      * 
-     * @return OTP Module Layers indexed by point address
+     * @param message Raw message
      */
-    QMultiMap<address_t, std::shared_ptr<OTP::PDU::OTPModuleLayer::Layer>> getModuleLayers() { return moduleLayers; }
+    void fromByteArray(const QByteArray &message);
 
-private:
     /**
      * @brief Update all PDU lengths to match the data contained
      * 
@@ -208,10 +286,28 @@ private:
      */
     QByteArray toByteArray() const;
 
-    std::shared_ptr<OTP::PDU::OTPLayer::Layer> otpLayer;
-    std::shared_ptr<OTP::PDU::OTPTransformLayer::Layer> transformLayer;
-    QMap<address_t, std::shared_ptr<OTP::PDU::OTPPointLayer::Layer>> pointLayers;
-    QMultiMap<address_t, std::shared_ptr<OTP::PDU::OTPModuleLayer::Layer>> moduleLayers;
+    /**
+     * @brief Get packed size of the message
+     * @details Calculated from the layers, without packing
+     *
+     * @return Size in octets
+     */
+    int getSize() const;
+
+    OTP::PDU::OTPLayer::Layer otpLayer;
+    OTP::PDU::OTPTransformLayer::Layer transformLayer;
+    std::vector<pointPDU_t> points;
+
+    /**
+     * @brief Index into points, by group and point number
+     * @details So addModule() finds a point's existing layer without searching every point.
+     * Built on demand by addModule(), leaving fromByteArray() to allocate only the points themselves
+     */
+    QHash<quint64, size_t> pointIndex;
+    size_t indexedPoints = 0; /*!< Number of leading points in pointIndex */
+    static quint64 pointKey(group_t group, point_t point) {
+        return (static_cast<quint64>(group) << 32) | static_cast<quint32>(point);
+    }
 };
 
 } // namespace
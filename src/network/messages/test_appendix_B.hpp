@@ -148,6 +148,53 @@ namespace TEST_OTP::MESSAGES::APPENDIX_B {
         /* Reserved */ 0x00,0x00,0x00,0x00,
     };
 
+    // Point PDU omitted from Table B-1, sized to fill its Transform Layer length
+    const unsigned char ExampleB_1_Point_Data[] = {
+        /* OTP Point Layer */
+        /* Vector */ 0x00,0x01, // VECTOR_OTP_MODULE
+        /* Length */ 0x00,0x64, // 100
+        /* Priority */ 0x64, // 100
+        /* Group */ 0x00,0x01,
+        /* Point */ 0x00,0x00,0x00,0x01,
+        /* Timestamp */ 0x00,0x00,0x00,0x00,0xD6,0x93,0xA4,0x00, // 3,600,000,000 μs
+        /* Options */ 0x00,
+        /* Reserved */ 0x00,0x00,0x00,0x00,
+        /* OTP Module Layer - Position */
+        /* Manufacturer ID */ 0x00,0x00, // ESTA
+        /* Length */ 0x00,0x0F, // 15
+        /* Module Number */ 0x00,0x01,
+        /* Options */ 0x80, // mm
+        /* X */ 0x00,0x00,0x03,0xE8, // 1000
+        /* Y */ 0x00,0x00,0x07,0xD0, // 2000
+        /* Z */ 0xFF,0xFF,0xFC,0x18, // -1000
+        /* OTP Module Layer - Position Velocity/Acceleration */
+        /* Manufacturer ID */ 0x00,0x00, // ESTA
+        /* Length */ 0x00,0x1A, // 26
+        /* Module Number */ 0x00,0x02,
+        /* X Velocity */ 0x00,0x00,0x00,0x0A,
+        /* Y Velocity */ 0x00,0x00,0x00,0x00,
+        /* Z Velocity */ 0x00,0x00,0x00,0x00,
+        /* X Acceleration */ 0x00,0x00,0x00,0x01,
+        /* Y Acceleration */ 0x00,0x00,0x00,0x00,
+        /* Z Acceleration */ 0x00,0x00,0x00,0x00,
+        /* OTP Module Layer - Rotation */
+        /* Manufacturer ID */ 0x00,0x00, // ESTA
+        /* Length */ 0x00,0x0E, // 14
+        /* Module Number */ 0x00,0x03,
+        /* X */ 0x00,0x00,0x00,0x00,
+        /* Y */ 0x00,0x00,0x00,0x00,
+        /* Z */ 0x05,0x5D,0x4A,0x80, // 90,000,000 μdeg
+        /* OTP Module Layer - Reference Frame */
+        /* Manufacturer ID */ 0x00,0x00, // ESTA
+        /* Length */ 0x00,0x09, // 9
+        /* Module Number */ 0x00,0x06,
+        /* System */ 0x01,
+        /* Group */ 0x00,0x01,
+        /* Point */ 0x00,0x00,0x00,0x02,
+    };
+    inline const QByteArray ExampleB_1_Point =
+            QByteArray::fromRawData(reinterpret_cast<const char*>(ExampleB_1_Point_Data), sizeof(ExampleB_1_Point_Data));
+
     // Table B-2: System Advertisement Message Consumer Example
     const unsigned char ExampleB_2[] = {
         /* OTP Packet Identifier */ 0x4f,0x54,0x50,0x2d,0x45,0x31,0x2e,0x35,0x39,0x00,0x00,0x00,
@@ -0,0 +1,223 @@
+#include "test_otp_transform_message.hpp"
+#include "network/messages/test_appendix_B.hpp"
+#include "network/modules/modules.hpp"
+#include <QtEndian>
+
+using namespace OTP::MESSAGES::OTPTransformMessage;
+
+namespace
+{
+    const OTP::system_t System = 1;
+
+    Message::addModule_t module(OTP::group_t group, OTP::point_t point, OTP::MODULES::moduleNumber_t number)
+    {
+        OTP::MODULES::STANDARD::additional_t additional;
+        switch (number)
+        {
+            case OTP::MODULES::STANDARD::POSITION:
+                additional << OTP::MODULES::STANDARD::PositionModule_t();
+                break;
+            case OTP::MODULES::STANDARD::ROTATION:
+                additional << OTP::MODULES::STANDARD::RotationModule_t();
+                break;
+        }
+        return {100, OTP::address_t(System, group, point), 1, {OTP::ESTA_MANUFACTURER_ID, number}, additional};
+    }
+
+    QByteArray pack(Message &message)
+    {
+        return message.toQNetworkDatagram(QHostAddress::LocalHost, 1, 0, 0).data();
+    }
+
+    /* Split a packed Point PDU back in to the modules that built it */
+    QVector<Message::addModule_t> unpackPoint(const QByteArray &point, OTP::system_t system)
+    {
+        const auto data = reinterpret_cast<const uchar*>(point.constData());
+        const OTP::address_t address(system,
+                    qFromBigEndian<quint16>(data + 5),
+                    qFromBigEndian<quint32>(data + 7));
+        const OTP::priority_t priority = static_cast<quint8>(point.at(4));
+        const auto timestamp = qFromBigEndian<quint64>(data + 11);
+
+        QVector<Message::addModule_t> ret;
+        for (int idx = OTP::PDU::OTPPointLayer::SIZE; idx < point.size();)
+        {
+            const auto manufacturer = qFromBigEndian<quint16>(data + idx);
+            const auto length = qFromBigEndian<quint16>(data + idx + 2);
+            const auto number = qFromBigEndian<quint16>(data + idx + 4);
+            ret.append({priority, address, timestamp, {manufacturer, number},
+                        point.mid(idx + OTP::PDU::OTPModuleLayer::SIZE, length - sizeof(number))});
+            idx += OTP::PDU::OTPModuleLayer::LENGTHOFFSET + length;
+        }
+        return ret;
+    }
+
+    /* Octet offsets of fields that depend on the folio, or on when the message was packed */
+    const int PageOffset = 38; // Page and Last Page
+    const int TransformTimestampOffset = OTP::PDU::OTPLayer::SIZE + 5;
+
+    QByteArray withTimestamp(QByteArray message, const QByteArray &from)
+    {
+        message.replace(TransformTimestampOffset, sizeof(quint64), from.mid(TransformTimestampOffset, sizeof(quint64)));
+        return message;
+    }
+}
+
+int test_otp_transform_message(int argc, char *argv[])
+{
+    TEST_OTP::MESSAGES::OTPTransformMessage testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::MESSAGES::OTPTransformMessage::addModule()
+{
+    Message message(QUuid::createUuid(), QByteArray("Test"), System, true);
+    auto position1 = module(1, 1, OTP::MODULES::STANDARD::POSITION);
+    auto position2 = module(1, 2, OTP::MODULES::STANDARD::POSITION);
+    auto rotation1 = module(1, 1, OTP::MODULES::STANDARD::ROTATION);
+    QCOMPARE(message.addModule(position1), Message::OK);
+    QCOMPARE(message.addModule(position2), Message::OK);
+
+    // Modules for an earlier point join its existing Point Layer
+    QCOMPARE(message.addModule(rotation1), Message::OK);
+    QCOMPARE(static_cast<int>(message.getPoints().size()), 2);
+    QCOMPARE(static_cast<int>(message.getPoints().front().moduleLayers.size()), 2);
+    QCOMPARE(static_cast<int>(message.getPoints().back().moduleLayers.size()), 1);
+
+    // Lengths tracked in place match the packed message
+    const auto packed = pack(message);
+    QCOMPARE(static_cast<int>(packed.size()), static_cast<int>(OTP::MESSAGES::OTPTransformMessage::RANGES::MESSAGE_SIZE.getMax()) - message.getAvailableSize());
+    Message dissected{QNetworkDatagram(packed)};
+    QVERIFY(dissected.isValid());
+    QCOMPARE(static_cast<int>(dissected.getPoints().size()), 2);
+    QCOMPARE(static_cast<int>(dissected.getPoints().front().moduleLayers.size()), 2);
+
+    // Rejected
+    auto wrongSystem = position1;
+    wrongSystem.address.system = 2;
+    QCOMPARE(message.addModule(wrongSystem), Message::InvalidSystem);
+    auto noTimestamp = position1;
+    noTimestamp.sampleTime = 0;
+    QCOMPARE(message.addModule(noTimestamp), Message::InvalidTimestamp);
+}
+
+void TEST_OTP::MESSAGES::OTPTransformMessage::addModuleKeepsPointOnOnePage()
+{
+    Message message(QUuid::createUuid(), QByteArray("Test"), System, true);
+
+    // Fill with new points, until the next Point Layer and its module no longer fit
+    OTP::point_t point = 1;
+    while (true)
+    {
+        auto position = module(1, point, OTP::MODULES::STANDARD::POSITION);
+        if (message.addModule(position) != Message::OK) break;
+        point++;
+    }
+    const int points = static_cast<int>(message.getPoints().size());
+    QCOMPARE(points, static_cast<int>(point) - 1);
+
+    // A module alone may still fit, it only joins a point already on this page
+    const int moduleSize = OTP::PDU::OTPModuleLayer::SIZE + module(1, 1, OTP::MODULES::STANDARD::ROTATION).additional.size();
+    QVERIFY(message.getAvailableSize() >= moduleSize);
+    QVERIFY(message.getAvailableSize() < moduleSize + OTP::PDU::OTPPointLayer::SIZE);
+    auto newPoint = module(1, point, OTP::MODULES::STANDARD::ROTATION);
+    QCOMPARE(message.addModule(newPoint), Message::MessageToBig);
+    auto firstPoint = module(1, 1, OTP::MODULES::STANDARD::ROTATION);
+    QCOMPARE(message.addModule(firstPoint), Message::OK);
+    QCOMPARE(static_cast<int>(message.getPoints().size()), points);
+    QCOMPARE(static_cast<int>(message.getPoints().front().moduleLayers.size()), 2);
+
+    // Once full, even existing points are refused rather than overflowing the page
+    while (message.getAvailableSize() >= moduleSize)
+    {
+        auto rotation = module(1, 2, OTP::MODULES::STANDARD::ROTATION);
+        QCOMPARE(message.addModule(rotation), Message::OK);
+    }
+    auto rotation = module(1, 2, OTP::MODULES::STANDARD::ROTATION);
+    QCOMPARE(message.addModule(rotation), Message::MessageToBig);
+
+    const auto packed = pack(message);
+    QVERIFY(packed.size() <= static_cast<int>(OTP::MESSAGES::OTPTransformMessage::RANGES::MESSAGE_SIZE.getMax()));
+    Message dissected{QNetworkDatagram(packed)};
+    QVERIFY(dissected.isValid());
+    QCOMPARE(static_cast<int>(dissected.getPoints().size()), points);
+}
+
+void TEST_OTP::MESSAGES::OTPTransformMessage::packFolio()
+{
+    using namespace TEST_OTP::MESSAGES::APPENDIX_B;
+    const auto &details = Examples.first().second;
+    const OTP::system_t system = details.OTPTransformLayer.system;
+
+    // Table B-1, as the only page of its folio
+    auto expected = Examples.first().first + ExampleB_1_Point;
+    expected.replace(PageOffset, 4, QByteArray(4, 0));
+
+    // Packed point
+    const auto modules = unpackPoint(ExampleB_1_Point, system);
+    QCOMPARE(static_cast<int>(modules.size()), 4);
+    const auto point = Message::packPoint(modules);
+    QCOMPARE(static_cast<QByteArray>(point), ExampleB_1_Point);
+
+    // Packed folio
+    const auto pages = Message::packFolio(
+                details.OTPLayer.cid, details.OTPLayer.componentName.toUtf8(), system,
+                details.OTPTransformLayer.option_isFullPointSet, details.OTPLayer.folio, {point});
+    QCOMPARE(static_cast<int>(pages.size()), 1);
+    QCOMPARE(withTimestamp(pages.first(), expected), expected);
+
+    // Identical to building the message a module at a time
+    Message message(details.OTPLayer.cid, details.OTPLayer.componentName.toUtf8(), system,
+                    details.OTPTransformLayer.option_isFullPointSet);
+    for (auto moduleData : modules)
+        QCOMPARE(message.addModule(moduleData), Message::OK);
+    const auto addModule = message.toQNetworkDatagram(QHostAddress::LocalHost, details.OTPLayer.folio, 0, 0).data();
+    QCOMPARE(withTimestamp(addModule, expected), expected);
+}
+
+void TEST_OTP::MESSAGES::OTPTransformMessage::packFolioPages()
+{
+    const auto cid = QUuid::createUuid();
+    const int maxSize = static_cast<int>(OTP::MESSAGES::OTPTransformMessage::RANGES::MESSAGE_SIZE.getMax());
+
+    // Points of differing sizes, too many for one page
+    QVector<QByteArray> points;
+    for (OTP::point_t point = 1; point <= 100; point++)
+    {
+        QVector<Message::addModule_t> modules = {module(1, point, OTP::MODULES::STANDARD::POSITION)};
+        if (point % 3) modules.append(module(1, point, OTP::MODULES::STANDARD::ROTATION));
+        points.append(Message::packPoint(modules));
+    }
+
+    const auto pages = Message::packFolio(cid, QByteArray("Test"), System, true, 42, points);
+    QVERIFY(pages.size() > 1);
+
+    int nextPoint = 0;
+    for (int page = 0; page < pages.size(); page++)
+    {
+        const auto &packed = pages.at(page);
+        QVERIFY(packed.size() <= maxSize);
+
+        Message message{QNetworkDatagram(packed)};
+        QVERIFY(message.isValid());
+        QCOMPARE(static_cast<int>(message.getOTPLayer().getFolio()), 42);
+        QCOMPARE(static_cast<int>(message.getOTPLayer().getPage()), page);
+        QCOMPARE(static_cast<int>(message.getOTPLayer().getLastPage()), static_cast<int>(pages.size()) - 1);
+        QVERIFY(message.getTransformLayer().getOptions().isFullPointSet());
+
+        // Each page carries whole points, in order
+        QByteArray run;
+        for (const auto &point : message.getPoints())
+        {
+            QCOMPARE(static_cast<int>(point.pointLayer.getPoint()), nextPoint + 1);
+            QCOMPARE(static_cast<int>(point.moduleLayers.size()), ((nextPoint + 1) % 3) ? 2 : 1);
+            run.append(points.at(nextPoint++));
+        }
+        QCOMPARE(packed.mid(OTP::PDU::OTPLayer::SIZE + OTP::PDU::OTPTransformLayer::SIZE), run);
+
+        // Only split where the next point would not have fit
+        if (page < pages.size() - 1)
+            QVERIFY(packed.size() + points.at(nextPoint).size() > maxSize);
+    }
+    QCOMPARE(nextPoint, static_cast<int>(points.size()));
+}
@@ -0,0 +1,26 @@
+#ifndef TEST_OTP_TRANSFORM_MESSAGE_H
+#define TEST_OTP_TRANSFORM_MESSAGE_H
+
+#include <QtTest/QTest>
+
+#include "network/messages/otp_transform_message.hpp"
+
+namespace TEST_OTP::MESSAGES
+{
+    class OTPTransformMessage : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        OTPTransformMessage() = default;
+        ~OTPTransformMessage() = default;
+
+    private slots:
+        void addModule();
+        void addModuleKeepsPointOnOnePage();
+        void packFolio();
+        void packFolioPages();
+    };
+}
+
+#endif // TEST_OTP_TRANSFORM_MESSAGE_H
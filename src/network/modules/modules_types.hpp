@@ -23,6 +23,7 @@
 #define MODULES_TYPES_HPP
 
 #include "../../bugs.hpp"
+#include "../../clock.hpp"
 #include <QDateTime>
 #include <QRegularExpression>
 #include <bitset>
@@ -189,7 +190,7 @@ namespace OTP::MODULES {
                 um = 1 /**< Micrometers (μm) */
             } scale_t;
 
-            PositionModule_t() : options(), timestamp(0), lastSeen(QDateTime())
+            PositionModule_t() : options(), timestamp(0)
             {
                 std::fill(std::begin(position), std::end(position), 0);
             }
@@ -221,7 +222,15 @@ namespace OTP::MODULES {
              * 
              * @return Last activity time 
              */
-            QDateTime getLastSeen() const { return lastSeen; }
+            QDateTime getLastSeen() const { return CLOCK::toDateTime(lastSeen); }
+
+            /**
+             * @internal
+             * @brief Get last point activity time for the module
+             * 
+             * @return Last activity time, in library clock ticks
+             */
+            CLOCK::ticks_t getLastSeenTicks() const { return lastSeen; }
 
             /**
              * @brief Set the scaling of the value
@@ -319,8 +328,8 @@ namespace OTP::MODULES {
             options_t options;
             position_t position[axis_t::count];
             timestamp_t timestamp = 0;
-            void updateLastSeen() { lastSeen = QDateTime::currentDateTime(); }
-            QDateTime lastSeen;
+            void updateLastSeen() { lastSeen = CLOCK::now(); }
+            CLOCK::ticks_t lastSeen = CLOCK::never;
         };
 
         /**
@@ -343,7 +352,7 @@ namespace OTP::MODULES {
              */
             typedef qint32 acceleration_t;
 
-            PositionVelAccModule_t() : timestamp(0), lastSeen(QDateTime())
+            PositionVelAccModule_t() : timestamp(0)
             {
                 std::fill(std::begin(velocity), std::end(velocity), 0);
                 std::fill(std::begin(acceleration), std::end(acceleration), 0);
@@ -376,7 +385,15 @@ namespace OTP::MODULES {
              * 
              * @return Last activity time 
              */
-            QDateTime getLastSeen() const { return lastSeen; }
+            QDateTime getLastSeen() const { return CLOCK::toDateTime(lastSeen); }
+
+            /**
+             * @internal
+             * @brief Get last point activity time for the module
+             * 
+             * @return Last activity time, in library clock ticks
+             */
+            CLOCK::ticks_t getLastSeenTicks() const { return lastSeen; }
 
             /**
              * @brief Get the Velocity of axis
@@ -460,8 +477,8 @@ namespace OTP::MODULES {
             velocity_t velocity[axis_t::count];
             acceleration_t acceleration[axis_t::count];
             timestamp_t timestamp = 0;
-            void updateLastSeen() { lastSeen = QDateTime::currentDateTime(); }
-            QDateTime lastSeen;
+            void updateLastSeen() { lastSeen = CLOCK::now(); }
+            CLOCK::ticks_t lastSeen = CLOCK::never;
         };
 
         /**
@@ -519,7 +536,7 @@ namespace OTP::MODULES {
                 type data;
             };
 
-            RotationModule_t() : timestamp(0), lastSeen(QDateTime())
+            RotationModule_t() : timestamp(0)
             {
                 std::fill(std::begin(rotation), std::end(rotation), 0);
             }
@@ -550,7 +567,15 @@ namespace OTP::MODULES {
              * 
              * @return Last activity time 
              */
-            QDateTime getLastSeen() const { return lastSeen; }
+            QDateTime getLastSeen() const { return CLOCK::toDateTime(lastSeen); }
+
+            /**
+             * @internal
+             * @brief Get last point activity time for the module
+             * 
+             * @return Last activity time, in library clock ticks
+             */
+            CLOCK::ticks_t getLastSeenTicks() const { return lastSeen; }
 
             /**
              * @brief Get the Rotation of axis
@@ -603,8 +628,8 @@ namespace OTP::MODULES {
         private:
             rotation_t rotation[axis_t::count];
             timestamp_t timestamp = 0;
-            void updateLastSeen() { lastSeen = QDateTime::currentDateTime(); }
-            QDateTime lastSeen;
+            void updateLastSeen() { lastSeen = CLOCK::now(); }
+            CLOCK::ticks_t lastSeen = CLOCK::never;
         };
 
         /**
@@ -621,7 +646,7 @@ namespace OTP::MODULES {
             /*! Acceleration value type */ 
             typedef qint32 acceleration_t;
 
-            RotationVelAccModule_t() : timestamp(0), lastSeen(QDateTime())
+            RotationVelAccModule_t() : timestamp(0)
             {
                 std::fill(std::begin(velocity), std::end(velocity), 0);
                 std::fill(std::begin(acceleration), std::end(acceleration), 0);
@@ -654,7 +679,15 @@ namespace OTP::MODULES {
              * 
              * @return Last activity time 
              */
-            QDateTime getLastSeen() const { return lastSeen; }
+            QDateTime getLastSeen() const { return CLOCK::toDateTime(lastSeen); }
+
+            /**
+             * @internal
+             * @brief Get last point activity time for the module
+             * 
+             * @return Last activity time, in library clock ticks
+             */
+            CLOCK::ticks_t getLastSeenTicks() const { return lastSeen; }
 
             /**
              * @brief Get the Velocity of axis
@@ -738,8 +771,8 @@ namespace OTP::MODULES {
             velocity_t velocity[axis_t::count];
             acceleration_t acceleration[axis_t::count];
             timestamp_t timestamp = 0;
-            void updateLastSeen() { lastSeen = QDateTime::currentDateTime(); }
-            QDateTime lastSeen;
+            void updateLastSeen() { lastSeen = CLOCK::now(); }
+            CLOCK::ticks_t lastSeen = CLOCK::never;
         };
 
         /**
@@ -765,7 +798,7 @@ namespace OTP::MODULES {
              */
             typedef qreal percent_t;
 
-            ScaleModule_t() : timestamp(0), lastSeen(QDateTime())
+            ScaleModule_t() : timestamp(0)
             {
                 std::fill(std::begin(scale), std::end(scale), fromPercent(100));
             }
@@ -796,7 +829,15 @@ namespace OTP::MODULES {
              * 
              * @return Last activity time 
              */
-            QDateTime getLastSeen() const { return lastSeen; }
+            QDateTime getLastSeen() const { return CLOCK::toDateTime(lastSeen); }
+
+            /**
+             * @internal
+             * @brief Get last point activity time for the module
+             * 
+             * @return Last activity time, in library clock ticks
+             */
+            CLOCK::ticks_t getLastSeenTicks() const { return lastSeen; }
 
             /**
              * @brief Get the Scale of the axis
@@ -876,8 +917,8 @@ namespace OTP::MODULES {
         private:
             scale_t scale[axis_t::count];
             timestamp_t timestamp = 0;
-            void updateLastSeen() { lastSeen = QDateTime::currentDateTime(); }
-            QDateTime lastSeen;
+            void updateLastSeen() { lastSeen = CLOCK::now(); }
+            CLOCK::ticks_t lastSeen = CLOCK::never;
         };
 
         /**
@@ -899,7 +940,7 @@ namespace OTP::MODULES {
             /*! Creates a type name for OTPTransformLayer::group_t */ 
             typedef OTPPointLayer::group_t group_t;
 
-            ReferenceFrameModule_t() : timestamp(0), lastSeen(QDateTime()) { }
+            ReferenceFrameModule_t() : timestamp(0) { }
 
             /**
              * @brief Construct a new Reference Frame Module object
@@ -929,7 +970,15 @@ namespace OTP::MODULES {
              * 
              * @return Last activity time 
              */
-            QDateTime getLastSeen() const { return lastSeen; }
+            QDateTime getLastSeen() const { return CLOCK::toDateTime(lastSeen); }
+
+            /**
+             * @internal
+             * @brief Get last point activity time for the module
+             * 
+             * @return Last activity time, in library clock ticks
+             */
+            CLOCK::ticks_t getLastSeenTicks() const { return lastSeen; }
 
             /**
              * @brief Get the System number
@@ -1014,8 +1063,8 @@ namespace OTP::MODULES {
             group_t group;
             point_t point;
             timestamp_t timestamp = 0;
-            void updateLastSeen() { lastSeen = QDateTime::currentDateTime(); }
-            QDateTime lastSeen;
+            void updateLastSeen() { lastSeen = CLOCK::now(); }
+            CLOCK::ticks_t lastSeen = CLOCK::never;
         };
     }
 }
@@ -26,18 +26,14 @@ using namespace OTP::PDU::OTPAdvertisementLayer;
 
 Layer::Layer(
         vector_t Vector,
-        pduLength_t PDULength,
-        QObject *parent) :
-    QObject(parent),
+        pduLength_t PDULength) :
     Vector(Vector),
     PDULength(PDULength),
     Reserved(RESERVED)
 {}
 
 Layer::Layer(
-        OTP::PDU::PDUByteArray layer,
-        QObject *parent) :
-    QObject(parent),
+        OTP::PDU::PDUByteArray layer) :
     Vector(0),
     PDULength(0),
     Reserved(0)
@@ -48,14 +44,21 @@ Layer::Layer(
 bool Layer::isValid() const
 {
     if (!VECTOR.contains(Vector)) return false;
-    if (PDULength <= toPDUByteArray().size() - LENGTHOFFSET) return false;
+    if (PDULength <= getSize() - LENGTHOFFSET) return false;
     return true;
 }
 
 OTP::PDU::PDUByteArray Layer::toPDUByteArray() const
 {
     PDUByteArray ret;
-    return ret << Vector
+    ret.reserve(getSize());
+    toPDUByteArray(ret);
+    return ret;
+}
+
+void Layer::toPDUByteArray(OTP::PDU::PDUByteArray &ba) const
+{
+    ba << Vector
         << PDULength
         << Reserved;
 }
@@ -66,7 +69,7 @@ void Layer::fromPDUByteArray(OTP::PDU::PDUByteArray layer)
     PDULength = 0;
     Reserved = 0;
 
-    if (layer.size() != Layer().toPDUByteArray().size())
+    if (layer.size() != SIZE)
         return;
 
     layer >> Vector
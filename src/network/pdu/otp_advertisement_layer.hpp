@@ -22,7 +22,6 @@
 #ifndef OTP_ADVERTISMENT_LAYER_HPP
 #define OTP_ADVERTISMENT_LAYER_HPP
 
-#include <QObject>
 #include "pdu_types.hpp"
 #include "pdu_const.hpp"
 
@@ -40,32 +39,27 @@ namespace OTP::PDU::OTPAdvertisementLayer
  * @brief Advertisement PDU Layer
  * 
  */
-class Layer : public QObject
+class Layer
 {
-    Q_OBJECT
 public:
     /**
      * @brief Construct a Layer
      * 
      * @param Vector Payload Vector
      * @param PDULength PDU Length
-     * @param parent Parent object
      */
     explicit Layer(
             vector_t Vector = 0,
-            pduLength_t PDULength = 0,
-            QObject *parent = nullptr);
+            pduLength_t PDULength = 0);
 
     /**
      * @brief Construct a new Layer from an existing layer extracted from a network message
      * @details Used to dissect an on-the wire message
      * 
      * @param layer Byte array to unpack and dissect
-     * @param parent Parent object
      */
     explicit Layer(
-            PDUByteArray layer,
-            QObject *parent = nullptr);
+            PDUByteArray layer);
 
     /**
      * @brief Is the layer valid
@@ -83,6 +77,22 @@ public:
      */
     PDUByteArray toPDUByteArray() const;
 
+    /**
+     * @brief Pack the layer onto the end of a byte array
+     * @details As transmitted "on-the-wire", allowing a complete message to be packed into a single buffer
+     * 
+     * @param ba Byte array to append to
+     */
+    void toPDUByteArray(PDUByteArray &ba) const;
+
+    /**
+     * @brief Get packed size of the layer
+     * @details Calculated from the layer fields, without packing
+     * 
+     * @return Size in octets
+     */
+    pduLength_t getSize() const { return SIZE; }
+
     /**
      * @brief Unpack a byte array into layer
      * 
@@ -30,9 +30,7 @@ Layer::Layer(vector_t Vector,
         folio_t Folio,
         page_t Page,
         page_t LastPage,
-        name_t ComponentName,
-        QObject *parent) :
-    QObject(parent),
+        name_t ComponentName) :
     PacketIdent(OTP_PACKET_IDENT),
     Vector(Vector),
     PDULength(PDULength),
@@ -46,9 +44,7 @@ Layer::Layer(vector_t Vector,
 {}
 
 Layer::Layer(
-        OTP::PDU::PDUByteArray layer,
-        QObject *parent) :
-    QObject(parent),
+        OTP::PDU::PDUByteArray layer) :
     PacketIdent(QByteArray()),
     Vector(0),
     PDULength(0),
@@ -67,7 +63,7 @@ bool Layer::isValid() const
 {
     if (PacketIdent != OTP_PACKET_IDENT) return false;
     if (!VECTOR.contains(Vector)) return false;
-    if (PDULength <= toPDUByteArray().size() - LENGTHOFFSET) return false;
+    if (PDULength <= getSize() - LENGTHOFFSET) return false;
     if (CID.isNull()) return false;
     if (Page > LastPage) return false;
     if (ComponentName.length() != NAME_LENGTH) return false;
@@ -77,7 +73,14 @@ bool Layer::isValid() const
 OTP::PDU::PDUByteArray Layer::toPDUByteArray() const
 {
     PDUByteArray ret;
-    return ret
+    ret.reserve(getSize());
+    toPDUByteArray(ret);
+    return ret;
+}
+
+void Layer::toPDUByteArray(OTP::PDU::PDUByteArray &ba) const
+{
+    ba
         << PacketIdent
         << Vector
         << PDULength
@@ -106,7 +109,7 @@ void Layer::fromPDUByteArray(OTP::PDU::PDUByteArray layer)
     Reserved = 0;
     ComponentName = name_t();
 
-    if (layer.size() != Layer().toPDUByteArray().size())
+    if (layer.size() != SIZE)
         return;
 
     decltype (Footer.getLength()) footerLength;
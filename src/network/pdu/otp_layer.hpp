@@ -22,7 +22,6 @@
 #ifndef OTP_LAYER_HPP
 #define OTP_LAYER_HPP
 
-#include <QObject>
 #include <QCoreApplication>
 #include "pdu_types.hpp"
 #include "pdu_const.hpp"
@@ -41,9 +40,8 @@ namespace OTP::PDU::OTPLayer
  * @brief OTP PDU Layer
  * 
  */
-class Layer : public QObject
+class Layer
 {
-    Q_OBJECT
 public:
     /**
      * @brief Construct a Layer
@@ -55,7 +53,6 @@ public:
      * @param Page Folio page number
      * @param LastPage Folio last page number
      * @param ComponentName Component Name
-     * @param parent Parent object
      */
     explicit Layer(
             vector_t Vector = 0,
@@ -64,19 +61,16 @@ public:
             folio_t Folio = 0,
             page_t Page = 0,
             page_t LastPage = 0,
-            name_t ComponentName = QCoreApplication::applicationName().toUtf8(),
-            QObject *parent = nullptr);
+            name_t ComponentName = QCoreApplication::applicationName().toUtf8());
 
     /**
      * @brief Construct a new Layer from an existing layer extracted from a network message
      * @details Used to dissect an on-the wire message
      * 
      * @param layer Byte array to unpack and dissect
-     * @param parent Parent object
      */
     explicit Layer(
-            PDUByteArray layer,
-            QObject *parent = nullptr);
+            PDUByteArray layer);
 
     /**
      * @brief Is the layer valid
@@ -94,6 +88,22 @@ public:
      */
     PDUByteArray toPDUByteArray() const;
 
+    /**
+     * @brief Pack the layer onto the end of a byte array
+     * @details As transmitted "on-the-wire", allowing a complete message to be packed into a single buffer
+     * 
+     * @param ba Byte array to append to
+     */
+    void toPDUByteArray(PDUByteArray &ba) const;
+
+    /**
+     * @brief Get packed size of the layer
+     * @details Calculated from the layer fields, without packing
+     * 
+     * @return Size in octets
+     */
+    pduLength_t getSize() const { return SIZE; }
+
     /**
      * @brief Unpack a byte array into layer
      * 
@@ -26,9 +26,7 @@ using namespace OTP::PDU::OTPModuleAdvertisementLayer;
 
 Layer::Layer(
         pduLength_t PDULength,
-        list_t List,
-        QObject *parent) :
-    QObject(parent),
+        list_t List) :
     Vector(VECTOR),
     PDULength(PDULength),
     Reserved(RESERVED),
@@ -38,9 +36,7 @@ Layer::Layer(
 }
 
 Layer::Layer(
-        OTP::PDU::PDUByteArray layer,
-        QObject *parent) :
-    QObject(parent),
+        OTP::PDU::PDUByteArray layer) :
     Vector(0),
     PDULength(0),
     Reserved(0),
@@ -22,7 +22,6 @@
 #ifndef OTP_MODULE_ADVERTISMENT_LAYER_HPP
 #define OTP_MODULE_ADVERTISMENT_LAYER_HPP
 
-#include <QObject>
 #include "pdu_types.hpp"
 #include "pdu_const.hpp"
 
@@ -40,32 +39,27 @@ namespace OTP::PDU::OTPModuleAdvertisementLayer
  * @brief OTP PDU Layer
  * 
  */
-class Layer : public QObject
+class Layer
 {
-    Q_OBJECT
 public:
     /**
      * @brief Construct a Layer
      * 
      * @param PDULength PDU Length
      * @param List List of modules to advertise
-     * @param parent Parent object
      */
     explicit Layer(
             pduLength_t PDULength = 0,
-            list_t List = list_t(),
-            QObject *parent = nullptr);
+            list_t List = list_t());
 
     /**
      * @brief Construct a new Layer from an existing layer extracted from a network message
      * @details Used to dissect an on-the wire message
      * 
      * @param layer Byte array to unpack and dissect
-     * @param parent Parent object
      */
     explicit Layer(
-            PDUByteArray layer,
-            QObject *parent = nullptr);
+            PDUByteArray layer);
 
     /**
      * @brief Is the layer valid
@@ -24,8 +24,7 @@
 using namespace OTP::PDU;
 using namespace OTP::PDU::OTPModuleLayer;
 
-Layer::Layer(QObject *parent) :
-    QObject(parent),
+Layer::Layer() :
     ModuleIdent(ident_t()),
     PDULength(0),
     Additional(QByteArray())
@@ -33,23 +32,19 @@ Layer::Layer(QObject *parent) :
 
 Layer::Layer(manufacturerID_t ManufacturerID,
         pduLength_t PDULength,
-        moduleNumber_t ModuleNumber,
-        QObject *parent) :
-    QObject(parent),
+        moduleNumber_t ModuleNumber) :
     ModuleIdent({ManufacturerID, ModuleNumber}),
     PDULength(PDULength),
     Additional(QByteArray())
 {}
 
 Layer::Layer(
-        OTP::PDU::PDUByteArray layer,
-        QObject *parent) :
-    QObject(parent),
+        OTP::PDU::PDUByteArray layer) :
     ModuleIdent(ident_t()),
     PDULength(0),
     Additional(QByteArray())
 {
-    if (layer.size() != Layer().toPDUByteArray().size())
+    if (layer.size() != SIZE)
         return;
 
     layer >> ModuleIdent.ManufacturerID
@@ -58,17 +53,24 @@ Layer::Layer(
         >> Additional;
 }
 
-bool Layer::isValid()
+bool Layer::isValid() const
 {
-    if (PDULength != toPDUByteArray().size() - LENGTHOFFSET) return false;
+    if (PDULength != getSize() - LENGTHOFFSET) return false;
     if (Additional.isNull()) return false;
     return true;
 }
 
-OTP::PDU::PDUByteArray Layer::toPDUByteArray()
+OTP::PDU::PDUByteArray Layer::toPDUByteArray() const
 {
     PDUByteArray ret;
-    return ret << ModuleIdent.ManufacturerID
+    ret.reserve(getSize());
+    toPDUByteArray(ret);
+    return ret;
+}
+
+void Layer::toPDUByteArray(OTP::PDU::PDUByteArray &ba) const
+{
+    ba << ModuleIdent.ManufacturerID
         << PDULength
         << ModuleIdent.ModuleNumber
         << Additional;
@@ -80,7 +82,7 @@ void Layer::fromPDUByteArray(OTP::PDU::PDUByteArray layer)
     PDULength = 0;
     Additional.clear();
 
-    if (layer.size() < Layer().toPDUByteArray().size())
+    if (layer.size() < SIZE)
         return;
 
     layer >> ModuleIdent.ManufacturerID
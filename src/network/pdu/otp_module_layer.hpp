@@ -22,7 +22,6 @@
 #ifndef OTP_MODULE_LAYER_HPP
 #define OTP_MODULE_LAYER_HPP
 
-#include <QObject>
 #include "pdu_types.hpp"
 #include "pdu_const.hpp"
 
@@ -40,16 +39,14 @@ namespace OTP::PDU::OTPModuleLayer
  * @brief OTP PDU Layer
  * 
  */
-class Layer : public QObject
+class Layer
 {
-    Q_OBJECT
 public:
     /**
      * @brief Construct a Layer
      * 
-     * @param parent Parent object 
      */
-    explicit Layer(QObject *parent = nullptr);
+    Layer();
 
     /**
      * @brief Construct a new Layer object
@@ -57,24 +54,20 @@ public:
      * @param ManufacturerID Manufacturer ID
      * @param PDULength PDU Length
      * @param ModuleNumber Module Number
-     * @param parent Parent object
      */
     explicit Layer(
             manufacturerID_t ManufacturerID,
             pduLength_t PDULength,
-            moduleNumber_t ModuleNumber,
-            QObject *parent = nullptr);
+            moduleNumber_t ModuleNumber);
 
     /**
      * @brief Construct a new Layer from an existing layer extracted from a network message
      * @details Used to dissect an on-the wire message
      * 
      * @param layer Byte array to unpack and dissect
-     * @param parent Parent object
      */
     explicit Layer(
-            PDUByteArray layer,
-            QObject *parent = nullptr);
+            PDUByteArray layer);
 
     /**
      * @brief Is the layer valid
@@ -82,7 +75,7 @@ public:
      * @return true Layer is valid
      * @return false Layer is not valid
      */
-    bool isValid();
+    bool isValid() const;
 
     /**
      * @brief Pack the layer into a byte array
@@ -90,7 +83,23 @@ public:
      * 
      * @return Packed byte array 
      */
-    PDUByteArray toPDUByteArray();
+    PDUByteArray toPDUByteArray() const;
+
+    /**
+     * @brief Pack the layer onto the end of a byte array
+     * @details As transmitted "on-the-wire", allowing a complete message to be packed into a single buffer
+     * 
+     * @param ba Byte array to append to
+     */
+    void toPDUByteArray(PDUByteArray &ba) const;
+
+    /**
+     * @brief Get packed size of the layer
+     * @details Calculated from the layer fields, without packing
+     * 
+     * @return Size in octets
+     */
+    pduLength_t getSize() const { return static_cast<pduLength_t>(SIZE + Additional.size()); }
 
     /**
      * @brief Unpack a byte array into layer
@@ -104,7 +113,7 @@ public:
      * 
      * @return Manufacturer ID
      */
-    const manufacturerID_t &getManufacturerID() { return ModuleIdent.ManufacturerID; }
+    const manufacturerID_t &getManufacturerID() const { return ModuleIdent.ManufacturerID; }
 
     /**
      * @brief Set PDU Manufacturer ID
@@ -133,7 +142,7 @@ public:
      * 
      * @return PDU Length
      */
-    const pduLength_t &getPDULength() { return PDULength; }
+    const pduLength_t &getPDULength() const { return PDULength; }
 
     /**
      * @brief Set PDU Length
@@ -147,7 +156,7 @@ public:
      * 
      * @return Module Number
      */
-    const moduleNumber_t &getModuleNumber() { return ModuleIdent.ModuleNumber; }
+    const moduleNumber_t &getModuleNumber() const { return ModuleIdent.ModuleNumber; }
 
     /**
      * @brief Set PDU Module Number
@@ -161,7 +170,7 @@ public:
      * 
      * @return Additional Fields
      */
-    const additional_t &getAdditional() { return Additional; }
+    const additional_t &getAdditional() const { return Additional; }
 
     /**
      * @brief Set module sepcfic PDU Additional Fields
@@ -29,9 +29,7 @@ Layer::Layer(
         priority_t Priority,
         group_t Group,
         point_t Point,
-        timestamp_t Timestamp,
-        QObject *parent) :
-    QObject(parent),
+        timestamp_t Timestamp) :
     Vector(VECTOR),
     PDULength(PDULength),
     Priority(Priority),
@@ -43,9 +41,7 @@ Layer::Layer(
 {}
 
 Layer::Layer(
-        OTP::PDU::PDUByteArray layer,
-        QObject *parent) :
-    QObject(parent),
+        OTP::PDU::PDUByteArray layer) :
     Vector(0),
     PDULength(0),
     Priority(0),
@@ -54,7 +50,7 @@ Layer::Layer(
     Options(0),
     Reserved(0)
 {
-    if (layer.size() != Layer().toPDUByteArray().size())
+    if (layer.size() != SIZE)
         return;
 
     layer >> Vector
@@ -67,10 +63,10 @@ Layer::Layer(
         >> Reserved;
 }
 
-bool Layer::isValid()
+bool Layer::isValid() const
 {
     if (Vector != VECTOR) return false;
-    if (PDULength <= toPDUByteArray().size() - LENGTHOFFSET) return false;
+    if (PDULength <= getSize() - LENGTHOFFSET) return false;
     if (!Priority.isValid()) return false;
     if (!Group.isValid()) return false;
     if (!Point.isValid()) return false;
@@ -78,10 +74,17 @@ bool Layer::isValid()
     return true;
 }
 
-OTP::PDU::PDUByteArray Layer::toPDUByteArray()
+OTP::PDU::PDUByteArray Layer::toPDUByteArray() const
 {
     PDUByteArray ret;
-    return ret << Vector
+    ret.reserve(getSize());
+    toPDUByteArray(ret);
+    return ret;
+}
+
+void Layer::toPDUByteArray(OTP::PDU::PDUByteArray &ba) const
+{
+    ba << Vector
         << PDULength
         << Priority
         << Group
@@ -102,7 +105,7 @@ void Layer::fromPDUByteArray(OTP::PDU::PDUByteArray layer)
     Options = 0;
     Reserved = 0;
 
-    if (layer.size() != Layer().toPDUByteArray().size())
+    if (layer.size() != SIZE)
         return;
 
     layer >> Vector
@@ -22,7 +22,6 @@
 #ifndef OTP_POINT_LAYER_HPP
 #define OTP_POINT_LAYER_HPP
 
-#include <QObject>
 #include <QDateTime>
 #include "pdu_types.hpp"
 #include "pdu_const.hpp"
@@ -41,9 +40,8 @@ namespace OTP::PDU::OTPPointLayer
  * @brief OTP PDU Layer
  * 
  */
-class Layer : public QObject
+class Layer
 {
-    Q_OBJECT
 public:
     /**
      * @brief Construct a new Layer object
@@ -53,26 +51,22 @@ public:
      * @param Group Group number of Point
      * @param Point Point number
      * @param Timestamp Sample timestamp
-     * @param parent Parent object
      */
     explicit Layer(
             pduLength_t PDULength = 0,
             priority_t Priority = 100,
             group_t Group = 0,
             point_t Point = 0,
-            timestamp_t Timestamp = static_cast<timestamp_t>(QDateTime::currentMSecsSinceEpoch() * 1000),
-            QObject *parent = nullptr);
+            timestamp_t Timestamp = static_cast<timestamp_t>(QDateTime::currentMSecsSinceEpoch() * 1000));
 
     /**
      * @brief Construct a new Layer object
      * @details Used to dissect an on-the wire message
      * 
      * @param layer Byte array to unpack and dissect
-     * @param parent Parent object
      */
     explicit Layer(
-            PDUByteArray layer,
-            QObject *parent = nullptr);
+            PDUByteArray layer);
 
     /**
      * @brief Is the layer valid
@@ -80,7 +74,7 @@ public:
      * @return true Layer is valid
      * @return false Layer is not valid
      */
-    bool isValid();
+    bool isValid() const;
 
     /**
      * @brief Pack the layer into a byte array
@@ -88,7 +82,23 @@ public:
      * 
      * @return Packed byte array 
      */
-    PDUByteArray toPDUByteArray();
+    PDUByteArray toPDUByteArray() const;
+
+    /**
+     * @brief Pack the layer onto the end of a byte array
+     * @details As transmitted "on-the-wire", allowing a complete message to be packed into a single buffer
+     * 
+     * @param ba Byte array to append to
+     */
+    void toPDUByteArray(PDUByteArray &ba) const;
+
+    /**
+     * @brief Get packed size of the layer
+     * @details Calculated from the layer fields, without packing
+     * 
+     * @return Size in octets
+     */
+    pduLength_t getSize() const { return SIZE; }
 
     /**
      * @brief Unpack a byte array into layer
@@ -102,7 +112,7 @@ public:
      * 
      * @return PDU Vector
      */
-    const vector_t &getVector() { return Vector; }
+    const vector_t &getVector() const { return Vector; }
 
     /**
      * @brief Get PDU Length
@@ -123,7 +133,7 @@ public:
      * 
      * @return PDU Priority
      */
-    const priority_t &getPriority() { return Priority; }
+    const priority_t &getPriority() const { return Priority; }
 
     /**
      * @brief Set PDU Priority
@@ -137,7 +147,7 @@ public:
      * 
      * @return PDU Group
      */
-    const group_t &getGroup() { return Group; }
+    const group_t &getGroup() const { return Group; }
 
     /**
      * @brief Set PDU Group
@@ -151,7 +161,7 @@ public:
      * 
      * @return PDU Point
      */
-    const point_t &getPoint() { return Point; }
+    const point_t &getPoint() const { return Point; }
 
     /**
      * @brief Set PDU Point
@@ -165,7 +175,7 @@ public:
      * 
      * @return PDU Timestamp
      */
-    const timestamp_t &getTimestamp() { return Timestamp; }
+    const timestamp_t &getTimestamp() const { return Timestamp; }
     
     /**
      * @brief Set PDU Timestamp
@@ -27,9 +27,7 @@ using namespace OTP::PDU::OTPSystemAdvertisementLayer;
 Layer::Layer(
         pduLength_t PDULength,
         options_t Options,
-        list_t List,
-        QObject *parent) :
-    QObject(parent),
+        list_t List) :
     Vector(VECTOR),
     PDULength(PDULength),
     Options(Options),
@@ -40,9 +38,7 @@ Layer::Layer(
 }
 
 Layer::Layer(
-        OTP::PDU::PDUByteArray layer,
-        QObject *parent) :
-    QObject(parent),
+        OTP::PDU::PDUByteArray layer) :
     Vector(0),
     PDULength(0),
     Options(options_t()),
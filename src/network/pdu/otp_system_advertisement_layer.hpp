@@ -22,7 +22,6 @@
 #ifndef OTP_SYSTEM_ADVERTISMENT_LAYER_HPP
 #define OTP_SYSTEM_ADVERTISMENT_LAYER_HPP
 
-#include <QObject>
 #include "pdu_types.hpp"
 #include "pdu_const.hpp"
 
@@ -40,9 +39,8 @@ namespace OTP::PDU::OTPSystemAdvertisementLayer
  * @brief OTP PDU Layer
  * 
  */
-class Layer : public QObject
+class Layer
 {
-    Q_OBJECT
 public:
     /**
      * @brief Construct a Layer
@@ -50,24 +48,20 @@ public:
      * @param PDULength PDU Length
      * @param Options Option flags
      * @param List List of systems to advertise
-     * @param parent Parent object 
      */
     explicit Layer(
             pduLength_t PDULength = 0,
             options_t Options = options_t(),
-            list_t List = list_t(),
-            QObject *parent = nullptr);
+            list_t List = list_t());
 
     /**
      * @brief Construct a new Layer from an existing layer extracted from a network message
      * @details Used to dissect an on-the wire message
      * 
      * @param layer Byte array to unpack and dissect
-     * @param parent Parent object
      */
     explicit Layer(
-            PDUByteArray layer,
-            QObject *parent = nullptr);
+            PDUByteArray layer);
 
     /**
      * @brief Is the layer valid
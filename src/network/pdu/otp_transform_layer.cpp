@@ -28,9 +28,7 @@ Layer::Layer(
         pduLength_t PDULength,
         system_t System,
         timestamp_t Timestamp,
-        options_t Options,
-        QObject *parent) :
-    QObject(parent),
+        options_t Options) :
     Vector(VECTOR),
     PDULength(PDULength),
     System(System),
@@ -40,16 +38,14 @@ Layer::Layer(
 {}
 
 Layer::Layer(
-        OTP::PDU::PDUByteArray layer,
-        QObject *parent) :
-    QObject(parent),
+        OTP::PDU::PDUByteArray layer) :
     Vector(0),
     PDULength(0),
     System(0),
     Options(options_t()),
     Reserved(0)
 {
-    if (layer.size() != Layer().toPDUByteArray().size())
+    if (layer.size() != SIZE)
         return;
 
     layer >> Vector
@@ -63,7 +59,7 @@ Layer::Layer(
 bool Layer::isValid() const
 {
     if (Vector != VECTOR) return false;
-    if (PDULength <= toPDUByteArray().size() - LENGTHOFFSET) return false;
+    if (PDULength <= getSize() - LENGTHOFFSET) return false;
     if (!System.isValid()) return false;
     if (Timestamp == 0) return false;
     return true;
@@ -72,7 +68,14 @@ bool Layer::isValid() const
 OTP::PDU::PDUByteArray Layer::toPDUByteArray() const
 {
     PDUByteArray ret;
-    return ret << Vector
+    ret.reserve(getSize());
+    toPDUByteArray(ret);
+    return ret;
+}
+
+void Layer::toPDUByteArray(OTP::PDU::PDUByteArray &ba) const
+{
+    ba << Vector
         << PDULength
         << System
         << Timestamp
@@ -89,7 +92,7 @@ void Layer::fromPDUByteArray(OTP::PDU::PDUByteArray layer)
     Options = options_t();
     Reserved = 0;
 
-    if (layer.size() != Layer().toPDUByteArray().size())
+    if (layer.size() != SIZE)
         return;
 
     layer >> Vector
@@ -22,7 +22,6 @@
 #ifndef OTP_TRANSFORM_LAYER_HPP
 #define OTP_TRANSFORM_LAYER_HPP
 
-#include <QObject>
 #include <QDateTime>
 #include "pdu_types.hpp"
 #include "pdu_const.hpp"
@@ -41,9 +40,8 @@ namespace OTP::PDU::OTPTransformLayer
  * @brief OTP PDU Layer
  * 
  */
-class Layer : public QObject
+class Layer
 {
-    Q_OBJECT
 public:
     /**
      * @brief Construct a new Layer object
@@ -52,24 +50,20 @@ public:
      * @param System Sytem number
      * @param Timestamp Sample timestamp
      * @param Options Module options
-     * @param parent Parent object
      */
     explicit Layer(pduLength_t PDULength = 0,
             system_t System = 0,
             timestamp_t Timestamp = static_cast<timestamp_t>(QDateTime::currentMSecsSinceEpoch() * 1000),
-            options_t Options = options_t(),
-            QObject *parent = nullptr);
+            options_t Options = options_t());
 
     /**
      * @brief Construct a new Layer object
      * @details Used to dissect an on-the wire message
      * 
      * @param layer Byte array to unpack and dissect
-     * @param parent Parent object
      */
     explicit Layer(
-            PDUByteArray layer,
-            QObject *parent = nullptr);
+            PDUByteArray layer);
 
     /**
      * @brief Is the layer valid
@@ -87,6 +81,22 @@ public:
      */
     PDUByteArray toPDUByteArray() const;
 
+    /**
+     * @brief Pack the layer onto the end of a byte array
+     * @details As transmitted "on-the-wire", allowing a complete message to be packed into a single buffer
+     * 
+     * @param ba Byte array to append to
+     */
+    void toPDUByteArray(PDUByteArray &ba) const;
+
+    /**
+     * @brief Get packed size of the layer
+     * @details Calculated from the layer fields, without packing
+     * 
+     * @return Size in octets
+     */
+    pduLength_t getSize() const { return SIZE; }
+
     /**
      * @brief Unpack a byte array into layer
      * 
@@ -54,6 +54,15 @@ namespace OTP::PDU {
          * 
          */
         const pduLength_t LENGTHOFFSET = static_cast<pduLength_t>(OTP_PACKET_IDENT.size() + sizeof(vector_t) + sizeof(pduLength_t));
+        /**
+         * @brief Layer size
+         * @details Packed size of layer in octets
+         * 
+         */
+        const pduLength_t SIZE = static_cast<pduLength_t>(LENGTHOFFSET
+            + sizeof(quint8) /* Footer Options */ + sizeof(quint8) /* Footer Length */
+            + sizeof(cid_t) + sizeof(folio_t) + sizeof(page_t) + sizeof(page_t)
+            + sizeof(options_t) + sizeof(reserved_t) + NAME_LENGTH);
 
         /**
          * @brief Allowed vectors for this PDU Layer
@@ -88,6 +97,13 @@ namespace OTP::PDU {
          * 
          */
         constexpr pduLength_t LENGTHOFFSET = static_cast<pduLength_t>(sizeof(vector_t) + sizeof(pduLength_t));
+        /**
+         * @brief Layer size
+         * @details Packed size of layer in octets
+         * 
+         */
+        constexpr pduLength_t SIZE = static_cast<pduLength_t>(LENGTHOFFSET
+            + sizeof(system_t) + sizeof(timestamp_t) + sizeof(quint8) /* Options */ + sizeof(reserved_t));
 
         /**
          * @brief Expected value for vector field
@@ -113,6 +129,14 @@ namespace OTP::PDU {
          * 
          */
         constexpr pduLength_t LENGTHOFFSET = static_cast<pduLength_t>(sizeof(vector_t) + sizeof(pduLength_t));
+        /**
+         * @brief Layer size
+         * @details Packed size of layer in octets
+         * 
+         */
+        constexpr pduLength_t SIZE = static_cast<pduLength_t>(LENGTHOFFSET
+            + sizeof(priority_t) + sizeof(group_t) + sizeof(point_t) + sizeof(timestamp_t)
+            + sizeof(options_t) + sizeof(reserved_t));
 
         /**
          * @brief Expected value for vector field
@@ -144,6 +168,12 @@ namespace OTP::PDU {
          * 
          */
         constexpr pduLength_t LENGTHOFFSET = static_cast<pduLength_t>(sizeof(manufacturerID_t) + sizeof(pduLength_t));
+        /**
+         * @brief Layer size
+         * @details Packed size of layer in octets, excluding Additional Fields
+         * 
+         */
+        constexpr pduLength_t SIZE = static_cast<pduLength_t>(LENGTHOFFSET + sizeof(moduleNumber_t));
     }
 
     /**
@@ -157,6 +187,12 @@ namespace OTP::PDU {
          * 
          */
         constexpr pduLength_t LENGTHOFFSET = static_cast<pduLength_t>(sizeof(vector_t) + sizeof(pduLength_t));
+        /**
+         * @brief Layer size
+         * @details Packed size of layer in octets
+         * 
+         */
+        constexpr pduLength_t SIZE = static_cast<pduLength_t>(LENGTHOFFSET + sizeof(reserved_t));
 
         /**
          * @brief Allowed vectors for this PDU Layer
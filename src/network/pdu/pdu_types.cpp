@@ -27,92 +27,44 @@
 
 namespace OTP::PDU {
 
-    PDUByteArray& operator<<(PDUByteArray &l, const quint8 &r)
-    {
-        l.append(static_cast<char>(r));
-        return l;
-    }
-    PDUByteArray& operator<<(PDUByteArray &l, const quint16 &r)
-    {
-        return l << quint8(r >> 8) << quint8(r);
-    }
-    PDUByteArray& operator<<(PDUByteArray &l, const quint32 &r)
-    {
-        return l << quint16(r >> 16) << quint16(r);
-    }
-    PDUByteArray& operator<<(PDUByteArray &l, const quint64 &r)
-    {
-        return l << quint32(r >> 32) << quint32(r);
+    namespace {
+        template <typename T>
+        PDUByteArray& insert(PDUByteArray &l, const T &r)
+        {
+            char data[sizeof(T)];
+            qToBigEndian<T>(r, data);
+            l.append(data, sizeof(T));
+            return l;
+        }
+
+        template <typename A, typename T>
+        A& extract(A &l, T &r)
+        {
+            const auto data = l.read(sizeof(T));
+            r = data ? qFromBigEndian<T>(data) : T(0);
+            return l;
+        }
     }
 
+    PDUByteArray& operator<<(PDUByteArray &l, const quint8 &r) { return insert(l, r); }
+    PDUByteArray& operator<<(PDUByteArray &l, const quint16 &r) { return insert(l, r); }
+    PDUByteArray& operator<<(PDUByteArray &l, const quint32 &r) { return insert(l, r); }
+    PDUByteArray& operator<<(PDUByteArray &l, const quint64 &r) { return insert(l, r); }
 
-    PDUByteArray& operator<<(PDUByteArray &l, const qint8 &r)
-    {
-        l.append(static_cast<char>(r));
-        return l;
-    }
-    PDUByteArray& operator<<(PDUByteArray &l, const qint16 &r)
-    {
-        return l << qint8(r >> 8) << qint8(r);
-    }
-    PDUByteArray& operator<<(PDUByteArray &l, const qint32 &r)
-    {
-        return l << qint16(r >> 16) << qint16(r);
-    }
-    PDUByteArray& operator<<(PDUByteArray &l,  qint64 &r)
-    {
-        return l << qint32(r >> 32) << qint32(r);
-    }
+    PDUByteArray& operator<<(PDUByteArray &l, const qint8 &r) { return insert(l, r); }
+    PDUByteArray& operator<<(PDUByteArray &l, const qint16 &r) { return insert(l, r); }
+    PDUByteArray& operator<<(PDUByteArray &l, const qint32 &r) { return insert(l, r); }
+    PDUByteArray& operator<<(PDUByteArray &l, const qint64 &r) { return insert(l, r); }
 
-    PDUByteArray& operator>>(PDUByteArray &l, quint8 &r)
-    {
-        r = static_cast<quint8>(l.front());
-        l.remove(0, sizeof(quint8));
-        return l;
-    }
-    PDUByteArray& operator>>(PDUByteArray &l, quint16 &r)
-    {
-        r = qFromBigEndian<quint16>(l.data());
-        l.remove(0, sizeof(quint16));
-        return l;
-    }
-    PDUByteArray& operator>>(PDUByteArray &l, quint32 &r)
-    {
-        r = qFromBigEndian<quint32>(l.data());
-        l.remove(0, sizeof(quint32));
-        return l;
-    }
-    PDUByteArray& operator>>(PDUByteArray &l, quint64 &r)
-    {
-        r = qFromBigEndian<quint64>(l.data());
-        l.remove(0, sizeof(quint64));
-        return l;
-    }
+    PDUByteArray& operator>>(PDUByteArray &l, quint8 &r) { return extract(l, r); }
+    PDUByteArray& operator>>(PDUByteArray &l, quint16 &r) { return extract(l, r); }
+    PDUByteArray& operator>>(PDUByteArray &l, quint32 &r) { return extract(l, r); }
+    PDUByteArray& operator>>(PDUByteArray &l, quint64 &r) { return extract(l, r); }
 
-    PDUByteArray& operator>>(PDUByteArray &l, qint8 &r)
-    {
-        r = static_cast<qint8>(l.front());
-        l.remove(0, sizeof(qint8));
-        return l;
-    }
-    PDUByteArray& operator>>(PDUByteArray &l, qint16 &r)
-    {
-        r = qFromBigEndian<qint16>(l.data());
-        l.remove(0, sizeof(qint16));
-        return l;
-    }
-    PDUByteArray& operator>>(PDUByteArray &l, qint32 &r)
-    {
-        r = qFromBigEndian<qint32>(l.data());
-        l.remove(0, sizeof(qint32));
-        return l;
-    }
-    PDUByteArray& operator>>(PDUByteArray &l, qint64 &r)
-    {
-        r = qFromBigEndian<qint64>(l.data());
-        l.remove(0, sizeof(qint64));
-        return l;
-    }
+    PDUByteArray& operator>>(PDUByteArray &l, qint8 &r) { return extract(l, r); }
+    PDUByteArray& operator>>(PDUByteArray &l, qint16 &r) { return extract(l, r); }
+    PDUByteArray& operator>>(PDUByteArray &l, qint32 &r) { return extract(l, r); }
+    PDUByteArray& operator>>(PDUByteArray &l, qint64 &r) { return extract(l, r); }
 
     name_t::name_t() : QByteArray() { fill(0, NAME_LENGTH); }
     name_t::name_t(const QByteArray &ba) : name_t()
@@ -156,10 +108,10 @@ namespace OTP::PDU {
     }
     PDUByteArray& operator>>(PDUByteArray &l, name_t &r)
     {
-        if (l.size() < NAME_LENGTH)
+        const auto data = l.read(NAME_LENGTH);
+        if (!data)
             return l;
-        r = l.left(NAME_LENGTH);
-        l.remove(0, NAME_LENGTH);
+        r = QByteArray(data, NAME_LENGTH);
         return l;
     }
 
@@ -173,8 +125,9 @@ namespace OTP::PDU {
         }
         PDUByteArray& operator>>(PDUByteArray &l, otpIdent_t &r)
         {
-            r = l.left(OTP_PACKET_IDENT.size());
-            l.remove(0, OTP_PACKET_IDENT.size());
+            const auto size = static_cast<int>(OTP_PACKET_IDENT.size());
+            const auto data = l.read(size);
+            r = data ? QByteArray(data, size) : QByteArray();
             return l;
         }
 
@@ -190,8 +143,9 @@ namespace OTP::PDU {
         }
         PDUByteArray& operator>>(PDUByteArray &l, cid_t &r)
         {
-            r = QUuid::fromRfc4122(l.left(r.toRfc4122().length()));
-            l.remove(0, r.toRfc4122().length());
+            constexpr int size = 16;
+            const auto data = l.read(size);
+            r = data ? QUuid::fromRfc4122(QByteArray::fromRawData(data, size)) : QUuid();
             return l;
         }
 
@@ -447,9 +401,8 @@ namespace OTP::PDU {
         }
         PDUByteArray& operator>>(PDUByteArray &l, additional_t &r)
         {
-            r.clear();
-            r.append(l);
-            l.clear();
+            const auto size = l.remaining();
+            r = QByteArray(l.read(size), size);
             return l;
         }
 
@@ -489,55 +442,15 @@ namespace OTP::PDU {
             return l << qint32(r >> 32) << qint32(r);
         }
 
-        additional_t& operator>>(additional_t &l, quint8 &r)
-        {
-            r = qFromBigEndian<quint8>(l.data());
-            l.remove(0, sizeof(r));
-            return l;
-        }
-        additional_t& operator>>(additional_t &l, quint16 &r)
-        {
-            r = qFromBigEndian<quint16>(l.data());
-            l.remove(0, sizeof(r));
-            return l;
-        }
-        additional_t& operator>>(additional_t &l, quint32 &r)
-        {
-            r = qFromBigEndian<quint32>(l.data());
-            l.remove(0, sizeof(r));
-            return l;
-        }
-        additional_t& operator>>(additional_t &l, quint64 &r)
-        {
-            r = qFromBigEndian<quint64>(l.data());
-            l.remove(0, sizeof(r));
-            return l;
-        }
+        additional_t& operator>>(additional_t &l, quint8 &r) { return extract(l, r); }
+        additional_t& operator>>(additional_t &l, quint16 &r) { return extract(l, r); }
+        additional_t& operator>>(additional_t &l, quint32 &r) { return extract(l, r); }
+        additional_t& operator>>(additional_t &l, quint64 &r) { return extract(l, r); }
 
-        additional_t& operator>>(additional_t &l, qint8 &r)
-        {
-            r = qFromBigEndian<qint8>(l.data());
-            l.remove(0, sizeof(r));
-            return l;
-        }
-        additional_t& operator>>(additional_t &l, qint16 &r)
-        {
-            r = qFromBigEndian<qint16>(l.data());
-            l.remove(0, sizeof(r));
-            return l;
-        }
-        additional_t& operator>>(additional_t &l, qint32 &r)
-        {
-            r = qFromBigEndian<qint32>(l.data());
-            l.remove(0, sizeof(r));
-            return l;
-        }
-        additional_t& operator>>(additional_t &l, qint64 &r)
-        {
-            r = qFromBigEndian<qint64>(l.data());
-            l.remove(0, sizeof(r));
-            return l;
-        }
+        additional_t& operator>>(additional_t &l, qint8 &r) { return extract(l, r); }
+        additional_t& operator>>(additional_t &l, qint16 &r) { return extract(l, r); }
+        additional_t& operator>>(additional_t &l, qint32 &r) { return extract(l, r); }
+        additional_t& operator>>(additional_t &l, qint64 &r) { return extract(l, r); }
     }
 
     namespace OTPModuleAdvertisementLayer {
@@ -551,7 +464,8 @@ namespace OTP::PDU {
         }
         PDUByteArray& operator>>(PDUByteArray &l, list_t &r)
         {
-            while (l.size() >= list_t::value_type().getSize())
+            const auto itemSize = list_t::value_type().getSize();
+            while (l.remaining() >= itemSize)
             {
                 list_t::value_type item;
                 l >> item;
@@ -595,7 +509,8 @@ namespace OTP::PDU {
         }
         PDUByteArray& operator>>(PDUByteArray &l, list_t &r)
         {
-            while (l.size() >= list_t::value_type().getSize())
+            const auto itemSize = list_t::value_type().getSize();
+            while (l.remaining() >= itemSize)
             {
                 list_t::value_type item;
                 l >> item;
@@ -616,7 +531,7 @@ namespace OTP::PDU {
         }
         PDUByteArray& operator>>(PDUByteArray &l, list_t &r)
         {
-            while (l.size())
+            while (l.remaining())
             {
                 list_t::value_type item;
                 l >> item;
@@ -28,6 +28,7 @@
 #include <QtEndian>
 #include <QHostAddress>
 #include <bitset>
+#include <algorithm>
 
 #if defined MAKE_OTP_LIB
     /**
@@ -141,12 +142,42 @@ namespace OTP::PDU
      * @brief Byte array type
      * @details Packed byte array, primary datatype of undissected packed OTP data
      * Stored in network byte order
+     *
+     * Values are extracted with operator>> via a read cursor, rather than removing them from the front of the array,
+     * so unpacking a PDU is a single linear pass with no reallocation
      * 
      */
     class PDUByteArray : public QByteArray
     {
     public:
-        PDUByteArray() : QByteArray() {}
+        PDUByteArray() : QByteArray(), readIndex(0) {}
+
+        /**
+         * @brief Construct a new PDU Byte Array object, without copying, from raw data
+         * @details The data must outlive the returned array
+         * 
+         * @param data Pointer to raw data
+         * @param size Size of raw data
+         * @return Byte array referencing the raw data
+         */
+        static PDUByteArray fromRawData(const char *data, int size) {
+            return PDUByteArray(QByteArray::fromRawData(data, size));
+        }
+
+        /**
+         * @brief Construct a new PDU Byte Array object, without copying, from part of a byte array
+         * @details As QByteArray::mid(), the byte array must outlive the returned array
+         * 
+         * @param ba Source byte array
+         * @param position Start position within source
+         * @param length Number of bytes, or all remaining if -1
+         * @return Byte array referencing the source, truncated to the bytes available
+         */
+        static PDUByteArray fromRawData(const QByteArray &ba, int position, int length = -1) {
+            const int available = std::max(0, static_cast<int>(ba.size()) - position);
+            if ((length < 0) || (length > available)) length = available;
+            return fromRawData(ba.constData() + std::min(position, static_cast<int>(ba.size())), length);
+        }
 
         /**
          * @brief Return size of array
@@ -156,6 +187,45 @@ namespace OTP::PDU
         inline pduLength_t size() const {
             return static_cast<pduLength_t>(QByteArray::size());
         }
+
+        /**
+         * @brief Return number of bytes not yet extracted
+         * 
+         * @return pduLength_t
+         */
+        inline pduLength_t remaining() const {
+            return static_cast<pduLength_t>(std::max(0, static_cast<int>(QByteArray::size()) - readIndex));
+        }
+
+        /**
+         * @brief Clear the array and reset the read cursor
+         * 
+         */
+        void clear() {
+            QByteArray::clear();
+            readIndex = 0;
+        }
+
+        /**
+         * @brief Extract raw bytes from the read cursor
+         * @details Bounds checked, when insufficient bytes remain the cursor is moved to the end
+         * 
+         * @param length Number of bytes to extract
+         * @return Pointer to the bytes, or nullptr if fewer than length remain
+         */
+        const char *read(int length) {
+            if (length > static_cast<int>(QByteArray::size()) - readIndex) {
+                readIndex = QByteArray::size();
+                return nullptr;
+            }
+            const auto ret = constData() + readIndex;
+            readIndex += length;
+            return ret;
+        }
+
+    private:
+        explicit PDUByteArray(const QByteArray &ba) : QByteArray(ba), readIndex(0) {}
+        int readIndex;
     };
     PDUByteArray& operator<<(PDUByteArray &l, const quint8 &r);
     PDUByteArray& operator<<(PDUByteArray &l, const quint16 &r);
@@ -1072,18 +1142,40 @@ namespace OTP::PDU
          * @brief Additional Fields Determined by Vector and Module Number
          * @details Packed byte array reprecenting the tail of OTP Module Layer 
          * 
+         * As PDUByteArray, values are extracted with operator>> via a bounds checked read cursor
+         * 
          */
         class additional_t : public QByteArray
         {
         public:
-            additional_t() : QByteArray() {}
+            additional_t() : QByteArray(), readIndex(0) {}
 
             /**
              * @brief Construct a new Additional Fields object
              * 
              * @param ba Additional Fields ByteArray
              */
-            additional_t(const QByteArray &ba) : QByteArray(ba) {}
+            additional_t(const QByteArray &ba) : QByteArray(ba), readIndex(0) {}
+
+            /**
+             * @brief Extract raw bytes from the read cursor
+             * @details Bounds checked, when insufficient bytes remain the cursor is moved to the end
+             * 
+             * @param length Number of bytes to extract
+             * @return Pointer to the bytes, or nullptr if fewer than length remain
+             */
+            const char *read(int length) {
+                if (length > static_cast<int>(QByteArray::size()) - readIndex) {
+                    readIndex = static_cast<int>(QByteArray::size());
+                    return nullptr;
+                }
+                const auto ret = constData() + readIndex;
+                readIndex += length;
+                return ret;
+            }
+
+        private:
+            int readIndex;
         };
         PDUByteArray& operator<<(PDUByteArray &l, const additional_t &r);
         PDUByteArray& operator>>(PDUByteArray &l, additional_t &r);
@@ -15,6 +15,8 @@ void TEST_OTP::PDU::OTPAdvertisementLayer::initTestCase()
 {
     DefaultPDUByteArray = DefaultLayer.toPDUByteArray();
     QCOMPARE(DefaultPDUByteArray.size(), PDULength);
+    QCOMPARE(DefaultPDUByteArray.size(), OTP::PDU::OTPAdvertisementLayer::SIZE);
+    QCOMPARE(DefaultLayer.getSize(), DefaultPDUByteArray.size());
 }
 
 void TEST_OTP::PDU::OTPAdvertisementLayer::isValid()
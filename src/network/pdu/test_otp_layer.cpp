@@ -15,6 +15,8 @@ void TEST_OTP::PDU::OTPLayer::initTestCase()
 {
     DefaultPDUByteArray = DefaultLayer.toPDUByteArray();
     QCOMPARE(DefaultPDUByteArray.size(), PDULength);
+    QCOMPARE(DefaultPDUByteArray.size(), OTP::PDU::OTPLayer::SIZE);
+    QCOMPARE(DefaultLayer.getSize(), DefaultPDUByteArray.size());
 }
 
 void TEST_OTP::PDU::OTPLayer::isValid()
@@ -61,6 +63,46 @@ void TEST_OTP::PDU::OTPLayer::toFromPDUByteArray()
     }
 }
 
+void TEST_OTP::PDU::OTPLayer::fromRawData()
+{
+    for (const auto &example : TEST_OTP::MESSAGES::APPENDIX_B::Examples)
+    {
+        PDUByteArray pdu;
+        pdu.append(example.first.mid(PDUOctlet, DefaultPDUByteArray.size()));
+
+        /* Unpacking from a view matches unpacking from a copy */
+        auto view = PDUByteArray::fromRawData(example.first, PDUOctlet, DefaultPDUByteArray.size());
+        QVERIFY(view.constData() == example.first.constData() + PDUOctlet);
+        QCOMPARE(view, pdu);
+        Layer layer(view);
+        QVERIFY(layer.isValid());
+        QCOMPARE(layer.toPDUByteArray(), pdu);
+
+        /* Extraction advances the read cursor, without modifying the array */
+        quint32 value;
+        view >> value;
+        QCOMPARE(view.size(), DefaultPDUByteArray.size());
+        QCOMPARE(view.remaining(), DefaultPDUByteArray.size() - sizeof(value));
+
+        /* Reads past the end are bounded */
+        while (view.remaining())
+            view >> value;
+        QCOMPARE(value, quint32(0));
+        QVERIFY(view.read(1) == nullptr);
+    }
+
+    /* Additional fields are extracted through the same bounded cursor */
+    OTP::PDU::OTPModuleLayer::additional_t additional;
+    additional << quint16(0x1234) << quint8(0x56);
+    quint16 value16;
+    quint32 value32;
+    additional >> value16 >> value32;
+    QCOMPARE(value16, quint16(0x1234));
+    QCOMPARE(value32, quint32(0));
+    QCOMPARE(static_cast<int>(additional.size()), 3);
+    QVERIFY(additional.read(1) == nullptr);
+}
+
 void TEST_OTP::PDU::OTPLayer::packetIdent()
 {
     const unsigned int octlet = 0;
@@ -21,6 +21,7 @@ namespace TEST_OTP::PDU
 
         void isValid();
         void toFromPDUByteArray();
+        void fromRawData();
         void packetIdent();
         void vector();
         void length();
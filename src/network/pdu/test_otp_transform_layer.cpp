@@ -1,6 +1,7 @@
 #include "test_otp_transform_layer.hpp"
 #include "network/messages/test_appendix_B.hpp"
 #include "test_otp_helper.hpp"
+#include "network/pdu/otp_layer.hpp"
 
 const size_t PDUOctlet = 79;
 const size_t PDULength = (96+1) - PDUOctlet;
@@ -15,6 +16,8 @@ void TEST_OTP::PDU::OTPTransformLayer::initTestCase()
 {
     DefaultPDUByteArray = DefaultLayer.toPDUByteArray();
     QCOMPARE(DefaultPDUByteArray.size(), PDULength);
+    QCOMPARE(DefaultPDUByteArray.size(), OTP::PDU::OTPTransformLayer::SIZE);
+    QCOMPARE(DefaultLayer.getSize(), DefaultPDUByteArray.size());
 }
 
 void TEST_OTP::PDU::OTPTransformLayer::isValid()
@@ -53,6 +56,14 @@ void TEST_OTP::PDU::OTPTransformLayer::toFromPDUByteArray()
                 {
                     Layer layer(pdu);
                     QVERIFY(layer.isValid());
+
+                    /* Packing onto an existing array, after the OTP Layer */
+                    PDUByteArray otpLayer;
+                    otpLayer.append(example.first.left(PDUOctlet));
+                    PDUByteArray ba;
+                    OTP::PDU::OTPLayer::Layer(otpLayer).toPDUByteArray(ba);
+                    layer.toPDUByteArray(ba);
+                    QCOMPARE(QByteArray(ba), example.first.left(PDUOctlet + DefaultPDUByteArray.size()));
                 }
                 while (pdu.size())
                 {
@@ -37,8 +37,11 @@
 
 #include "component.hpp"
 #include "bugs.hpp"
+#include "triplebuffer.hpp"
 #include <QCoreApplication>
 #include <QObject>
+#include <array>
+#include <limits>
 #include <memory>
 #include "types.hpp"
 #include "network/messages/messages.hpp"
@@ -141,6 +144,26 @@ namespace OTP
          */
         void setTransformMsgRate(std::chrono::milliseconds value)
             { transformMsgTimer.setInterval(std::clamp(value, OTP_TRANSFORM_TIMING_MIN, OTP_TRANSFORM_TIMING_MAX)); }
+
+        /**
+         * @brief Get producers transform message delta mode
+         * @details When enabled, only points whose module data has changed are transmitted at the transform messgage rate,
+         *          with a Full Point Set for each System transmitted every
+         *          OTP::OTP_TRANSFORM_FULL_POINT_SET_TIMING_MIN -> OTP::OTP_TRANSFORM_FULL_POINT_SET_TIMING_MAX
+         * @return true Only changed points are transmitted between Full Point Sets
+         * @return false Every point is transmitted at the transform messgage rate
+         */
+        bool getTransformDeltaMode() const { return transformDeltaMode; }
+
+        /**
+         * @brief Set producers transform message delta mode
+         * @details When enabled, only points whose module data has changed are transmitted at the transform messgage rate,
+         *          with a Full Point Set for each System transmitted every
+         *          OTP::OTP_TRANSFORM_FULL_POINT_SET_TIMING_MIN -> OTP::OTP_TRANSFORM_FULL_POINT_SET_TIMING_MAX
+         *
+         * @param value Transmit only changed points between Full Point Sets
+         */
+        void setTransformDeltaMode(bool value) { transformDeltaMode = value; }
     /**@}*/ // Transmission Rates
 
     /** 
@@ -192,6 +215,16 @@ namespace OTP
 
     /**@}*/ // Local Groups
 
+    /** 
+     * @name Local Systems
+     * 
+     * @{
+     */  
+    public:
+        void removeLocalSystem(system_t system) override;
+
+    /**@}*/ // Local Systems
+
     /** 
      * @name Local Point
      * 
@@ -800,25 +833,57 @@ namespace OTP
 
     private:
         void setupSender(std::chrono::milliseconds transformRate);
-        QTimer transformMsgTimer;
+        CLOCK::Timer transformMsgTimer;
 
-        bool receiveOTPTransformMessage(const QNetworkDatagram &datagram) override;
-        bool receiveOTPModuleAdvertisementMessage(const QNetworkDatagram &datagram) override;
-        bool receiveOTPNameAdvertisementMessage(const QNetworkDatagram &datagram) override;
-        bool receiveOTPSystemAdvertisementMessage(const QNetworkDatagram &datagram) override;
+        bool receiveOTPTransformMessage(const Packet &packet) override;
+        bool receiveOTPModuleAdvertisementMessage(const Packet &packet) override;
+        bool receiveOTPNameAdvertisementMessage(const Packet &packet) override;
+        bool receiveOTPSystemAdvertisementMessage(const Packet &packet) override;
 
-        QTimer* getBackoffTimer(std::chrono::milliseconds maximum);
+        CLOCK::Timer* getBackoffTimer(std::chrono::milliseconds maximum);
         void sendOTPNameAdvertisementMessage(QHostAddress destinationAddr, MESSAGES::OTPNameAdvertisementMessage::folio_t folio);
         void sendOTPSystemAdvertisementMessage(QHostAddress destinationAddr, MESSAGES::OTPNameAdvertisementMessage::folio_t folio);
-        void sendOTPTransformMessage(system_t system);
+        void sendOTPTransformMessage(const QList<system_t> &systems);
         PDU::OTPLayer::folio_t TransformMessage_Folio = 0;
 
+    protected:
+        /**
+         * @internal
+         * @brief Build the next transform folio for a system
+         * @details In delta mode only points changed since last sent are included,
+         * unless a full point set is due
+         *
+         * @param system System number
+         * @return Datagrams to send, or none if there is nothing to send
+         */
+        QList<QNetworkDatagram> getOTPTransformMessageDatagrams(system_t system);
+
+    private:
+        /**
+         * @internal
+         * @brief Packed points, reused between transform messages
+         * @details A point is removed when any of its module data changes, and all are dropped when the requested modules change.
+         * Points not in the cache are those changed since last sent.
+         */
+        struct {
+            QVector<PDU::OTPModuleLayer::ident_t> modules;
+            QMap<address_t, QByteArray> points;
+            QMap<system_t, CLOCK::ticks_t> lastFullPointSet;
+        } transformCache;
+        bool transformDeltaMode = false;
+
     }; // OTP Producer component
 
     /**
      * @brief OTP Consumer component
      * @details <b>Consumer:</b> A Consumer is the intended target of information from a Producer.
      * 
+     * Standard module getters read a snapshot published after each applied folio, without locking,
+     * so may be called from any thread without blocking reception.
+     * 
+     * Renderers needing every point of a system from the same folio should read its frame, from getFrame().
+     * Many addresses can be queried at once, from the same snapshot, with getModuleValues().
+     * 
      */
     class OTP_LIB_EXPORT Consumer : public Component
     {
@@ -860,6 +925,87 @@ namespace OTP
 
     /**@}*/ // Local Systems
 
+    /** 
+     * @name Transform Folios
+     * 
+     * @{
+     */  
+    public:
+        /**
+         * @brief Get consumers partial folio mode
+         * @details When enabled, the points of each page of a multi-page transform folio are applied as soon as the page arrives,
+         *          rather than once every page of the folio has been received
+         * @return true Pages are applied as they arrive
+         * @return false Pages are applied once the folio is complete
+         */
+        bool getTransformPartialFolioMode() const { return transformPartialFolioMode; }
+
+        /**
+         * @brief Set consumers partial folio mode
+         * @details When enabled, the points of each page of a multi-page transform folio are applied as soon as the page arrives,
+         *          rather than once every page of the folio has been received
+         *
+         * @param value Apply pages as they arrive
+         */
+        void setTransformPartialFolioMode(bool value) { transformPartialFolioMode = value; }
+
+        /**
+         * @brief Has the last transform folio for a system been applied in full
+         * @details Only pages of a folio applied early, in partial folio mode, leave a folio incomplete
+         *
+         * @param cid Component IDentifier of folio source
+         * @param system System of folio
+         * @return true All pages of the last folio have been applied
+         * @return false Only some pages of the last folio have been applied
+         */
+        bool isTransformFolioComplete(cid_t cid, system_t system) const
+            { return !transformPartialFolios.contains({cid, system}); }
+
+        /**
+         * @brief Get the latency saved by partial folio mode
+         * @details The time between a page being applied early and its folio completing, averaged over all such pages
+         *
+         * @param system System of folio
+         * @return Mean latency saved per page, or zero if no pages have been applied early
+         */
+        std::chrono::milliseconds getTransformPartialFolioLatencySaved(system_t system) const;
+
+    /**@}*/ // Transform Folios
+
+    /** 
+     * @name Merging
+     * 
+     * @{
+     */  
+    public:
+        /*! Creates a type name for OTP::Container::mergeStatistics_t */ 
+        typedef Container::mergeStatistics_t mergeStatistics_t;
+
+        /**
+         * @brief Get the number of merge worker threads
+         * @details Winning sources for all systems are merged by a shared pool of workers
+         *
+         * @return Worker threads
+         */
+        int getMergeWorkers() const { return otpNetwork->getMergeWorkers(); }
+
+        /**
+         * @brief Set the number of merge worker threads
+         * @details Winning sources for all systems are merged by a shared pool of workers
+         *
+         * @param value Worker threads, at least 1
+         */
+        void setMergeWorkers(int value) { otpNetwork->setMergeWorkers(value); }
+
+        /**
+         * @brief Get the merge statistics
+         *
+         * @return Merge statistics
+         */
+        mergeStatistics_t getMergeStatistics() const { return otpNetwork->getMergeStatistics(); }
+
+    /**@}*/ // Merging
+
     /** 
      * @name Standard Modules - Helper Functions
      * 
@@ -874,20 +1020,22 @@ namespace OTP
          * @tparam T Return type
          * @tparam T2 Module details type
          * @param[out] module Module type specfics details
+         * @param snapshot Network snapshot to query
          * @param cid Componet IDenifier
          * @param address Address to query
          * @param respectRelative Respect reference frames, if any
          * @return T Details with common details
          */
         template <class T, class T2>
-        T getValueHelper(T2 &, cid_t cid, address_t address, bool respectRelative = true) const;
+        T getValueHelper(T2 &, const networkSnapshot_t &snapshot, cid_t cid, address_t address, bool respectRelative = true) const;
 
         /**
          * @internal
          * @brief Helper function - Get a points current T from all known sources
+         * @details All sources are read from a single snapshot
          *
          * @tparam T Point detail type
-         * @param getFunc Funtion to obtain individual componets values
+         * @param getFunc Funtion to obtain individual componets values, from the shared snapshot
          * @param address Address to query
          * @param axis Axis to query
          * @param respectRelative Respect reference frames?
@@ -896,7 +1044,7 @@ namespace OTP
          */
         template <class T>
         QMap<cid_t, T> getValuesHelper(
-            std::function<T(cid_t cid, address_t address, axis_t axis, bool respectRelative)> getFunc,
+            std::function<T(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative)> getFunc,
             address_t address, 
             axis_t axis, 
             bool respectRelative = true, 
@@ -1386,6 +1534,21 @@ namespace OTP
          * @return Addresses reference frame
          */
         ReferenceFrame_t getReferenceFrame(address_t address) const;
+    private:
+        /**
+         * @internal
+         * @brief Getters reading from a snapshot already held
+         * @details So each public getter takes a single snapshot, even when it also looks up the winning source
+         * 
+         */
+        PositionValue_t getPosition(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const;
+        PositionVelocity_t getPositionVelocity(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const;
+        PositionAcceleration_t getPositionAcceleration(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const;
+        RotationValue_t getRotation(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const;
+        RotationVelocity_t getRotationVelocity(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const;
+        RotationAcceleration_t getRotationAcceleration(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis, bool respectRelative) const;
+        Scale_t getScale(const networkSnapshot_t &snapshot, cid_t cid, address_t address, axis_t axis) const;
+        ReferenceFrame_t getReferenceFrame(const networkSnapshot_t &snapshot, cid_t cid, address_t address) const;
     signals:
         /**
          * @brief Emitted when the address has an updated reference frame
@@ -1397,13 +1560,185 @@ namespace OTP
 
     /**@}*/ // Standard Modules - Reference Frame
 
+    /** 
+     * @name Standard Modules - Batch
+     * 
+     * @{
+     */  
+    public:
+        /**
+         * @brief Values of each axis, indexed by axis_t
+         * 
+         */
+        typedef std::array<qint64, axis_t::count> XYZ_t;
+
+        /**
+         * @brief Get the winning values of a module, for many addresses
+         * @details All addresses are read from one snapshot, so values are consistent with each other.
+         * Avoids the per axis getters' validation, unit strings and result structures.
+         * 
+         * Positions are in micrometres, whatever the scaling of the source. Other values are as received.
+         * Addresses without a winning source are zeroed.
+         *
+         * @param module Module value to get, reference frames are not supported
+         * @param addresses First of the addresses to query
+         * @param count Number of addresses to query
+         * @param[out] values Caller provided array, with space for count values
+         * @param respectRelative Respect reference frames?
+         * @return Number of addresses with a winning source
+         */
+        int getModuleValues(
+                MODULES::STANDARD::VALUES::moduleValue_t module,
+                const address_t *addresses,
+                int count,
+                XYZ_t *values,
+                bool respectRelative = true) const;
+
+        /**
+         * @overload
+         * @brief Get the winning values of a module, for many addresses
+         *
+         * @param module Module value to get, reference frames are not supported
+         * @param addresses Addresses to query
+         * @param[out] values Caller provided array, with space for a value per address
+         * @param respectRelative Respect reference frames?
+         * @return Number of addresses with a winning source
+         */
+        int getModuleValues(
+                MODULES::STANDARD::VALUES::moduleValue_t module,
+                const QVector<address_t> &addresses,
+                XYZ_t *values,
+                bool respectRelative = true) const
+            { return getModuleValues(module, addresses.constData(), static_cast<int>(addresses.size()), values, respectRelative); }
+
+    /**@}*/ // Standard Modules - Batch
+
+    /** 
+     * @name Frames
+     * 
+     * @{
+     */  
+    public:
+        /**
+         * @brief Winning values of a point, within a frame
+         * 
+         */
+        typedef struct FramePoint_s
+        {
+            address_t address; /**< Point address */
+            cid_t sourceCID; /**< Winning source component */
+            priority_t priority; /**< Point priority */
+            /**
+             * @brief Standard module data of the winning source
+             * @details Position, rotation and their velocity/acceleration are relative to the world,
+             * with the reference frames the point is relative to already applied.
+             * The reference frame module is as received.
+             */
+            pointDetails::standardModules_t standardModules;
+        } FramePoint_t;
+
+        /**
+         * @brief Winning values of every point in a system
+         * @details Points are ordered by address
+         * 
+         */
+        typedef struct Frame_s
+        {
+            system_t system; /**< System of frame */
+            quint64 sequence = 0; /**< Increased with each frame of the system, zero if none has been published */
+            QVector<FramePoint_t> points; /**< Winning values of each point */
+        } Frame_t;
+
+        /**
+         * @brief Read access to a frame
+         * @details The frame remains valid, and unchanged, for the lifetime of the reader
+         */
+        typedef tripleBuffer_t<Frame_t>::reader_t FrameReader_t;
+
+        /**
+         * @brief Get the latest frame of a system
+         * @details Wait free and thread safe, the frame is not copied.
+         * 
+         * A new frame is published after each applied transform folio, or page in partial folio mode,
+         * and after any other change to the system's points.
+         * 
+         * Readers should be released once the frame is consumed,
+         * as frames of a system are only replaced while at least one older frame is not being read.
+         *
+         * @param system System of frame
+         * @return Frame reader
+         */
+        FrameReader_t getFrame(system_t system) const { return frames[system].read(); }
+    signals:
+        /**
+         * @brief Emitted when a new frame of a system is published
+         *
+         * @param system System of frame
+         */
+        void updatedFrame(OTP::system_t system);
+
+    private:
+        /**
+         * @internal
+         * @brief Publish new frames, from the published snapshot
+         * @details Systems that can not be published, as older frames are still being read, are retried later
+         *
+         * @param systems Changed systems
+         */
+        void publishFrames(const QList<system_t> &systems);
+        std::array<tripleBuffer_t<Frame_t>, std::numeric_limits<quint8>::max() + 1> frames;
+        QSet<system_t> framesPending;
+        CLOCK::Timer framesRetryTimer;
+
+    /**@}*/ // Frames
+
     private:
         void setupListener() override;
 
-        bool receiveOTPTransformMessage(const QNetworkDatagram &datagram) override;
-        bool receiveOTPModuleAdvertisementMessage(const QNetworkDatagram &datagram) override;
-        bool receiveOTPNameAdvertisementMessage(const QNetworkDatagram &datagram) override;
-        bool receiveOTPSystemAdvertisementMessage(const QNetworkDatagram &datagram) override;
+        bool receiveOTPTransformMessage(const Packet &packet) override;
+        bool receiveOTPModuleAdvertisementMessage(const Packet &packet) override;
+        bool receiveOTPNameAdvertisementMessage(const Packet &packet) override;
+        bool receiveOTPSystemAdvertisementMessage(const Packet &packet) override;
+
+        /**
+         * @internal
+         * @brief Apply the points of transform message pages
+         * @details All pages must be from the same folio, and are applied as a single batch.
+         * Changes are not notified until published, by notifyOTPTransformChanges()
+         *
+         * @param pages Decoded pages
+         * @param sender Address of pages source
+         * @return Changed points
+         */
+        QVector<Container::pointChange_t> applyOTPTransformMessage(
+                const QVector<const MESSAGES::OTPTransformMessage::Message*> &pages,
+                const QHostAddress &sender);
+
+        /**
+         * @internal
+         * @brief Publish applied transform message pages, then notify their changes
+         *
+         * @param cid Component IDentifier of pages source
+         * @param changes Changed points
+         */
+        void notifyOTPTransformChanges(cid_t cid, const QVector<Container::pointChange_t> &changes);
+
+        /**
+         * @internal
+         * @brief Received transform message page
+         */
+        typedef struct {
+            std::shared_ptr<MESSAGES::OTPTransformMessage::Message> message; /**< Decoded page */
+            CLOCK::ticks_t applied = CLOCK::never; /**< When the page was applied, if before its folio completed */
+        } transformPage_t;
+        folioReassembler_t<transformPage_t> transformFolios{OTP_TRANSFORM_DATA_LOSS_TIMEOUT};
+        bool transformPartialFolioMode = false;
+        QMap<std::pair<cid_t, system_t>, PDU::OTPLayer::folio_t> transformPartialFolios;
+        struct partialFolioLatency_t {
+            quint64 pages = 0;
+            std::chrono::nanoseconds saved = std::chrono::nanoseconds(0);
+        };
+        QMap<system_t, partialFolioLatency_t> transformPartialFolioLatency;
 
         void sendOTPModuleAdvertisementMessage();
         PDU::OTPLayer::folio_t ModuleAdvertisementMessage_Folio = 0;
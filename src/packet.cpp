@@ -0,0 +1,254 @@
+/**
+ * @file        packet.cpp
+ * @brief       Pooled, reference counted, network packet buffers
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2024 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#include "packet.hpp"
+#include <QtEndian>
+#include <cstring>
+
+using namespace OTP;
+
+/* Packet */
+Packet::Packet(const Packet &other) : block(other.block)
+{
+    if (block) block->refs.fetch_add(1, std::memory_order_relaxed);
+}
+
+Packet::Packet(Packet &&other) noexcept : block(other.block)
+{
+    other.block = nullptr;
+}
+
+Packet& Packet::operator=(const Packet &other)
+{
+    if (block == other.block) return *this;
+    if (other.block) other.block->refs.fetch_add(1, std::memory_order_relaxed);
+    unref();
+    block = other.block;
+    return *this;
+}
+
+Packet& Packet::operator=(Packet &&other) noexcept
+{
+    if (this == &other) return *this;
+    unref();
+    block = other.block;
+    other.block = nullptr;
+    return *this;
+}
+
+Packet::~Packet()
+{
+    unref();
+}
+
+void Packet::unref()
+{
+    if (!block) return;
+    if (block->refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+        block->pool->release(block);
+    block = nullptr;
+}
+
+Packet Packet::fromDatagram(const QNetworkDatagram &datagram)
+{
+    const auto payload = datagram.data();
+    if (payload.size() > capacity) return Packet();
+
+    auto packet = PacketPool::instance().acquire();
+    packet.setData(payload.constData(), payload.size());
+    packet.setSender(datagram.senderAddress(), static_cast<quint16>(datagram.senderPort()));
+    packet.setDestination(datagram.destinationAddress(), static_cast<quint16>(datagram.destinationPort()));
+    return packet;
+}
+
+const char* Packet::constData() const
+{
+    return block ? block->data.data() : nullptr;
+}
+
+char* Packet::data()
+{
+    return block ? block->data.data() : nullptr;
+}
+
+int Packet::size() const
+{
+    return block ? block->size : 0;
+}
+
+void Packet::resize(int size)
+{
+    if (!block) return;
+    block->size = std::clamp(size, 0, capacity);
+}
+
+bool Packet::setData(const char *data, int size)
+{
+    if (!block || (size < 0) || (size > capacity)) return false;
+    std::memcpy(block->data.data(), data, static_cast<size_t>(size));
+    block->size = size;
+    return true;
+}
+
+QHostAddress Packet::senderAddress() const
+{
+    return block ? toHostAddress(block->sender) : QHostAddress();
+}
+
+quint16 Packet::senderPort() const
+{
+    return block ? block->senderPort : 0;
+}
+
+QHostAddress Packet::destinationAddress() const
+{
+    return block ? toHostAddress(block->destination) : QHostAddress();
+}
+
+void Packet::setSender(const QHostAddress &address, quint16 port)
+{
+    if (!block) return;
+    block->sender = fromHostAddress(address);
+    block->senderPort = port;
+}
+
+quint16 Packet::destinationPort() const
+{
+    return block ? block->destinationPort : 0;
+}
+
+void Packet::setDestination(const QHostAddress &address, quint16 port)
+{
+    if (!block) return;
+    block->destination = fromHostAddress(address);
+    block->destinationPort = port;
+}
+
+QNetworkDatagram Packet::toQNetworkDatagram() const
+{
+    QNetworkDatagram ret(QByteArray(constData(), size()), destinationAddress(), destinationPort());
+    ret.setSender(senderAddress(), senderPort());
+    return ret;
+}
+
+QHostAddress Packet::toHostAddress(const address_t &address)
+{
+    switch (address.family)
+    {
+        case 4: return QHostAddress(qFromBigEndian<quint32>(address.octets.data()));
+        case 6: return QHostAddress(address.octets.data());
+        default: return QHostAddress();
+    }
+}
+
+Packet::address_t Packet::fromHostAddress(const QHostAddress &address)
+{
+    address_t ret;
+    switch (address.protocol())
+    {
+        case QAbstractSocket::IPv4Protocol:
+        {
+            ret.family = 4;
+            qToBigEndian<quint32>(address.toIPv4Address(), ret.octets.data());
+        } break;
+
+        case QAbstractSocket::IPv6Protocol:
+        {
+            ret.family = 6;
+            const auto ipv6 = address.toIPv6Address();
+            std::memcpy(ret.octets.data(), &ipv6, ret.octets.size());
+        } break;
+
+        default: break;
+    }
+    return ret;
+}
+
+/* Packet Pool */
+PacketPool::PacketPool(int slabSize) : slabSize(std::max(slabSize, 1))
+{
+    grow();
+}
+
+PacketPool::~PacketPool()
+{
+    QMutexLocker lock(&mutex);
+    if (freeCount != static_cast<quint64>(slabs.size()) * static_cast<quint64>(slabSize))
+        qDebug() << "PacketPool - Destroyed with packets still in use";
+}
+
+PacketPool& PacketPool::instance()
+{
+    // Never destroyed, packets may outlive static destruction
+    static auto pool = new PacketPool();
+    return *pool;
+}
+
+Packet PacketPool::acquire()
+{
+    QMutexLocker lock(&mutex);
+    if (!freeList) grow();
+
+    auto block = freeList;
+    freeList = block->next;
+    freeCount--;
+    lock.unlock();
+
+    block->next = nullptr;
+    block->size = 0;
+    block->sender = Packet::address_t();
+    block->senderPort = 0;
+    block->destination = Packet::address_t();
+    block->destinationPort = 0;
+    block->refs.store(1, std::memory_order_relaxed);
+    return Packet(block);
+}
+
+void PacketPool::release(Packet::block_t *block)
+{
+    QMutexLocker lock(&mutex);
+    block->next = freeList;
+    freeList = block;
+    freeCount++;
+}
+
+void PacketPool::grow()
+{
+    std::unique_ptr<Packet::block_t[]> slab(new Packet::block_t[static_cast<size_t>(slabSize)]);
+    for (int n = 0; n < slabSize; n++)
+    {
+        slab[n].pool = this;
+        slab[n].next = freeList;
+        freeList = &slab[n];
+    }
+    freeCount += static_cast<quint64>(slabSize);
+    slabs.push_back(std::move(slab));
+}
+
+PacketPool::statistics_t PacketPool::getStatistics() const
+{
+    QMutexLocker lock(&mutex);
+    statistics_t ret;
+    ret.slabs = slabs.size();
+    ret.blocks = static_cast<quint64>(slabs.size()) * static_cast<quint64>(slabSize);
+    ret.free = freeCount;
+    return ret;
+}
@@ -0,0 +1,330 @@
+/**
+ * @file        packet.hpp
+ * @brief       Pooled, reference counted, network packet buffers
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2024 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef PACKET_HPP
+#define PACKET_HPP
+
+#include <QByteArray>
+#include <QHostAddress>
+#include <QMetaType>
+#include <QMutex>
+#include <QNetworkDatagram>
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <memory>
+#include <vector>
+
+#if defined MAKE_OTP_LIB
+    /**
+     * @brief Export symbol as shared library
+     * 
+     */
+    #define OTP_LIB_EXPORT Q_DECL_EXPORT
+#else
+    /**
+     * @brief Import symbol from shared library
+     * 
+     */
+    #define OTP_LIB_EXPORT Q_DECL_IMPORT
+#endif
+
+namespace OTP
+{
+    class PacketPool;
+    class SocketReceiver;
+
+    /**
+     * @internal
+     * @brief Non-owning view of packet payload
+     * @details Only valid for as long as the Packet it was taken from
+     * 
+     */
+    typedef struct PacketView
+    {
+        const char *data = nullptr; /*!< First byte of view */
+        int size = 0; /*!< Bytes in view */
+
+        /**
+         * @brief Sub-view of this view
+         * 
+         * @param pos Offset from start of this view
+         * @param len Bytes to include, clamped to the end of this view
+         * @return Sub-view, empty if out of range
+         */
+        PacketView mid(int pos, int len) const
+        {
+            if ((pos < 0) || (pos >= size) || (len <= 0)) return PacketView();
+            return {data + pos, std::min(len, size - pos)};
+        }
+    } PacketView;
+
+    /**
+     * @internal
+     * @brief Reference counted network packet, backed by a pooled buffer
+     * @details Copies share the same buffer, which returns to its pool when the last copy is destroyed.
+     * Sender and destination addresses are stored raw, and only converted to QHostAddress when asked for
+     * 
+     */
+    class OTP_LIB_EXPORT Packet
+    {
+    public:
+        static constexpr int capacity = 2048; /*!< Largest payload a packet can hold, larger than any valid OTP message */
+
+        Packet() : block(nullptr) {}
+        Packet(const Packet &other);
+        Packet(Packet &&other) noexcept;
+        Packet& operator=(const Packet &other);
+        Packet& operator=(Packet &&other) noexcept;
+        ~Packet();
+
+        /**
+         * @brief Create a packet, from the default pool, holding a copy of a network datagram
+         * 
+         * @param datagram Datagram to copy
+         * @return New packet, null if the datagram is larger than Packet::capacity
+         */
+        static Packet fromDatagram(const QNetworkDatagram &datagram);
+
+        /**
+         * @brief Is this a null packet, with no buffer
+         * 
+         * @return true Null packet
+         * @return false Packet has a buffer
+         */
+        bool isNull() const { return !block; }
+
+        /**
+         * @brief Payload
+         * 
+         * @return First byte of payload 
+         */
+        const char* constData() const;
+
+        /**
+         * @brief Writable payload, up to Packet::capacity bytes
+         * 
+         * @return First byte of payload
+         */
+        char* data();
+
+        /**
+         * @brief Payload size
+         * 
+         * @return Bytes in payload
+         */
+        int size() const;
+
+        /**
+         * @brief Set the payload size
+         * 
+         * @param size New size, clamped to Packet::capacity
+         */
+        void resize(int size);
+
+        /**
+         * @brief Copy into the payload
+         * 
+         * @param data Data to copy
+         * @param size Bytes to copy
+         * @return true Copied
+         * @return false Larger than Packet::capacity
+         */
+        bool setData(const char *data, int size);
+
+        /**
+         * @brief Non-owning view of the payload
+         * 
+         * @return View, valid for the lifetime of this packet
+         */
+        PacketView view() const { return {constData(), size()}; }
+
+        /**
+         * @brief Non-owning QByteArray of the payload
+         * @details Wraps the payload with QByteArray::fromRawData(), no data is copied
+         * 
+         * @return Raw data array, valid for the lifetime of this packet
+         */
+        QByteArray toByteArray() const { return QByteArray::fromRawData(constData(), size()); }
+
+        /**
+         * @brief Sender address
+         * 
+         * @return Address of sender
+         */
+        QHostAddress senderAddress() const;
+
+        /**
+         * @brief Sender port
+         * 
+         * @return Port of sender
+         */
+        quint16 senderPort() const;
+
+        /**
+         * @brief Destination address
+         * 
+         * @return Address packet was sent to
+         */
+        QHostAddress destinationAddress() const;
+
+        /**
+         * @brief Set sender
+         * 
+         * @param address Sender address
+         * @param port Sender port
+         */
+        void setSender(const QHostAddress &address, quint16 port = 0);
+
+        /**
+         * @brief Destination port
+         * 
+         * @return Port packet was sent to
+         */
+        quint16 destinationPort() const;
+
+        /**
+         * @brief Set destination
+         * 
+         * @param address Destination address
+         * @param port Destination port
+         */
+        void setDestination(const QHostAddress &address, quint16 port = 0);
+
+        /**
+         * @brief Convert to a network datagram, for existing QNetworkDatagram consumers
+         * 
+         * @return Copy of this packet as a datagram
+         */
+        QNetworkDatagram toQNetworkDatagram() const;
+
+    private:
+        friend class PacketPool;
+        friend class SocketReceiver;
+
+        /**
+         * @internal
+         * @brief Raw address, IPv4 addresses use the first four octets in network order
+         * 
+         */
+        typedef struct address_t
+        {
+            quint8 family = 0; /*!< 0 (None), 4 (IPv4), or 6 (IPv6) */
+            std::array<quint8, 16> octets; /*!< Address octets */
+        } address_t;
+
+        /**
+         * @internal
+         * @brief Pooled buffer, with header
+         * 
+         */
+        typedef struct block_t
+        {
+            std::atomic<int> refs{0}; /*!< Handles sharing this block */
+            PacketPool *pool = nullptr; /*!< Owning pool */
+            block_t *next = nullptr; /*!< Free list link */
+            int size = 0; /*!< Payload size */
+            address_t sender; /*!< Sender address */
+            quint16 senderPort = 0; /*!< Sender port */
+            address_t destination; /*!< Destination address */
+            quint16 destinationPort = 0; /*!< Destination port */
+            alignas(16) std::array<char, capacity> data; /*!< Payload */
+        } block_t;
+
+        explicit Packet(block_t *block) : block(block) {}
+        static QHostAddress toHostAddress(const address_t &address);
+        static address_t fromHostAddress(const QHostAddress &address);
+        void unref();
+
+        block_t *block;
+    };
+
+    /**
+     * @internal
+     * @brief Slab allocated pool of packet buffers
+     * @details Buffers are allocated in slabs, and recycled through a free list.
+     * Once the pool has grown to the working set, acquiring and releasing packets performs no heap allocations.
+     * Only the buffers are reused, the rest of the receive path still allocates, such as copying an event loop
+     * QNetworkDatagram into a packet, and dissecting a packet into a Message
+     * 
+     */
+    class OTP_LIB_EXPORT PacketPool
+    {
+    public:
+        /**
+         * @brief Construct a new Packet Pool
+         * 
+         * @param slabSize Buffers allocated each time the pool grows
+         */
+        explicit PacketPool(int slabSize = 64);
+        ~PacketPool();
+
+        PacketPool(const PacketPool&) = delete;
+        PacketPool& operator=(const PacketPool&) = delete;
+
+        /**
+         * @brief Default, process wide, pool
+         * 
+         * @return Default pool
+         */
+        static PacketPool& instance();
+
+        /**
+         * @brief Get an empty packet from the pool
+         * @details Thread safe
+         * 
+         * @return Packet, with a size of zero
+         */
+        Packet acquire();
+
+        /**
+         * @brief Pool statistics
+         * 
+         */
+        typedef struct statistics_t
+        {
+            quint64 slabs = 0; /*!< Slabs allocated */
+            quint64 blocks = 0; /*!< Buffers allocated */
+            quint64 free = 0; /*!< Buffers currently free */
+        } statistics_t;
+
+        /**
+         * @brief Get the pool statistics
+         * 
+         * @return Pool statistics
+         */
+        statistics_t getStatistics() const;
+
+    private:
+        friend class Packet;
+        void release(Packet::block_t *block);
+        void grow();
+
+        const int slabSize;
+        mutable QMutex mutex;
+        std::vector<std::unique_ptr<Packet::block_t[]>> slabs;
+        Packet::block_t *freeList = nullptr;
+        quint64 freeCount = 0;
+    };
+}
+Q_DECLARE_METATYPE(OTP::Packet)
+
+#endif // PACKET_HPP
@@ -0,0 +1,274 @@
+/**
+ * @file        pointstore.cpp
+ * @brief       Flat storage of point details
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#include "pointstore.hpp"
+
+using namespace OTP;
+
+void pointStore_t::clear()
+{
+    handles.clear();
+    cids.clear();
+    pool.clear();
+    table.clear();
+    structure.clear();
+    sources.clear();
+    ranked.clear();
+}
+
+void pointStore_t::changeCID(const cid_t &oldCID, const cid_t &newCID)
+{
+    const auto handle = getHandle(oldCID);
+    if (handle == invalidHandle) return;
+
+    // Replace any existing points for the new CID
+    const auto oldHandle = getHandle(newCID);
+    if (oldHandle != invalidHandle)
+    {
+        removeIf([oldHandle](const record_t &record) { return record.handle == oldHandle; });
+        structure.remove(oldHandle);
+        cids[oldHandle] = cid_t();
+    }
+
+    handles.remove(oldCID);
+    handles.insert(newCID, handle);
+    cids[handle] = newCID;
+}
+
+bool pointStore_t::removeSystem(const cid_t &cid, system_t system)
+{
+    const auto handle = getHandle(cid);
+    if (!structure.value(handle).contains(system)) return false;
+
+    removeIf([handle, system](const record_t &record) {
+        return (record.handle == handle) && (record.address.system == system); });
+    structure[handle].remove(system);
+    return true;
+}
+
+QList<system_t> pointStore_t::getSystems(const cid_t &cid) const
+{
+    return structure.value(getHandle(cid)).keys();
+}
+
+bool pointStore_t::removeGroup(const cid_t &cid, system_t system, group_t group)
+{
+    const auto handle = getHandle(cid);
+    if (!structure.value(handle).value(system).contains(group)) return false;
+
+    for (const auto &point : structure[handle][system].take(group))
+        removeSlot(findSlot(handle, pack({system, group, point})));
+    return true;
+}
+
+QList<group_t> pointStore_t::getGroups(const cid_t &cid, system_t system) const
+{
+    return structure.value(getHandle(cid)).value(system).keys();
+}
+
+QList<point_t> pointStore_t::getPoints(const cid_t &cid, system_t system, group_t group) const
+{
+    return structure.value(getHandle(cid)).value(system).value(group).values();
+}
+
+pointDetails_t pointStore_t::find(handle_t handle, const address_t &address) const
+{
+    if ((handle == invalidHandle) || table.empty()) return nullptr;
+
+    const auto slot = findSlot(handle, pack(address));
+    if (!table[slot]) return nullptr;
+    return pool[table[slot] - 1].details;
+}
+
+QList<cid_t> pointStore_t::getSources(const address_t &address) const
+{
+    QList<cid_t> ret;
+    const auto it = sources.constFind(address);
+    if (it == sources.cend()) return ret;
+
+    ret.reserve(it->size());
+    for (const auto handle : *it)
+        ret.append(cids[handle]);
+    return ret;
+}
+
+void pointStore_t::rank(handle_t handle, const address_t &address, priority_t priority)
+{
+    if (handle == invalidHandle) return;
+    ranked[address].set(handle, priority, ++lastSequence);
+}
+
+void pointStore_t::unrank(handle_t handle, const address_t &address)
+{
+    auto heap = ranked.find(address);
+    if (heap == ranked.end()) return;
+    if (heap->remove(handle) && heap->isEmpty()) ranked.erase(heap);
+}
+
+cid_t pointStore_t::getWinner(const address_t &address) const
+{
+    const auto heap = ranked.constFind(address);
+    if (heap == ranked.cend()) return cid_t();
+    return getCID(heap->top());
+}
+
+pointStore_t::record_t &pointStore_t::findOrInsert(const cid_t &cid, const address_t &address, bool &inserted)
+{
+    const auto handle = intern(cid);
+    const auto packedAddress = pack(address);
+
+    if ((pool.size() + 1) * 2 > table.size()) grow();
+    const auto slot = findSlot(handle, packedAddress);
+    inserted = !table[slot];
+    if (inserted)
+    {
+        pool.push_back({handle, address, std::make_shared<pointDetails>()});
+        table[slot] = static_cast<quint32>(pool.size());
+        structure[handle][address.system][address.group].insert(address.point);
+        sources[address].append(handle);
+    }
+    return pool[table[slot] - 1];
+}
+
+bool pointStore_t::remove(const cid_t &cid, const address_t &address)
+{
+    const auto handle = getHandle(cid);
+    if ((handle == invalidHandle) || table.empty()) return false;
+
+    const auto slot = findSlot(handle, pack(address));
+    if (!table[slot]) return false;
+    removeSlot(slot);
+
+    auto system = structure[handle].find(address.system);
+    if (system != structure[handle].end())
+    {
+        auto group = system->find(address.group);
+        if (group != system->end())
+            group->remove(address.point);
+    }
+    return true;
+}
+
+pointStore_t::handle_t pointStore_t::intern(const cid_t &cid)
+{
+    auto handle = handles.find(cid);
+    if (handle != handles.end()) return handle.value();
+
+    cids.push_back(cid);
+    return handles.insert(cid, static_cast<handle_t>(cids.size() - 1)).value();
+}
+
+quint64 pointStore_t::pack(const address_t &address)
+{
+    // System (8 bits), Group (16 bits), Point (32 bits)
+    return (static_cast<quint64>(static_cast<quint8>(address.system)) << 48)
+            | (static_cast<quint64>(static_cast<quint16>(address.group)) << 32)
+            | static_cast<quint64>(static_cast<quint32>(address.point));
+}
+
+size_t pointStore_t::hash(handle_t handle, quint64 packedAddress)
+{
+    // SplitMix64 finaliser
+    quint64 value = packedAddress ^ (static_cast<quint64>(handle) * 0x9E3779B97F4A7C15ull);
+    value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+    value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+    return static_cast<size_t>(value ^ (value >> 31));
+}
+
+size_t pointStore_t::findSlot(handle_t handle, quint64 packedAddress) const
+{
+    const auto mask = table.size() - 1;
+    for (auto slot = hash(handle, packedAddress) & mask;; slot = (slot + 1) & mask)
+    {
+        if (!table[slot]) return slot;
+        const auto &record = pool[table[slot] - 1];
+        if ((record.handle == handle) && (pack(record.address) == packedAddress)) return slot;
+    }
+}
+
+void pointStore_t::grow()
+{
+    table.assign(std::max<size_t>(table.size() * 2, 64), 0);
+    const auto mask = table.size() - 1;
+    for (size_t index = 0; index < pool.size(); index++)
+    {
+        auto slot = hash(pool[index].handle, pack(pool[index].address)) & mask;
+        while (table[slot]) slot = (slot + 1) & mask;
+        table[slot] = static_cast<quint32>(index + 1);
+    }
+}
+
+void pointStore_t::removeSlot(size_t slot)
+{
+    const auto mask = table.size() - 1;
+    const auto index = table[slot] - 1;
+
+    // Sources
+    {
+        const auto &record = pool[index];
+        unrank(record.handle, record.address);
+        auto source = sources.find(record.address);
+        if (source != sources.end())
+        {
+            for (int n = 0; n < source->size(); n++)
+                if (source->at(n) == record.handle)
+                {
+                    source->remove(n);
+                    break;
+                }
+            if (source->isEmpty()) sources.erase(source);
+        }
+    }
+
+    // Backward shift deletion, so no tombstones are required
+    table[slot] = 0;
+    for (auto next = (slot + 1) & mask; table[next]; next = (next + 1) & mask)
+    {
+        const auto &record = pool[table[next] - 1];
+        const auto home = hash(record.handle, pack(record.address)) & mask;
+        if (((next - home) & mask) >= ((next - slot) & mask))
+        {
+            table[slot] = table[next];
+            table[next] = 0;
+            slot = next;
+        }
+    }
+
+    // Keep the pool contiguous, moving the last record in to the gap
+    const auto last = static_cast<quint32>(pool.size() - 1);
+    if (index != last)
+    {
+        pool[index] = std::move(pool[last]);
+        auto moved = hash(pool[index].handle, pack(pool[index].address)) & mask;
+        while (table[moved] != last + 1) moved = (moved + 1) & mask;
+        table[moved] = index + 1;
+    }
+    pool.pop_back();
+}
+
+template <typename Predicate> void pointStore_t::removeIf(Predicate predicate)
+{
+    for (auto index = pool.size(); index-- > 0;)
+    {
+        if (!predicate(pool[index])) continue;
+        removeSlot(findSlot(pool[index].handle, pack(pool[index].address)));
+    }
+}
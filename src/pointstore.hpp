@@ -0,0 +1,322 @@
+/**
+ * @file        pointstore.hpp
+ * @brief       Flat storage of point details
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef POINTSTORE_HPP
+#define POINTSTORE_HPP
+
+#include "types.hpp"
+#include "sourceheap.hpp"
+#include <QHash>
+#include <QSet>
+#include <QVarLengthArray>
+#include <vector>
+
+namespace OTP
+{
+    /**
+     * @internal
+     * @brief Flat storage of point details, for all components
+     * @details Component IDentifiers are interned as small integer handles, and each point is keyed by
+     * its handle and packed address. Keys are located with an open addressing table, which indexes
+     * a contiguous pool of point records.
+     *
+     * The systems, groups and points of each component are also indexed, for listing.
+ * Sources eligible to win each address are ranked by priority, so the winner can be read directly.
+     *
+     * Not thread safe, access must be protected by the owner.
+     */
+    class pointStore_t
+    {
+    public:
+        /**
+         * @brief Interned Component IDentifier
+         */
+        typedef quint32 handle_t;
+
+        /**
+         * @brief Handle of an unknown Component IDentifier
+         */
+        static constexpr handle_t invalidHandle = ~handle_t(0);
+
+        /**
+         * @brief Point record
+         */
+        typedef struct {
+            handle_t handle; /**< Handle of component owning point */
+            address_t address; /**< Point address */
+            pointDetails_t details; /**< Point details */
+        } record_t;
+
+        /**
+         * @brief Remove all components and points
+         *
+         */
+        void clear();
+
+        /**
+         * @brief Get the handle of a Component IDentifier
+         *
+         * @param cid Component IDentifier
+         * @return Handle, or invalidHandle if the component has no systems
+         */
+        handle_t getHandle(const cid_t &cid) const { return handles.value(cid, invalidHandle); }
+
+        /**
+         * @brief Get the Component IDentifier of a handle
+         *
+         * @param handle Handle
+         * @return Component IDentifier
+         */
+        cid_t getCID(handle_t handle) const { return (handle < cids.size()) ? cids[handle] : cid_t(); }
+
+        /**
+         * @brief Get all components with systems
+         *
+         * @return Component IDentifiers
+         */
+        QList<cid_t> getComponents() const { return handles.keys(); }
+
+        /**
+         * @brief Change the CID of a component
+         * @details Points keep their handle, so are not moved. Any points already owned by newCID are removed.
+         *
+         * @param oldCID Existing Component IDentifier
+         * @param newCID New Component IDentifier
+         */
+        void changeCID(const cid_t &oldCID, const cid_t &newCID);
+
+        /**
+         * @brief Add a system to a component
+         *
+         * @param cid Component IDentifier
+         * @param system System to add
+         */
+        void addSystem(const cid_t &cid, system_t system) { structure[intern(cid)][system]; }
+
+        /**
+         * @brief Remove a system, and all its groups and points, from a component
+         *
+         * @param cid Component IDentifier
+         * @param system System to remove
+         * @return true System was removed
+         * @return false System was unknown
+         */
+        bool removeSystem(const cid_t &cid, system_t system);
+
+        /**
+         * @brief Get the systems of a component
+         *
+         * @param cid Component IDentifier
+         * @return Unsorted system list
+         */
+        QList<system_t> getSystems(const cid_t &cid) const;
+
+        /**
+         * @brief Add a group to a component
+         * @details The system is added if required
+         *
+         * @param cid Component IDentifier
+         * @param system System containing group
+         * @param group Group to add
+         */
+        void addGroup(const cid_t &cid, system_t system, group_t group) { structure[intern(cid)][system][group]; }
+
+        /**
+         * @brief Remove a group, and all its points, from a component
+         *
+         * @param cid Component IDentifier
+         * @param system System containing group
+         * @param group Group to remove
+         * @return true Group was removed
+         * @return false Group was unknown
+         */
+        bool removeGroup(const cid_t &cid, system_t system, group_t group);
+
+        /**
+         * @brief Get the groups of a component's system
+         *
+         * @param cid Component IDentifier
+         * @param system System to query
+         * @return Unsorted group list
+         */
+        QList<group_t> getGroups(const cid_t &cid, system_t system) const;
+
+        /**
+         * @brief Get the points of a component's group
+         *
+         * @param cid Component IDentifier
+         * @param system System to query
+         * @param group Group to query
+         * @return Unsorted point list
+         */
+        QList<point_t> getPoints(const cid_t &cid, system_t system, group_t group) const;
+
+        /**
+         * @brief Find a point
+         *
+         * @param handle Handle of component owning point
+         * @param address Point address
+         * @return Point details, or nullptr if unknown
+         */
+        pointDetails_t find(handle_t handle, const address_t &address) const;
+
+        /**
+         * @copydoc find()
+         * @param cid Component IDentifier owning point
+         */
+        pointDetails_t find(const cid_t &cid, const address_t &address) const
+            { return find(getHandle(cid), address); }
+
+        /**
+         * @brief Is the point known to any component
+         *
+         * @param address Point address
+         * @return true Point is known
+         * @return false Point is unknown
+         */
+        bool contains(const address_t &address) const { return sources.contains(address); }
+
+        /**
+         * @brief Get all components with a point at an address
+         *
+         * @param address Point address
+         * @return Component IDentifiers, in the order the point was added
+         */
+        QList<cid_t> getSources(const address_t &address) const;
+
+        /**
+         * @brief Rank a component as a source eligible to win an address
+         * @details A source is ranked as most recent when first ranked, or when its priority changes
+         *
+         * @param handle Handle of component owning point
+         * @param address Point address
+         * @param priority Point priority
+         */
+        void rank(handle_t handle, const address_t &address, priority_t priority);
+
+        /**
+         * @brief Remove a component from the sources eligible to win an address
+         * @details Points are unranked when removed
+         *
+         * @param handle Handle of component owning point
+         * @param address Point address
+         */
+        void unrank(handle_t handle, const address_t &address);
+
+        /**
+         * @brief Get the winning component for an address
+         * @details Highest priority ranked source, ties won by the most recently ranked
+         *
+         * @param address Point address
+         * @return Winning Component IDentifier, or null if no sources are ranked
+         */
+        cid_t getWinner(const address_t &address) const;
+
+        /**
+         * @brief Find a point, adding it if unknown
+         * @details The system and group are added if required.
+         * The returned record is only valid until the next point is added or removed.
+         *
+         * @param cid Component IDentifier owning point
+         * @param address Point address
+         * @param inserted Set true if the point was added
+         * @return Point record
+         */
+        record_t &findOrInsert(const cid_t &cid, const address_t &address, bool &inserted);
+
+        /**
+         * @brief Remove a point
+         *
+         * @param cid Component IDentifier owning point
+         * @param address Point address
+         * @return true Point was removed
+         * @return false Point was unknown
+         */
+        bool remove(const cid_t &cid, const address_t &address);
+
+        /**
+         * @brief Get all point records
+         * @details In no particular order, and only valid until the next point is added or removed
+         *
+         * @return Point records
+         */
+        const std::vector<record_t> &records() const { return pool; }
+
+        /**
+         * @brief Get number of points
+         *
+         * @return Number of points
+         */
+        size_t size() const { return pool.size(); }
+
+    private:
+        handle_t intern(const cid_t &cid);
+
+        static quint64 pack(const address_t &address);
+        static size_t hash(handle_t handle, quint64 packedAddress);
+
+        /**
+         * @brief Get the table slot of a key
+         * @return Slot holding the key, or the empty slot where it would be placed
+         */
+        size_t findSlot(handle_t handle, quint64 packedAddress) const;
+        void grow();
+        void removeSlot(size_t slot);
+        template <typename Predicate> void removeIf(Predicate predicate);
+
+        QHash<cid_t, handle_t> handles;
+        std::vector<cid_t> cids;
+
+        /**
+         * @brief Pool of point records
+         */
+        std::vector<record_t> pool;
+
+        /**
+         * @brief Open addressing table, with linear probing
+         * @details Each slot is the index of a pool record plus one, or zero when empty
+         */
+        std::vector<quint32> table;
+
+        /**
+         * @brief Systems, groups and points of each component, indexed by handle
+         */
+        QHash<handle_t, QHash<system_t, QHash<group_t, QSet<point_t>>>> structure;
+
+        /**
+         * @brief Handles of components with a point, indexed by address
+         * @details Updated as points are added and removed
+         */
+        QHash<address_t, QVarLengthArray<handle_t, 2>> sources;
+
+        /**
+         * @brief Handles of sources eligible to win, ranked by priority, indexed by address
+         */
+        QHash<address_t, sourceHeap_t<handle_t>> ranked;
+
+        /**
+         * @brief Last ranking sequence number
+         */
+        quint64 lastSequence = 0;
+    };
+}
+
+#endif // POINTSTORE_HPP
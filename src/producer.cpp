@@ -24,7 +24,6 @@
 #include "socket.hpp"
 #include "network/modules/modules.hpp"
 #include "network/messages/otp_transform_message.hpp"
-#include <QTimer>
 #include <random>
 
 #include <QDebug>
@@ -66,9 +65,9 @@ Producer::Producer(
         });
 
     setupListener();
-    auto startSenderTimeout = new QTimer;
+    auto startSenderTimeout = new CLOCK::Timer;
     startSenderTimeout->setSingleShot(true);
-    connect(startSenderTimeout, &QTimer::timeout, this, [this, transformRate]() {this->setupSender(transformRate); });
+    connect(startSenderTimeout, &CLOCK::Timer::timeout, this, [this, transformRate]() {this->setupSender(transformRate); });
     connect(startSenderTimeout, SIGNAL(timeout()), startSenderTimeout, SLOT(deleteLater()));
     startSenderTimeout->start(OTP_ADVERTISEMENT_STARTUP_WAIT);
 }
@@ -85,6 +84,29 @@ void Producer::addLocalGroup(system_t system, group_t group)
 void Producer::removeLocalGroup(system_t system, group_t group)
 {
     otpNetwork->removeGroup(getLocalCID(), system, group);
+    for (auto it = transformCache.points.begin(); it != transformCache.points.end();)
+    {
+        if ((it.key().system == system) && (it.key().group == group))
+            it = transformCache.points.erase(it);
+        else
+            ++it;
+    }
+}
+
+/* Local Systems */
+void Producer::removeLocalSystem(system_t system)
+{
+    if (!system.isValid()) return;
+
+    Component::removeLocalSystem(system);
+    for (auto it = transformCache.points.begin(); it != transformCache.points.end();)
+    {
+        if (it.key().system == system)
+            it = transformCache.points.erase(it);
+        else
+            ++it;
+    }
+    transformCache.lastFullPointSet.remove(system);
 }
 
 /* Local Points */
@@ -98,14 +120,18 @@ void Producer::addLocalPoint(address_t address, priority_t priority)
     otpNetwork->PointDetails(getLocalCID(), address)->standardModules.referenceFrame.setSystem(address.system, 0);
     otpNetwork->PointDetails(getLocalCID(), address)->standardModules.referenceFrame.setGroup(address.group, 0);
     otpNetwork->PointDetails(getLocalCID(), address)->standardModules.referenceFrame.setPoint(address.point, 0);
+    transformCache.points.remove(address);
 }
 void Producer::removeLocalPoint(address_t address)
 {
     otpNetwork->removePoint(getLocalCID(), address);
+    transformCache.points.remove(address);
 }
 void Producer::moveLocalPoint(address_t oldAddress, address_t newAddress)
 {
     otpNetwork->movePoint(getLocalCID(), oldAddress, newAddress);
+    transformCache.points.remove(oldAddress);
+    transformCache.points.remove(newAddress);
 
     // Update any self referencing frames
     auto referenceFrame = getLocalReferenceFrame(newAddress);
@@ -134,7 +160,8 @@ priority_t Producer::getLocalPointPriority(address_t address) const
 void Producer::setLocalPointPriority(address_t address, priority_t priority)
 {
     if (!getLocalPoints(address.system, address.group).contains(address.point)) return;
-    otpNetwork->PointDetails(getLocalCID(), address)->setPriority(priority);
+    otpNetwork->setPointPriority(getLocalCID(), address, priority);
+    transformCache.points.remove(address);
     emit updatedLocalPointPriority(address);
 }
 
@@ -187,6 +214,8 @@ void Producer::setLocalPosition(address_t address, axis_t axis, PositionValue_t
     otpNetwork->PointDetails(getLocalCID(), address)->standardModules.position.setScaling(
                 position.scale);
 
+    transformCache.points.remove(address);
+
     emit updatedPosition(address, axis);
 }
 
@@ -211,6 +240,8 @@ void Producer::setLocalPositionVelocity(address_t address, axis_t axis, Position
     otpNetwork->PointDetails(getLocalCID(), address)->standardModules.positionVelAcc.setVelocity(
                 axis, positionVel.value, positionVel.timestamp);
 
+    transformCache.points.remove(address);
+
     emit updatedPositionVelocity(address, axis);
 }
 
@@ -234,6 +265,8 @@ void Producer::setLocalPositionAcceleration(address_t address, axis_t axis, Posi
     otpNetwork->PointDetails(getLocalCID(), address)->standardModules.positionVelAcc.setAcceleration(
                 axis, positionAccel.value, positionAccel.timestamp);
 
+    transformCache.points.remove(address);
+
     emit updatedPositionAcceleration(address, axis);
 }
 
@@ -258,6 +291,8 @@ void Producer::setLocalRotation(address_t address, axis_t axis, RotationValue_t
     otpNetwork->PointDetails(getLocalCID(), address)->standardModules.rotation.setRotation(
                 axis, rotation.value, rotation.timestamp);
 
+    transformCache.points.remove(address);
+
     emit updatedRotation(address, axis);
 }
 
@@ -282,6 +317,8 @@ void Producer::setLocalRotationVelocity(address_t address, axis_t axis, Rotation
     otpNetwork->PointDetails(getLocalCID(), address)->standardModules.rotationVelAcc.setVelocity(
                 axis, rotationVel.value, rotationVel.timestamp);
 
+    transformCache.points.remove(address);
+
     emit updatedRotationVelocity(address, axis);
 }
 
@@ -305,6 +342,8 @@ void Producer::setLocalRotationAcceleration(address_t address, axis_t axis, Rota
     otpNetwork->PointDetails(getLocalCID(), address)->standardModules.rotationVelAcc.setAcceleration(
                 axis, rotationAccel.value, rotationAccel.timestamp);
 
+    transformCache.points.remove(address);
+
     emit updatedRotationAcceleration(address, axis);
 }
 
@@ -327,6 +366,8 @@ void Producer::setLocalScale(address_t address, axis_t axis, Scale_t scale)
     otpNetwork->PointDetails(getLocalCID(), address)->standardModules.scale.setScale(
                 axis, scale.value, scale.timestamp);
 
+    transformCache.points.remove(address);
+
     emit updatedScale(address, axis);
 }
 
@@ -351,65 +392,74 @@ void Producer::setLocalReferenceFrame(address_t address, ReferenceFrame_t refere
     module->setSystem(referenceFrame.value.system, referenceFrame.timestamp);
     module->setGroup(referenceFrame.value.group, referenceFrame.timestamp);
     module->setPoint(referenceFrame.value.point, referenceFrame.timestamp);
+    transformCache.points.remove(address);
     emit updatedReferenceFrame(address);
 }
 
 void Producer::setupSender(std::chrono::milliseconds transformRate)
 {
     qDebug() << this << "- Starting OTP Transform Messages" << iface.name();
-    connect(&transformMsgTimer, &QTimer::timeout, this, [this]() {
-        for (const auto &system : getLocalSystems())
-            sendOTPTransformMessage(system);
+    connect(&transformMsgTimer, &CLOCK::Timer::timeout, this, [this]() {
+        sendOTPTransformMessage(getLocalSystems());
     });
     transformRate = std::clamp(transformRate, OTP_TRANSFORM_TIMING_MIN, OTP_TRANSFORM_TIMING_MAX);
     transformMsgTimer.start(transformRate);
 }
 
-bool Producer::receiveOTPTransformMessage(const QNetworkDatagram &datagram)
+bool Producer::receiveOTPTransformMessage(const Packet &packet)
 {
-    if ((datagram.destinationAddress() == OTP_Advertisement_Message_IPv4) &&
-            (datagram.destinationAddress() == OTP_Advertisement_Message_IPv6))
-        return false; // It's an advertisement message
+    Q_UNUSED(packet)
 
     // Transform message ignored by Producer
     return false;
 };
 
-bool Producer::receiveOTPNameAdvertisementMessage(const QNetworkDatagram &datagram)
+bool Producer::receiveOTPNameAdvertisementMessage(const Packet &packet)
 {
-    MESSAGES::OTPNameAdvertisementMessage::Message nameAdvert(datagram);
+    MESSAGES::OTPNameAdvertisementMessage::Message nameAdvert(packet);
 
     // Name Advertisement Message?
     if (nameAdvert.isValid())
     {
+        using reassembler_t = decltype(nameAdvertisementFolios);
         auto cid = nameAdvert.getOTPLayer()->getCID();
-        if (!folioMap.checkSequence(
+        const auto added = nameAdvertisementFolios.addPage(
                     cid,
                     PDU::VECTOR_OTP_ADVERTISEMENT_NAME,
-                    nameAdvert.getOTPLayer()->getFolio()))
+                    nameAdvert.getOTPLayer()->getFolio(),
+                    nameAdvert.getOTPLayer()->getPage(),
+                    nameAdvert.getOTPLayer()->getLastPage(),
+                    nameAdvert.getNameAdvertisementLayer()->getList());
+        switch (added)
         {
-            qDebug() << this << "- Out of Sequence OTP Name Advertisement Message Request Received From" << datagram.senderAddress();
-            return true;
+            case reassembler_t::Stale:
+                qDebug() << this << "- Out of Sequence OTP Name Advertisement Message Request Received From" << packet.senderAddress();
+                return true;
+            case reassembler_t::Duplicate: return true;
+            case reassembler_t::Invalid: return false;
+            case reassembler_t::Incomplete:
+            case reassembler_t::Complete: break;
         }
 
         auto type = (nameAdvert.getNameAdvertisementLayer()->getOptions().isResponse()) ? component_t::type_t::produder : component_t::type_t::consumer;
         if (type == component_t::type_t::produder)
-            qDebug() << this << "- OTP Name Advertisement Message Response Received From" << datagram.senderAddress();
+            qDebug() << this << "- OTP Name Advertisement Message Response Received From" << packet.senderAddress();
         else if (type == component_t::type_t::consumer)
-            qDebug() << this << "- OTP Name Advertisement Message Request Received From" << datagram.senderAddress();
+            qDebug() << this << "- OTP Name Advertisement Message Request Received From" << packet.senderAddress();
 
         otpNetwork->addComponent(
                 cid,
-                datagram.senderAddress(),
+                packet.senderAddress(),
                 nameAdvert.getOTPLayer()->getComponentName(),
                 type);
 
-        if (type == component_t::type_t::consumer)
+        // Reply once per request folio
+        if ((type == component_t::type_t::consumer) && (added == reassembler_t::Complete))
         {
             auto folio = nameAdvert.getOTPLayer()->getFolio();
-            auto destAddr = datagram.senderAddress();
+            auto destAddr = packet.senderAddress();
             auto timer = getBackoffTimer(OTP_NAME_ADVERTISEMENT_MAX_BACKOFF);
-            connect(timer, &QTimer::timeout, this, [this, destAddr, folio]() {
+            connect(timer, &CLOCK::Timer::timeout, this, [this, destAddr, folio]() {
                 sendOTPNameAdvertisementMessage(destAddr, folio);
             });
             timer->start();
@@ -420,34 +470,44 @@ bool Producer::receiveOTPNameAdvertisementMessage(const QNetworkDatagram &datagr
     return false;
 }
 
-bool Producer::receiveOTPSystemAdvertisementMessage(const QNetworkDatagram &datagram)
+bool Producer::receiveOTPSystemAdvertisementMessage(const Packet &packet)
 {
-    MESSAGES::OTPSystemAdvertisementMessage::Message systemAdvert(datagram);
+    MESSAGES::OTPSystemAdvertisementMessage::Message systemAdvert(packet);
 
     // System Advertisement Message?
     if (systemAdvert.isValid() && systemAdvert.getSystemAdvertisementLayer()->getOptions().isRequest())
     {
+        using reassembler_t = decltype(systemAdvertisementFolios);
         auto cid = systemAdvert.getOTPLayer()->getCID();
-        if (!folioMap.checkSequence(
+        const auto added = systemAdvertisementFolios.addPage(
                     cid,
                     PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM,
-                    systemAdvert.getOTPLayer()->getFolio()))
+                    systemAdvert.getOTPLayer()->getFolio(),
+                    systemAdvert.getOTPLayer()->getPage(),
+                    systemAdvert.getOTPLayer()->getLastPage(),
+                    systemAdvert.getSystemAdvertisementLayer()->getList());
+        switch (added)
         {
-            qDebug() << this << "- Out of Sequence OTP System Advertisement Message Request Received From" << datagram.senderAddress();
-            return true;
+            case reassembler_t::Stale:
+                qDebug() << this << "- Out of Sequence OTP System Advertisement Message Request Received From" << packet.senderAddress();
+                return true;
+            case reassembler_t::Duplicate: return true;
+            case reassembler_t::Invalid: return false;
+            case reassembler_t::Incomplete:
+            case reassembler_t::Complete: break;
         }
 
         auto type = (systemAdvert.getSystemAdvertisementLayer()->getOptions().isResponse()) ? component_t::type_t::produder : component_t::type_t::consumer;
         if (type == component_t::type_t::produder)
-            qDebug() << this << "- OTP System Advertisement Message Response Received From" << datagram.senderAddress();
+            qDebug() << this << "- OTP System Advertisement Message Response Received From" << packet.senderAddress();
         else if (type == component_t::type_t::consumer)
-            qDebug() << this << "- OTP System Advertisement Message Request Received From" << datagram.senderAddress();
+            qDebug() << this << "- OTP System Advertisement Message Request Received From" << packet.senderAddress();
 
         for (const auto &system : systemAdvert.getSystemAdvertisementLayer()->getList())
         {
             otpNetwork->addComponent(
                     cid,
-                    datagram.senderAddress(),
+                    packet.senderAddress(),
                     systemAdvert.getOTPLayer()->getComponentName(),
                     type);
 
@@ -456,12 +516,13 @@ bool Producer::receiveOTPSystemAdvertisementMessage(const QNetworkDatagram &data
                     system);
         }
 
-        if (type == component_t::type_t::consumer)
+        // Reply once per request folio
+        if ((type == component_t::type_t::consumer) && (added == reassembler_t::Complete))
         {
             auto folio = systemAdvert.getOTPLayer()->getFolio();
-            auto destAddr = datagram.senderAddress();
+            auto destAddr = packet.senderAddress();
             auto timer = getBackoffTimer(OTP_SYSTEM_ADVERTISEMENT_MAX_BACKOFF);
-            connect(timer, &QTimer::timeout, this, [this, destAddr, folio]() {
+            connect(timer, &CLOCK::Timer::timeout, this, [this, destAddr, folio]() {
                 sendOTPSystemAdvertisementMessage(destAddr, folio);
             });
             timer->start();
@@ -472,44 +533,59 @@ bool Producer::receiveOTPSystemAdvertisementMessage(const QNetworkDatagram &data
     return false;
 }
 
-bool Producer::receiveOTPModuleAdvertisementMessage(const QNetworkDatagram &datagram)
+bool Producer::receiveOTPModuleAdvertisementMessage(const Packet &packet)
 {
-    MESSAGES::OTPModuleAdvertisementMessage::Message moduleAdvert(datagram);
+    MESSAGES::OTPModuleAdvertisementMessage::Message moduleAdvert(packet);
 
     // Module Advertisement Message?
     if (moduleAdvert.isValid())
     {
+        using reassembler_t = decltype(moduleAdvertisementFolios);
         auto cid = moduleAdvert.getOTPLayer()->getCID();
-        if (!folioMap.checkSequence(
+        const auto added = moduleAdvertisementFolios.addPage(
                     cid,
                     PDU::VECTOR_OTP_ADVERTISEMENT_MODULE,
-                    moduleAdvert.getOTPLayer()->getFolio()))
+                    moduleAdvert.getOTPLayer()->getFolio(),
+                    moduleAdvert.getOTPLayer()->getPage(),
+                    moduleAdvert.getOTPLayer()->getLastPage(),
+                    moduleAdvert.getModuleAdvertisementLayer()->getList());
+        switch (added)
         {
-            qDebug() << this << "- Out of Sequence OTP Module Advertisement Message Request Received From" << datagram.senderAddress();
-            return true;
+            case reassembler_t::Stale:
+                qDebug() << this << "- Out of Sequence OTP Module Advertisement Message Request Received From" << packet.senderAddress();
+                return true;
+            case reassembler_t::Duplicate: return true;
+            case reassembler_t::Invalid: return false;
+            case reassembler_t::Incomplete: return true;
+            case reassembler_t::Complete: break;
         }
 
-        qDebug() << this << "- OTP Module Advertisement Message Request Received From" << datagram.senderAddress();
+        qDebug() << this << "- OTP Module Advertisement Message Request Received From" << packet.senderAddress();
+
+        // Process all pages
+        MESSAGES::OTPModuleAdvertisementMessage::list_t list;
+        for (const auto &page : moduleAdvertisementFolios.takePages(cid, PDU::VECTOR_OTP_ADVERTISEMENT_MODULE))
+            list.append(page);
 
         otpNetwork->addComponent(
                     cid,
-                    datagram.senderAddress(),
+                    packet.senderAddress(),
                     moduleAdvert.getOTPLayer()->getComponentName(),
                     component_t::type_t::consumer,
-                    moduleAdvert.getModuleAdvertisementLayer()->getList());
+                    list);
         return true;
     }
 
     return false;
 }
 
-QTimer* Producer::getBackoffTimer(std::chrono::milliseconds maximum)
+CLOCK::Timer* Producer::getBackoffTimer(std::chrono::milliseconds maximum)
 {
     std::random_device rd;
     std::mt19937 gen(rd());
     std::uniform_int_distribution<> dis(0, maximum.count());
 
-    auto timer = new QTimer(this);
+    auto timer = new CLOCK::Timer(this);
     timer->setSingleShot(true);
     timer->setInterval(std::chrono::milliseconds(dis(gen)));
     connect(timer, SIGNAL(timeout()), timer, SLOT(deleteLater()));
@@ -620,10 +696,21 @@ void Producer::sendOTPSystemAdvertisementMessage(QHostAddress destinationAddr, M
     }
 }
 
-void Producer::sendOTPTransformMessage(system_t system)
+void Producer::sendOTPTransformMessage(const QList<system_t> &systems)
+{
+    // Send every systems folio for this tick as a single batch
+    QList<QNetworkDatagram> datagrams;
+    for (const auto &system : systems)
+        datagrams.append(getOTPTransformMessageDatagrams(system));
+
+    if (datagrams.isEmpty()) return;
+    if (!SocketManager::writeDatagrams(iface, datagrams))
+        qDebug() << this << "- OTP Transform Message Failed";
+}
+
+QList<QNetworkDatagram> Producer::getOTPTransformMessageDatagrams(system_t system)
 {
     using namespace OTP::MESSAGES::OTPTransformMessage;
-    auto folio = TransformMessage_Folio++;
 
     // Establish requested modules for system
     QVector<PDU::OTPModuleLayer::ident_t> requestedModules;
@@ -639,64 +726,68 @@ void Producer::sendOTPTransformMessage(system_t system)
             }
 //        }
     }
-    if (requestedModules.isEmpty()) return;
+    if (requestedModules.isEmpty()) return QList<QNetworkDatagram>();
 
-    // Get each requested module
-    QVector<Message::addModule_t> folioModuleData;
+    // Points are cached packed for a set of requested modules
+    if (requestedModules != transformCache.modules)
+    {
+        transformCache.modules = requestedModules;
+        transformCache.points.clear();
+    }
+
+    // A full point set is always sent when due, otherwise only changed points are sent
+    const bool fullPointSet = !transformDeltaMode
+            || CLOCK::isExpired(
+                transformCache.lastFullPointSet.value(system, CLOCK::never),
+                OTP_TRANSFORM_FULL_POINT_SET_TIMING_MIN);
+
+    // Pack only points which have changed since last sent
+    QVector<QByteArray> folioPoints;
     for (const auto &address: getLocalAddresses(system))
     {
-        auto pointDetails = otpNetwork->PointDetails(getLocalCID(), address);
-        for (const auto &module : requestedModules)
+        auto cached = transformCache.points.find(address);
+        if (cached != transformCache.points.end())
         {
-            switch (module.ManufacturerID)
+            if (!fullPointSet) continue;
+        } else {
+            auto pointDetails = otpNetwork->PointDetails(getLocalCID(), address);
+            QVector<Message::addModule_t> pointModuleData;
+            for (const auto &module : requestedModules)
             {
-                case ESTA_MANUFACTURER_ID:
-                {
-                    folioModuleData.append(
-                        {pointDetails->getPriority(),
-                         address,
-                         MODULES::STANDARD::getTimestamp(module, pointDetails),
-                         {module.ManufacturerID, module.ModuleNumber},
-                         MODULES::STANDARD::getAdditional(module, pointDetails)});
-                } break;
-                default:
+                switch (module.ManufacturerID)
                 {
-                    qDebug() << this << "- OTP Transform - Unknown module request" << module.ManufacturerID << "/" << module.ModuleNumber;
-                } return;
+                    case ESTA_MANUFACTURER_ID:
+                    {
+                        pointModuleData.append(
+                            {pointDetails->getPriority(),
+                             address,
+                             MODULES::STANDARD::getTimestamp(module, pointDetails),
+                             {module.ManufacturerID, module.ModuleNumber},
+                             MODULES::STANDARD::getAdditional(module, pointDetails)});
+                    } break;
+                    default:
+                    {
+                        qDebug() << this << "- OTP Transform - Unknown module request" << module.ManufacturerID << "/" << module.ModuleNumber;
+                    } return QList<QNetworkDatagram>();
+                }
             }
+            cached = transformCache.points.insert(address, Message::packPoint(pointModuleData));
         }
+        if (!cached.value().isEmpty())
+            folioPoints.append(cached.value());
     }
-
-    // Generate messages
-    QVector<std::shared_ptr<Message>> folioMessages;
-    while (folioModuleData.count()) {
-        folioMessages.append(std::make_shared<Message>(getLocalCID(), getLocalName(), system, true, this));
-
-        Message::addModule_ret result;
-        do {
-            result = folioMessages.back()->addModule(folioModuleData.front());
-            if (result != Message::addModule_ret::MessageToBig)
-                folioModuleData.removeFirst();
-        } while ((result != Message::addModule_ret::MessageToBig) && folioModuleData.count());
-
-        if (!folioMessages.back()->isValid())
-        {
-            qDebug() << this << "- OTP Transform Message Not Valid";
-            return;
-        }
-    }
-
-    // Send messages
-    page_t lastPage = static_cast<page_t>(folioMessages.count()) - 1;
-    for (page_t page = 0; page < folioMessages.count(); page++)
+    if (folioPoints.isEmpty()) return QList<QNetworkDatagram>();
+    if (fullPointSet) transformCache.lastFullPointSet[system] = CLOCK::now();
+
+    // Generate datagrams
+    QList<QNetworkDatagram> datagrams;
+    const auto destAddrs = Message::getMulticastAddresses(transport, system);
+    const auto pages = Message::packFolio(getLocalCID(), getLocalName(), system, fullPointSet, TransformMessage_Folio++, folioPoints);
+    for (const auto &page : pages)
     {
-        auto datagrams = folioMessages[page]->toQNetworkDatagrams(
-                    transport,
-                    folio,
-                    page,
-                    lastPage);
-
-        if (!SocketManager::writeDatagrams(iface, datagrams))
-            qDebug() << this << "- OTP Transform Message Failed";
+        for (const auto &destAddr : destAddrs)
+            datagrams.append(QNetworkDatagram(page, destAddr, OTP_PORT));
     }
+
+    return datagrams;
 }
@@ -0,0 +1,164 @@
+/**
+ * @file        snapshot.hpp
+ * @brief       Immutable snapshot of network point data
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SNAPSHOT_HPP
+#define SNAPSHOT_HPP
+
+#include "types.hpp"
+#include <QHash>
+#include <QVarLengthArray>
+#include <memory>
+
+namespace OTP
+{
+    /**
+     * @internal
+     * @brief Point data of one source, as published
+     */
+    typedef struct {
+        cid_t cid; /**< Component owning point */
+        bool known; /**< Is the component known, and so listed as a source */
+        priority_t priority; /**< Point priority */
+        pointDetails::standardModules_t standardModules; /**< Standard module data */
+    } pointSnapshot_t;
+
+    /**
+     * @internal
+     * @brief Point data of all sources for an address, as published
+     */
+    typedef struct {
+        cid_t winner; /**< Winning component, or null */
+        QVarLengthArray<pointSnapshot_t, 2> points; /**< Points of each source */
+    } addressSnapshot_t;
+
+    /**
+     * @internal
+     * @brief Point data of a system, as published
+     */
+    typedef QHash<address_t, addressSnapshot_t> systemSnapshot_t;
+
+    /**
+     * @internal
+     * @brief Immutable snapshot of network point data
+     * @details Published by Container, and read without locking.
+     * Systems unchanged between snapshots are shared, not copied.
+     *
+     * Lookups do not copy the shared system pointers, so concurrent readers do not contend on reference counts.
+     */
+    class networkSnapshot_t
+    {
+    public:
+        /**
+         * @brief Get the published point data of a source
+         *
+         * @param cid Component IDentifier owning point
+         * @param address Point address
+         * @return Point data, or nullptr if unknown
+         */
+        const pointSnapshot_t *find(const cid_t &cid, const address_t &address) const
+        {
+            const auto entry = findAddress(address);
+            if (!entry) return nullptr;
+            for (const auto &point : entry->points)
+                if (point.cid == cid) return &point;
+            return nullptr;
+        }
+
+        /**
+         * @brief Is the point known to any component
+         *
+         * @param address Point address
+         * @return true Point is known
+         * @return false Point is unknown
+         */
+        bool contains(const address_t &address) const { return findAddress(address) != nullptr; }
+
+        /**
+         * @brief Get the winning component for an address
+         *
+         * @param address Point address
+         * @return Winning Component IDentifier, or null if none
+         */
+        cid_t getWinner(const address_t &address) const
+        {
+            const auto entry = findAddress(address);
+            return entry ? entry->winner : cid_t();
+        }
+
+        /**
+         * @brief Get all known components with a point at an address
+         *
+         * @param address Point address
+         * @return Component IDentifiers
+         */
+        QList<cid_t> getSources(const address_t &address) const
+        {
+            QList<cid_t> ret;
+            if (const auto entry = findAddress(address))
+                for (const auto &point : entry->points)
+                    if (point.known) ret.append(point.cid);
+            return ret;
+        }
+
+        /**
+         * @brief Get the winning points of the reference frames a point is relative to
+         * @details Followed until a reference frame is unknown, or would repeat
+         *
+         * @param address Point address
+         * @param point Point data
+         * @return Reference frame points, nearest first
+         */
+        QVarLengthArray<const pointSnapshot_t*, 4> getReferenceFrames(const address_t &address, const pointSnapshot_t &point) const
+        {
+            QVarLengthArray<const pointSnapshot_t*, 4> ret;
+            QVarLengthArray<address_t, 4> previous;
+            previous.append(address);
+            auto referenceFrame = point.standardModules.referenceFrame;
+            address_t frame = {referenceFrame.getSystem(), referenceFrame.getGroup(), referenceFrame.getPoint()};
+            while (frame.isValid() && !previous.contains(frame))
+            {
+                const auto framePoint = find(getWinner(frame), frame);
+                if (!framePoint) break;
+                ret.append(framePoint);
+                previous.append(frame);
+                referenceFrame = framePoint->standardModules.referenceFrame;
+                frame = {referenceFrame.getSystem(), referenceFrame.getGroup(), referenceFrame.getPoint()};
+            }
+            return ret;
+        }
+
+        /**
+         * @brief Published systems
+         */
+        QHash<system_t, std::shared_ptr<const systemSnapshot_t>> systems;
+
+    private:
+        const addressSnapshot_t *findAddress(const address_t &address) const
+        {
+            const auto system = systems.constFind(address.system);
+            if (system == systems.cend()) return nullptr;
+            const auto entry = (*system)->constFind(address);
+            return (entry == (*system)->cend()) ? nullptr : &entry.value();
+        }
+    };
+}
+
+#endif // SNAPSHOT_HPP
@@ -22,13 +22,209 @@
 #include "socket.hpp"
 #include <QNetworkDatagram>
 #include "network/pdu/pdu_const.hpp"
+#include "spscqueue.hpp"
+#include <QThread>
+#include <QMetaMethod>
+
+#if defined(Q_OS_LINUX)
+    #include <sys/socket.h>
+    #include <poll.h>
+    #include <netinet/in.h>
+    #include <netinet/udp.h>
+    #include <arpa/inet.h>
+    #include <cerrno>
+    #include <array>
+    #include <cstring>
+    #include <vector>
+    #ifndef UDP_SEGMENT
+        #define UDP_SEGMENT 103 // Linux 4.18+, older kernels reject it and we fall back
+    #endif
+#endif
 
 using namespace OTP;
 
+#if defined(Q_OS_LINUX)
+namespace OTP
+{
+    /**
+     * @internal
+     * @brief Receive thread for a SocketManager in Thread mode
+     * @details Drains the listener socket with recvmmsg() straight into preallocated queue slots,
+     * the owning SocketManager is then notified, once per batch, on its own thread
+     */
+    class SocketReceiver : public QThread
+    {
+    public:
+        static constexpr size_t batchSize = 32; /*!< Maximum datagrams per recvmmsg() */
+
+        /**
+         * @brief Received datagram slot
+         * @details recvmmsg() writes straight into the pooled packet buffer
+         * 
+         */
+        typedef struct slot_t
+        {
+            Packet packet; /*!< Received packet */
+        } slot_t;
+        SPSCQueue<slot_t, 256> queue; /*!< Received datagrams */
+        std::atomic_bool drainPending; /*!< Owner has been notified, but not yet drained the queue */
+
+        SocketReceiver(SocketManager *manager, qintptr fd) : QThread(),
+            drainPending(false), manager(manager), fd(static_cast<int>(fd)), running(true)
+        {
+            // Destination address is needed to tell transform and advertisement messages apart
+            const int on = 1;
+            if (manager->transport == QAbstractSocket::IPv4Protocol)
+                ::setsockopt(this->fd, IPPROTO_IP, IP_PKTINFO, &on, sizeof(on));
+            else
+                ::setsockopt(this->fd, IPPROTO_IPV6, IPV6_RECVPKTINFO, &on, sizeof(on));
+            start(QThread::HighPriority);
+        }
+
+        ~SocketReceiver() { quit(); }
+
+        /**
+         * @brief Stop receive loop
+         */
+        void quit()
+        {
+            running = false;
+            wait();
+        }
+
+    protected:
+        void run() override final
+        {
+            std::array<mmsghdr, batchSize> msgs;
+            std::array<iovec, batchSize> iovecs;
+            std::array<sockaddr_storage, batchSize> senders;
+            std::array<std::array<char, CMSG_SPACE(sizeof(in6_pktinfo))>, batchSize> controls;
+            std::array<char, Packet::capacity> scratch;
+
+            while (running)
+            {
+                pollfd pfd = {fd, POLLIN, 0};
+                if (::poll(&pfd, 1, 100) <= 0) continue;
+
+                // Queue full, drop the newest datagram
+                const auto free = std::min(queue.writeAvailable(), batchSize);
+                if (!free)
+                {
+                    manager->rxSyscalls++;
+                    if (::recv(fd, scratch.data(), scratch.size(), MSG_DONTWAIT) >= 0)
+                        manager->rxDropped++;
+                    notify();
+                    continue;
+                }
+
+                for (size_t n = 0; n < free; n++)
+                {
+                    // Slots are handed back empty, fill with a fresh buffer from the pool
+                    auto &slot = queue.writeSlot(n);
+                    if (slot.packet.isNull())
+                        slot.packet = PacketPool::instance().acquire();
+                    iovecs[n].iov_base = slot.packet.data();
+                    iovecs[n].iov_len = Packet::capacity;
+                    std::memset(&msgs[n], 0, sizeof(mmsghdr));
+                    msgs[n].msg_hdr.msg_name = &senders[n];
+                    msgs[n].msg_hdr.msg_namelen = sizeof(sockaddr_storage);
+                    msgs[n].msg_hdr.msg_iov = &iovecs[n];
+                    msgs[n].msg_hdr.msg_iovlen = 1;
+                    msgs[n].msg_hdr.msg_control = controls[n].data();
+                    msgs[n].msg_hdr.msg_controllen = controls[n].size();
+                }
+
+                manager->rxSyscalls++;
+                const auto ret = ::recvmmsg(fd, msgs.data(), static_cast<unsigned int>(free), MSG_DONTWAIT, nullptr);
+                if (ret <= 0) continue;
+
+                for (int n = 0; n < ret; n++)
+                {
+                    auto block = queue.writeSlot(static_cast<size_t>(n)).packet.block;
+                    const auto &hdr = msgs[n].msg_hdr;
+                    block->size = (hdr.msg_flags & MSG_TRUNC) ? 0 : static_cast<int>(msgs[n].msg_len);
+
+                    const auto sender = reinterpret_cast<const sockaddr*>(&senders[n]);
+                    if (sender->sa_family == AF_INET)
+                    {
+                        const auto addr = reinterpret_cast<const sockaddr_in*>(sender);
+                        block->sender.family = 4;
+                        std::memcpy(block->sender.octets.data(), &addr->sin_addr, sizeof(addr->sin_addr));
+                        block->senderPort = ntohs(addr->sin_port);
+                    } else if (sender->sa_family == AF_INET6) {
+                        const auto addr = reinterpret_cast<const sockaddr_in6*>(sender);
+                        block->sender.family = 6;
+                        std::memcpy(block->sender.octets.data(), &addr->sin6_addr, sizeof(addr->sin6_addr));
+                        block->senderPort = ntohs(addr->sin6_port);
+                    }
+
+                    block->destination.family = 0;
+                    block->destinationPort = OTP::OTP_PORT;
+                    for (auto cmsg = CMSG_FIRSTHDR(&hdr); cmsg; cmsg = CMSG_NXTHDR(const_cast<msghdr*>(&hdr), cmsg))
+                    {
+                        if ((cmsg->cmsg_level == IPPROTO_IP) && (cmsg->cmsg_type == IP_PKTINFO))
+                        {
+                            in_pktinfo info;
+                            std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+                            block->destination.family = 4;
+                            std::memcpy(block->destination.octets.data(), &info.ipi_addr, sizeof(info.ipi_addr));
+                        }
+                        else if ((cmsg->cmsg_level == IPPROTO_IPV6) && (cmsg->cmsg_type == IPV6_PKTINFO))
+                        {
+                            in6_pktinfo info;
+                            std::memcpy(&info, CMSG_DATA(cmsg), sizeof(info));
+                            block->destination.family = 6;
+                            std::memcpy(block->destination.octets.data(), &info.ipi6_addr, sizeof(info.ipi6_addr));
+                        }
+                    }
+                }
+                manager->rxDatagrams += static_cast<quint64>(ret);
+                queue.commit(static_cast<size_t>(ret));
+                notify();
+            }
+        }
+
+    private:
+        /**
+         * @brief Wake the owner, unless it already has a drain pending
+         */
+        void notify()
+        {
+            if (drainPending.exchange(true)) return;
+            auto owner = manager;
+            QMetaObject::invokeMethod(owner, [owner]() { owner->drainRXQueue(); }, Qt::QueuedConnection);
+        }
+
+        SocketManager *manager;
+        const int fd;
+        std::atomic_bool running;
+    };
+}
+#else
+namespace OTP
+{
+    /**
+     * @internal
+     * @brief Receive thread placeholder, Thread mode is not available on this platform
+     */
+    class SocketReceiver {};
+}
+#endif
+
 SocketManager::SocketManager(QNetworkInterface interface, QAbstractSocket::NetworkLayerProtocol transport) : QObject(),
-    interface(interface), transport(transport)
+    interface(interface), transport(transport), rxMode(defaultRXMode())
 {
     assert( (transport == QAbstractSocket::IPv4Protocol) || (transport == QAbstractSocket::IPv6Protocol) );
+#if !defined(Q_OS_LINUX)
+    rxMode = EventLoop;
+#endif
+    setupRXSocket();
+    setupTXSocket();
+};
+
+void SocketManager::setupRXSocket()
+{
+    RXThread.reset();
     RXSocket.reset(new QUdpSocket(this));
 
     switch (transport) {
@@ -49,11 +245,20 @@ SocketManager::SocketManager(QNetworkInterface interface, QAbstractSocket::Netwo
         default: return;
     }
 
+    for (const auto &groupAddress : qAsConst(multicastGroups))
+        RXSocket->joinMulticastGroup(groupAddress, interface);
+
+    // In Thread mode the receive thread reads the socket, Qt only reports readyRead once and then waits for a read
     connect(RXSocket.get(), &QUdpSocket::readyRead, this,
         [this]() {
+            if (rxMode != EventLoop) return;
             if (!RXSocket || !RXSocket->isValid()) return;
             while (RXSocket->hasPendingDatagrams())
-                emit this->newDatagram(RXSocket->receiveDatagram());
+            {
+                rxSyscalls++;
+                rxDatagrams++;
+                emitDatagram(RXSocket->receiveDatagram());
+            }
         });
 
     connect(RXSocket.get(), &QUdpSocket::stateChanged, this,
@@ -61,14 +266,83 @@ SocketManager::SocketManager(QNetworkInterface interface, QAbstractSocket::Netwo
             if (!RXSocket || !RXSocket->isValid()) return;
             emit this->stateChanged(state);
         });
-};
+
+#if defined(Q_OS_LINUX)
+    if ((rxMode == Thread) && RXSocket->isValid())
+        RXThread.reset(new SocketReceiver(this, RXSocket->socketDescriptor()));
+#endif
+}
+
+bool SocketManager::setRXMode(rxMode_t mode)
+{
+    if (mode == rxMode) return true;
+#if !defined(Q_OS_LINUX)
+    if (mode == Thread)
+    {
+        qDebug() << this << "- Receive thread mode not supported on this platform";
+        return false;
+    }
+#endif
+    rxMode = mode;
+    setupRXSocket();
+    return true;
+}
+
+SocketManager::rxMode_t& SocketManager::defaultRXMode()
+{
+    static rxMode_t mode = EventLoop;
+    return mode;
+}
+
+void SocketManager::drainRXQueue()
+{
+#if defined(Q_OS_LINUX)
+    if (!RXThread) return;
+    RXThread->drainPending = false;
+
+    auto available = RXThread->queue.readAvailable();
+    while (available-- && RXThread)
+    {
+        // Take ownership of the buffer, the receive thread refills the slot from the pool
+        auto packet = std::move(RXThread->queue.readSlot().packet);
+        RXThread->queue.release();
+        if (!packet.size()) continue;
+
+        emitPacket(packet);
+    }
+#endif
+}
+
+void SocketManager::emitDatagram(const QNetworkDatagram &datagram)
+{
+    // Only copy into a pooled packet, and only emit the datagram, if anyone is listening
+    if (isSignalConnected(QMetaMethod::fromSignal(&SocketManager::newPacket)))
+    {
+        const auto packet = Packet::fromDatagram(datagram);
+        if (!packet.isNull()) emit this->newPacket(packet);
+    }
+
+    if (isSignalConnected(QMetaMethod::fromSignal(&SocketManager::newDatagram)))
+        emit this->newDatagram(datagram);
+}
+
+void SocketManager::emitPacket(const Packet &packet)
+{
+    emit this->newPacket(packet);
+
+    // Compatibility adapter, only convert if anyone is still listening for datagrams
+    if (isSignalConnected(QMetaMethod::fromSignal(&SocketManager::newDatagram)))
+        emit this->newDatagram(packet.toQNetworkDatagram());
+}
 
 SocketManager::~SocketManager()
 {
     instanceKey_t key = {interface.name(), transport};
     getInstances().remove(key);
+    RXThread.reset();
     RXSocket->close();
     RXSocket.release();
+    if (TXSocket) TXSocket->close();
 }
 
 SocketManager::instances_t& SocketManager::getInstances()
@@ -99,39 +373,251 @@ bool SocketManager::isValid(QNetworkInterface interface)
     );
 }
 
+bool SocketManager::isLocalDestination(const QHostAddress &address) const
+{
+    if (address.isMulticast() || address.isBroadcast()) return false;
+
+    const auto addressEntries = interface.addressEntries();
+    for (const auto &ifaceAddr : addressEntries)
+        if (ifaceAddr.ip() == address) return true;
+    return false;
+}
+
 bool SocketManager::writeDatagram(const QNetworkDatagram &datagram)
 {
     // Sending unicast to self?
-    if (!datagram.destinationAddress().isMulticast() &&
-            !datagram.destinationAddress().isBroadcast()) {
-        const auto addressEntries = interface.addressEntries();
-        for (const auto &ifaceAddr : addressEntries)
-            if (ifaceAddr.ip() == datagram.destinationAddress())
+    if (isLocalDestination(datagram.destinationAddress()))
+    {
+        emitDatagram(datagram);
+        return true;
+    }
+
+    if (!TXSocket && !setupTXSocket()) return false;
+    txStatistics.syscalls++;
+    if (TXSocket->writeDatagram(datagram) == datagram.data().size())
+    {
+        txStatistics.datagrams++;
+        return true;
+    }
+
+    // Interface may have changed underneath us, rebuild and retry once
+    interface = QNetworkInterface::interfaceFromName(interface.name());
+    if (!setupTXSocket()) return false;
+    txStatistics.syscalls++;
+    if (TXSocket->writeDatagram(datagram) != datagram.data().size()) return false;
+    txStatistics.datagrams++;
+    return true;
+}
+
+bool SocketManager::writeDatagrams(const QList<QNetworkDatagram> &datagrams)
+{
+    QList<QNetworkDatagram> outgoing;
+    outgoing.reserve(datagrams.count());
+    for (const auto &datagram : datagrams)
+    {
+        // Sending unicast to self?
+        if (isLocalDestination(datagram.destinationAddress()))
+            emitDatagram(datagram);
+        else
+            outgoing.append(datagram);
+    }
+    if (outgoing.isEmpty()) return true;
+
+    if (!TXSocket && !setupTXSocket()) return false;
+
+    // Only this instances transport can be batched, anything else goes one at a time
+    QList<QNetworkDatagram> batch;
+    QList<QNetworkDatagram> leftover;
+    batch.reserve(outgoing.count());
+    for (const auto &datagram : qAsConst(outgoing))
+    {
+        if (datagram.destinationAddress().protocol() == transport)
+            batch.append(datagram);
+        else
+            leftover.append(datagram);
+    }
+
+    // Batched send, anything the batch did not send joins the leftovers
+    const auto sent = writeDatagramsNative(batch);
+    leftover.append(batch.mid(std::max(sent, 0)));
+
+    bool ret = true;
+    for (const auto &datagram : qAsConst(leftover))
+        if (!writeDatagram(datagram))
+        {
+            qDebug() << this << "- writeDatagram() failed to" << datagram.destinationAddress();
+            ret = false;
+        }
+    return ret;
+}
+
+#if defined(Q_OS_LINUX)
+int SocketManager::writeDatagramsNative(const QList<QNetworkDatagram> &datagrams)
+{
+    const auto fd = TXSocket->socketDescriptor();
+    if (fd == -1) return 0;
+
+    // Keep payloads alive, and their storage stable, for the duration of the call
+    const auto count = datagrams.count();
+    std::vector<QByteArray> payloads(static_cast<size_t>(count));
+    std::vector<iovec> iovecs(static_cast<size_t>(count));
+    std::vector<sockaddr_storage> addrs(static_cast<size_t>(count));
+    std::vector<socklen_t> addrLens(static_cast<size_t>(count));
+    for (int n = 0; n < count; n++)
+    {
+        const auto &datagram = datagrams.at(n);
+        const auto destination = datagram.destinationAddress();
+        if (destination.protocol() != transport) return 0;
+
+        payloads[n] = datagram.data();
+        iovecs[n].iov_base = const_cast<char*>(payloads[n].constData());
+        iovecs[n].iov_len = static_cast<size_t>(payloads[n].size());
+
+        std::memset(&addrs[n], 0, sizeof(sockaddr_storage));
+        if (transport == QAbstractSocket::IPv4Protocol)
+        {
+            auto addr = reinterpret_cast<sockaddr_in*>(&addrs[n]);
+            addr->sin_family = AF_INET;
+            addr->sin_port = htons(static_cast<quint16>(datagram.destinationPort()));
+            addr->sin_addr.s_addr = htonl(destination.toIPv4Address());
+            addrLens[n] = sizeof(sockaddr_in);
+        } else {
+            auto addr = reinterpret_cast<sockaddr_in6*>(&addrs[n]);
+            addr->sin6_family = AF_INET6;
+            addr->sin6_port = htons(static_cast<quint16>(datagram.destinationPort()));
+            const auto ipv6 = destination.toIPv6Address();
+            std::memcpy(&addr->sin6_addr, &ipv6, sizeof(addr->sin6_addr));
+            addr->sin6_scope_id = destination.scopeId().toUInt();
+            addrLens[n] = sizeof(sockaddr_in6);
+        }
+    }
+
+    // Build messages, coalescing runs to the same destination into a single GSO send
+    // A GSO run is any number of equally sized segments, optionally followed by one shorter final segment
+    const size_t gsoMaxSegments = 64;
+    const size_t gsoMaxBytes = 65000;
+    std::vector<mmsghdr> msgs;
+    std::vector<int> msgDatagrams;
+    std::vector<std::array<char, CMSG_SPACE(sizeof(quint16))>> controls(static_cast<size_t>(count));
+    msgs.reserve(static_cast<size_t>(count));
+    msgDatagrams.reserve(static_cast<size_t>(count));
+    for (int n = 0; n < count;)
+    {
+        int run = 1;
+        if (gsoAvailable)
+        {
+            const auto segmentSize = iovecs[n].iov_len;
+            size_t total = segmentSize;
+            while ((n + run < count)
+                   && (static_cast<size_t>(run) < gsoMaxSegments)
+                   && (iovecs[n + run - 1].iov_len == segmentSize)
+                   && (iovecs[n + run].iov_len <= segmentSize)
+                   && (total + iovecs[n + run].iov_len <= gsoMaxBytes)
+                   && (addrLens[n + run] == addrLens[n])
+                   && (std::memcmp(&addrs[n + run], &addrs[n], addrLens[n]) == 0))
+            {
+                total += iovecs[n + run].iov_len;
+                run++;
+            }
+        }
+
+        mmsghdr msg;
+        std::memset(&msg, 0, sizeof(msg));
+        msg.msg_hdr.msg_name = &addrs[n];
+        msg.msg_hdr.msg_namelen = addrLens[n];
+        msg.msg_hdr.msg_iov = &iovecs[n];
+        msg.msg_hdr.msg_iovlen = static_cast<size_t>(run);
+        if (run > 1)
+        {
+            auto &control = controls[msgs.size()];
+            msg.msg_hdr.msg_control = control.data();
+            msg.msg_hdr.msg_controllen = control.size();
+            auto cmsg = CMSG_FIRSTHDR(&msg.msg_hdr);
+            cmsg->cmsg_level = IPPROTO_UDP;
+            cmsg->cmsg_type = UDP_SEGMENT;
+            cmsg->cmsg_len = CMSG_LEN(sizeof(quint16));
+            const quint16 segmentSize = static_cast<quint16>(iovecs[n].iov_len);
+            std::memcpy(CMSG_DATA(cmsg), &segmentSize, sizeof(segmentSize));
+        }
+        msgs.push_back(msg);
+        msgDatagrams.push_back(run);
+        n += run;
+    }
+
+    // Submit
+    int sentDatagrams = 0;
+    size_t sentMsgs = 0;
+    while (sentMsgs < msgs.size())
+    {
+        txStatistics.syscalls++;
+        const auto ret = ::sendmmsg(
+                    static_cast<int>(fd),
+                    &msgs[sentMsgs],
+                    static_cast<unsigned int>(msgs.size() - sentMsgs),
+                    0);
+        if (ret < 0)
+        {
+            if (errno == EINTR) continue;
+            if (gsoAvailable && (msgDatagrams[sentMsgs] > 1)
+                    && ((errno == EINVAL) || (errno == EIO) || (errno == ENOPROTOOPT)))
             {
-                emit this->newDatagram(datagram);
-                return true;
+                qDebug() << this << "- UDP GSO unavailable, disabling";
+                gsoAvailable = false;
             }
+            break;
+        }
+        for (int m = 0; m < ret; m++)
+            sentDatagrams += msgDatagrams[sentMsgs + static_cast<size_t>(m)];
+        sentMsgs += static_cast<size_t>(ret);
     }
 
-    auto socket = QUdpSocket();
+    txStatistics.datagrams += static_cast<quint64>(sentDatagrams);
+    return sentDatagrams;
+}
+#else
+int SocketManager::writeDatagramsNative(const QList<QNetworkDatagram> &datagrams)
+{
+    // No batched send on this platform
+    Q_UNUSED(datagrams)
+    return 0;
+}
+#endif
+
+bool SocketManager::setupTXSocket()
+{
+    TXSocket.reset(new QUdpSocket());
+    TXAddress.clear();
+
     const auto addressEntries = interface.addressEntries();
     for (const auto &ifaceAddr : addressEntries)
-        if (ifaceAddr.ip().protocol() == transport)
-            socket.bind(ifaceAddr.ip());
+        if ((ifaceAddr.ip().protocol() == transport) && TXSocket->bind(ifaceAddr.ip()))
+        {
+            TXAddress = ifaceAddr.ip();
+            break;
+        }
+
+    if (TXAddress.isNull())
+    {
+        qDebug() << this << "- Failed to bind transmit socket on" << interface.humanReadableName();
+        TXSocket.reset();
+        return false;
+    }
 
-    socket.setSocketOption(QAbstractSocket::MulticastLoopbackOption, QVariant(1));
-    socket.setMulticastInterface(interface);
+    TXSocket->setSocketOption(QAbstractSocket::MulticastLoopbackOption, QVariant(1));
+    TXSocket->setMulticastInterface(interface);
 
-    return socket.writeDatagram(datagram) == datagram.data().size();
+    return true;
 }
 
 bool SocketManager::joinMulticastGroup(const QHostAddress &groupAddress)
 {
+    multicastGroups.insert(groupAddress);
     return RXSocket->joinMulticastGroup(groupAddress, interface);
 }
 
 bool SocketManager::leaveMulticastGroup(const QHostAddress &groupAddress)
 {
+    multicastGroups.remove(groupAddress);
     return RXSocket->leaveMulticastGroup(groupAddress, interface);
 }
 
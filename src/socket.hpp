@@ -25,6 +25,9 @@
 #include <QUdpSocket>
 #include <QNetworkDatagram>
 #include <QNetworkInterface>
+#include <QSet>
+#include "packet.hpp"
+#include <atomic>
 #include <exception>
 #include <memory>
 
@@ -56,6 +59,8 @@ namespace OTP
     inline bool operator<=(const Q_IPV6ADDR& l, const Q_IPV6ADDR& r){ return !(l > r); }
     inline bool operator>=(const Q_IPV6ADDR& l, const Q_IPV6ADDR& r){ return !(l < r); }
 
+    class SocketReceiver;
+
     /**
      * @internal
      * @brief Socket manager and socket interface
@@ -89,24 +94,66 @@ namespace OTP
         static bool isValid(QNetworkInterface interface);
 
         /**
-         * @brief Send a network datagram, on a specfic network interface
+         * @brief Send network datagrams, on a specfic network interface
+         * @details Datagrams are grouped by transport and handed to each socket as a single batch
          * 
          * @param interface Network interface to use
-         * @param datagrams Datagram to send
+         * @param datagrams Datagrams to send
          * @return true Send successful
          * @return false Send failed
          */
         static bool writeDatagrams(QNetworkInterface interface, const QList<QNetworkDatagram> &datagrams)
         {
+            QMap<QAbstractSocket::NetworkLayerProtocol, QList<QNetworkDatagram>> batches;
             for (const auto &datagram : datagrams)
-                if (!getSocket(interface, datagram.destinationAddress().protocol())->writeDatagram(datagram))
+                batches[datagram.destinationAddress().protocol()].append(datagram);
+
+            for (auto it = batches.cbegin(); it != batches.cend(); ++it)
+                if (!getSocket(interface, it.key())->writeDatagrams(it.value()))
                 {
-                    qDebug() << "writeDatagram() failed to" << datagram.destinationAddress();
+                    qDebug() << "writeDatagrams() failed on" << interface.humanReadableName();
                     return false;
                 }
             return true;
         }
 
+        /**
+         * @brief Send several network datagrams as a single batch
+         * @details On Linux the batch is submitted with sendmmsg(), coalescing runs of equally sized datagrams
+         * to the same destination with UDP GSO where the kernel supports it.
+         * Other platforms, datagrams not of this instances transport, or any datagrams the batched path could not send,
+         * fall back to writeDatagram()
+         * 
+         * @param datagrams Datagrams to send
+         * @return true Send successful
+         * @return false One or more datagrams failed to send, the remainder are still attempted
+         */
+        bool writeDatagrams(const QList<QNetworkDatagram> &datagrams);
+
+        /**
+         * @brief Transmit statistics
+         * 
+         */
+        typedef struct txStatistics_t
+        {
+            quint64 datagrams = 0; /*!< Datagrams transmitted */
+            quint64 syscalls = 0; /*!< Send system calls made */
+
+            /**
+             * @brief System calls saved by batching, compared to one call per datagram
+             * 
+             * @return Saved system calls
+             */
+            quint64 syscallsSaved() const { return (datagrams > syscalls) ? datagrams - syscalls : 0; }
+        } txStatistics_t;
+
+        /**
+         * @brief Get the transmit statistics for this socket
+         * 
+         * @return Transmit statistics
+         */
+        txStatistics_t getTXStatistics() const { return txStatistics; }
+
         /**
          * @brief Send a network datagram
          * 
@@ -164,6 +211,73 @@ namespace OTP
             return ret;
         }
 
+        /**
+         * @brief Receive modes
+         * 
+         */
+        typedef enum rxMode_e
+        {
+            EventLoop, /**< Datagrams are read on the Qt event loop as they arrive */
+            Thread /**< Datagrams are drained by a dedicated receive thread and handed to the event loop in batches */
+        } rxMode_t;
+
+        /**
+         * @brief Set the receive mode used by new sockets
+         * 
+         * @param mode New default receive mode
+         */
+        static void setDefaultRXMode(rxMode_t mode) { defaultRXMode() = mode; }
+
+        /**
+         * @brief Get the receive mode used by new sockets
+         * 
+         * @return Default receive mode
+         */
+        static rxMode_t getDefaultRXMode() { return defaultRXMode(); }
+
+        /**
+         * @brief Set the receive mode of this socket
+         * @details The listener socket is rebuilt, and any multicast groups rejoined.
+         * Thread mode is only available on Linux
+         * 
+         * @param mode New receive mode
+         * @return true Mode changed
+         * @return false Mode not supported on this platform
+         */
+        bool setRXMode(rxMode_t mode);
+
+        /**
+         * @brief Get the receive mode of this socket
+         * 
+         * @return Current receive mode
+         */
+        rxMode_t getRXMode() const { return rxMode; }
+
+        /**
+         * @brief Receive statistics
+         * 
+         */
+        typedef struct rxStatistics_t
+        {
+            quint64 datagrams = 0; /*!< Datagrams received */
+            quint64 syscalls = 0; /*!< Receive system calls made */
+            quint64 dropped = 0; /*!< Datagrams dropped as the receive queue was full */
+        } rxStatistics_t;
+
+        /**
+         * @brief Get the receive statistics for this socket
+         * 
+         * @return Receive statistics
+         */
+        rxStatistics_t getRXStatistics() const
+        {
+            rxStatistics_t ret;
+            ret.datagrams = rxDatagrams;
+            ret.syscalls = rxSyscalls;
+            ret.dropped = rxDropped;
+            return ret;
+        }
+
         /**
          * @brief Obtain the current state of this socket
          * 
@@ -172,8 +286,18 @@ namespace OTP
         QAbstractSocket::SocketState state();
 
     signals:
+        /**
+         * @brief Emitted when a new packet is received
+         * @details Copies of the packet share its pooled buffer.
+         * The receive thread reads straight into the buffer, the event loop copies each datagram into one
+         * 
+         * @param packet New packet
+         */
+        void newPacket(OTP::Packet packet);
+
         /**
          * @brief Emitted when a new datagram is received
+         * @details Compatibility signal, prefer newPacket()
          * 
          * @param datagram New datagram
          */
@@ -201,6 +325,52 @@ namespace OTP
         QAbstractSocket::NetworkLayerProtocol transport; /*!< Network transport to this instance */
         void setupRXSocket(); /*!< Setup listener socket for this instance */
         std::unique_ptr<QUdpSocket> RXSocket; /*!< Listener socket for this instance */
+        QSet<QHostAddress> multicastGroups; /*!< Multicast groups joined by the listener socket */
+
+        friend class SocketReceiver;
+        static rxMode_t& defaultRXMode(); /*!< Receive mode for new instances */
+        rxMode_t rxMode; /*!< Receive mode of this instance */
+        std::unique_ptr<SocketReceiver> RXThread; /*!< Receive thread, in Thread mode */
+        void drainRXQueue(); /*!< Emit all datagrams queued by the receive thread */
+        void emitPacket(const Packet &packet); /*!< Emit received packet, and datagram if anyone is listening */
+        void emitDatagram(const QNetworkDatagram &datagram); /*!< Emit received datagram, and packet */
+        std::atomic<quint64> rxDatagrams{0}; /*!< Datagrams received */
+        std::atomic<quint64> rxSyscalls{0}; /*!< Receive system calls made */
+        std::atomic<quint64> rxDropped{0}; /*!< Datagrams dropped */
+
+        /**
+         * @internal
+         * @brief Setup transmit socket for this instance
+         * @details Binds to the interface address for this transport and sets the multicast options once,
+         * the socket is then reused for every outgoing datagram
+         * 
+         * @return true Setup successful
+         * @return false Setup failed
+         */
+        bool setupTXSocket();
+        std::unique_ptr<QUdpSocket> TXSocket; /*!< Transmit socket for this instance */
+        QHostAddress TXAddress; /*!< Interface address the transmit socket is bound to */
+        txStatistics_t txStatistics; /*!< Transmit statistics */
+
+        /**
+         * @internal
+         * @brief Is the destination one of this interfaces own addresses
+         * 
+         * @param address Destination address
+         * @return true Unicast to self
+         * @return false Remote, multicast, or broadcast destination
+         */
+        bool isLocalDestination(const QHostAddress &address) const;
+
+        /**
+         * @internal
+         * @brief Platform batched send
+         * 
+         * @param datagrams Datagrams to send, all of this instances transport
+         * @return Number of datagrams sent from the front of the list, 0 if any are not of this instances transport
+         */
+        int writeDatagramsNative(const QList<QNetworkDatagram> &datagrams);
+        bool gsoAvailable = true; /*!< Cleared if the kernel rejects UDP GSO */
     };
 }
 
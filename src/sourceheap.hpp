@@ -0,0 +1,175 @@
+/**
+ * @file        sourceheap.hpp
+ * @brief       Priority ordered sources of an address
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef SOURCEHEAP_HPP
+#define SOURCEHEAP_HPP
+
+#include "types.hpp"
+#include <QVarLengthArray>
+#include <utility>
+
+namespace OTP
+{
+    /**
+     * @internal
+     * @brief Priority ordered sources of an address
+     * @details A binary max heap, ordered by priority with ties won by the most recently ranked source.
+     * The winner is always at the top.
+     *
+     * Addresses have few sources, so entries are stored inline and located by a scan of the heap,
+     * reordering after a change is O(log n).
+     *
+     * @tparam Handle Source identifier
+     */
+    template <typename Handle>
+    class sourceHeap_t
+    {
+    public:
+        /**
+         * @brief Is the heap empty
+         *
+         * @return true No sources
+         * @return false Has sources
+         */
+        bool isEmpty() const { return heap.isEmpty(); }
+
+        /**
+         * @brief Get number of sources
+         *
+         * @return Number of sources
+         */
+        int size() const { return static_cast<int>(heap.size()); }
+
+        /**
+         * @brief Get the winning source
+         * @details Heap must not be empty
+         *
+         * @return Winning source
+         */
+        Handle top() const { return heap.at(0).handle; }
+
+        /**
+         * @brief Is a source in the heap
+         *
+         * @param handle Source to find
+         * @return true Source is in the heap
+         * @return false Source is not in the heap
+         */
+        bool contains(Handle handle) const { return find(handle) >= 0; }
+
+        /**
+         * @brief Add a source, or change its priority
+         * @details A source is ranked as most recent when added, or when its priority changes
+         *
+         * @param handle Source
+         * @param priority Source priority
+         * @param sequence Ranking sequence number, increasing with each call
+         */
+        void set(Handle handle, priority_t priority, quint64 sequence)
+        {
+            auto index = find(handle);
+            if (index < 0)
+            {
+                heap.append({handle, priority, sequence});
+                siftUp(size() - 1);
+                return;
+            }
+
+            if (heap[index].priority == priority) return;
+            const bool raised = priority > heap[index].priority;
+            heap[index].priority = priority;
+            heap[index].sequence = sequence;
+            if (raised) siftUp(index); else siftDown(index);
+        }
+
+        /**
+         * @brief Remove a source
+         *
+         * @param handle Source to remove
+         * @return true Source was removed
+         * @return false Source was not in the heap
+         */
+        bool remove(Handle handle)
+        {
+            const auto index = find(handle);
+            if (index < 0) return false;
+
+            const auto last = size() - 1;
+            if (index != last)
+            {
+                heap[index] = heap[last];
+                heap.removeLast();
+                siftDown(siftUp(index));
+            } else
+                heap.removeLast();
+            return true;
+        }
+
+    private:
+        typedef struct {
+            Handle handle;
+            priority_t priority;
+            quint64 sequence;
+        } entry_t;
+
+        static bool before(const entry_t &l, const entry_t &r)
+        {
+            if (l.priority != r.priority) return l.priority > r.priority;
+            return l.sequence > r.sequence;
+        }
+
+        int find(Handle handle) const
+        {
+            for (int index = 0; index < size(); index++)
+                if (heap[index].handle == handle) return index;
+            return -1;
+        }
+
+        int siftUp(int index)
+        {
+            while (index > 0)
+            {
+                const auto parent = (index - 1) / 2;
+                if (!before(heap[index], heap[parent])) break;
+                std::swap(heap[index], heap[parent]);
+                index = parent;
+            }
+            return index;
+        }
+
+        int siftDown(int index)
+        {
+            while (true)
+            {
+                auto best = index;
+                for (const auto child : {(index * 2) + 1, (index * 2) + 2})
+                    if ((child < size()) && before(heap[child], heap[best])) best = child;
+                if (best == index) return index;
+                std::swap(heap[index], heap[best]);
+                index = best;
+            }
+        }
+
+        QVarLengthArray<entry_t, 2> heap;
+    };
+}
+
+#endif // SOURCEHEAP_HPP
@@ -0,0 +1,126 @@
+/**
+ * @file        spscqueue.hpp
+ * @brief       Lock-free single producer, single consumer, ring buffer
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2024 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+
+#ifndef SPSCQUEUE_HPP
+#define SPSCQUEUE_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <memory>
+
+/**
+ * @internal
+ * @brief Lock-free single producer, single consumer, ring buffer
+ * @details Slots are allocated once, at construction, and written in place.
+ * The producer fills slots obtained from writeSlot() and publishes them with commit(),
+ * the consumer reads slots obtained from readSlot() and returns them with release()
+ * 
+ * @tparam T Slot type
+ * @tparam Capacity Number of slots, must be a power of two
+ */
+template <typename T, size_t Capacity>
+class SPSCQueue
+{
+    static_assert((Capacity > 0) && ((Capacity & (Capacity - 1)) == 0), "Capacity must be a power of two");
+
+public:
+    SPSCQueue() : slots(new T[Capacity]), head(0), tail(0) {}
+
+    SPSCQueue(const SPSCQueue&) = delete;
+    SPSCQueue& operator=(const SPSCQueue&) = delete;
+
+    /**
+     * @brief Number of slots
+     * 
+     * @return Queue capacity
+     */
+    static constexpr size_t capacity() { return Capacity; }
+
+    /**
+     * @brief Producer - Number of free slots
+     * 
+     * @return Free slots
+     */
+    size_t writeAvailable() const
+    {
+        return Capacity - (head.load(std::memory_order_relaxed) - tail.load(std::memory_order_acquire));
+    }
+
+    /**
+     * @brief Producer - Get a free slot to write into
+     * 
+     * @param offset Offset from the next free slot, must be less than writeAvailable()
+     * @return Slot
+     */
+    T& writeSlot(size_t offset = 0)
+    {
+        return slots[(head.load(std::memory_order_relaxed) + offset) & (Capacity - 1)];
+    }
+
+    /**
+     * @brief Producer - Publish written slots to the consumer
+     * 
+     * @param count Number of slots to publish
+     */
+    void commit(size_t count = 1)
+    {
+        head.store(head.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+    /**
+     * @brief Consumer - Number of published slots
+     * 
+     * @return Slots ready to read
+     */
+    size_t readAvailable() const
+    {
+        return head.load(std::memory_order_acquire) - tail.load(std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Consumer - Get a published slot
+     * 
+     * @param offset Offset from the oldest published slot, must be less than readAvailable()
+     * @return Slot
+     */
+    T& readSlot(size_t offset = 0)
+    {
+        return slots[(tail.load(std::memory_order_relaxed) + offset) & (Capacity - 1)];
+    }
+
+    /**
+     * @brief Consumer - Return read slots to the producer
+     * 
+     * @param count Number of slots to return
+     */
+    void release(size_t count = 1)
+    {
+        tail.store(tail.load(std::memory_order_relaxed) + count, std::memory_order_release);
+    }
+
+private:
+    std::unique_ptr<T[]> slots;
+    alignas(64) std::atomic<size_t> head; /*!< Next slot to write, owned by producer */
+    alignas(64) std::atomic<size_t> tail; /*!< Next slot to read, owned by consumer */
+};
+
+#endif // SPSCQUEUE_HPP
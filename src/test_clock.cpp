@@ -0,0 +1,166 @@
+#include "test_clock.hpp"
+#include "container.hpp"
+#include "const.hpp"
+#include <QLoggingCategory>
+#include <QElapsedTimer>
+
+using namespace std::chrono_literals;
+using namespace OTP;
+
+int test_clock(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    TEST_OTP::Clock testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::Clock::ticks()
+{
+    QVERIFY(CLOCK::isExpired(CLOCK::never, 1h));
+    QVERIFY(!CLOCK::isExpired(100, 10ns, 110));
+    QVERIFY(CLOCK::isExpired(100, 10ns, 111));
+    QCOMPARE(CLOCK::remaining(0, 100ms, CLOCK::toTicks(40ms)), std::chrono::milliseconds(60));
+    QCOMPARE(CLOCK::remaining(0, 100ms, CLOCK::toTicks(200ms)), std::chrono::milliseconds(0));
+    QVERIFY(CLOCK::toDateTime(CLOCK::never).isNull());
+
+    // Steady clock
+    QVERIFY(!CLOCK::getSource());
+    const auto before = CLOCK::now();
+    QTest::qSleep(1);
+    QVERIFY(CLOCK::now() > before);
+}
+
+void TEST_OTP::Clock::virtualClock()
+{
+    {
+        CLOCK::virtualClock_t clock(CLOCK::toTicks(1s));
+        QCOMPARE(CLOCK::getSource(), static_cast<const CLOCK::source_t*>(&clock));
+        QCOMPARE(CLOCK::virtualClock_t::getInstalled(), &clock);
+        QCOMPARE(CLOCK::now(), CLOCK::toTicks(1s));
+
+        clock.advance(1h);
+        QCOMPARE(CLOCK::now(), CLOCK::toTicks(1h + 1s));
+        QVERIFY(qAbs(CLOCK::toDateTime(CLOCK::toTicks(1s)).msecsTo(QDateTime::currentDateTime().addSecs(-3600))) < 1000);
+
+        // Liveness follows virtual time
+        component_t component;
+        component.addModuleItem({0, 1});
+        QVERIFY(!component.isExpired());
+        QVERIFY(!component.isExpired({0, 1}));
+        clock.advance(OTP_COMPONENT_TIMEOUT + 1ms);
+        QVERIFY(component.isExpired());
+        QVERIFY(component.isExpired({0, 1}));
+    }
+    QVERIFY(!CLOCK::getSource());
+    QVERIFY(!CLOCK::virtualClock_t::getInstalled());
+}
+
+void TEST_OTP::Clock::timers()
+{
+    CLOCK::virtualClock_t clock;
+    QList<std::pair<QString, CLOCK::ticks_t>> fired;
+
+    CLOCK::Timer repeating;
+    repeating.setInterval(100ms);
+    connect(&repeating, &CLOCK::Timer::timeout, this, [&fired]() { fired.append({"repeating", CLOCK::now()}); });
+    repeating.start();
+    QVERIFY(repeating.isActive());
+
+    CLOCK::Timer singleShot;
+    singleShot.setSingleShot(true);
+    connect(&singleShot, &CLOCK::Timer::timeout, this, [&fired]() { fired.append({"singleShot", CLOCK::now()}); });
+    singleShot.start(250ms);
+
+    clock.advance(99ms);
+    QVERIFY(fired.isEmpty());
+
+    clock.advance(251ms);
+    QCOMPARE(fired, (QList<std::pair<QString, CLOCK::ticks_t>>({
+        {"repeating", CLOCK::toTicks(100ms)},
+        {"repeating", CLOCK::toTicks(200ms)},
+        {"singleShot", CLOCK::toTicks(250ms)},
+        {"repeating", CLOCK::toTicks(300ms)}})));
+    QCOMPARE(CLOCK::now(), CLOCK::toTicks(350ms));
+    QVERIFY(!singleShot.isActive());
+    QVERIFY(repeating.isActive());
+
+    // Stopped
+    fired.clear();
+    repeating.stop();
+    QVERIFY(!repeating.isActive());
+    clock.advance(1s);
+    QVERIFY(fired.isEmpty());
+    QCOMPARE(clock.timerCount(), size_t(0));
+
+    // Destroyed while scheduled
+    {
+        CLOCK::Timer destroyed;
+        destroyed.start(1s);
+        QCOMPARE(clock.timerCount(), size_t(1));
+    }
+    QCOMPARE(clock.timerCount(), size_t(0));
+}
+
+void TEST_OTP::Clock::expiry()
+{
+    CLOCK::virtualClock_t clock;
+    OTP::Container container;
+    QSignalSpy expiredPoint(&container, &OTP::Container::expiredPoint);
+    QSignalSpy removedComponent(&container, &OTP::Container::removedComponent);
+
+    const auto cid = cid_t::createUuid();
+    container.addComponent(cid, QHostAddress::LocalHost);
+    container.addPoint(cid, {1, 1, 1}, 100);
+
+    // Points
+    clock.advance(OTP_TRANSFORM_DATA_LOSS_TIMEOUT - 1s);
+    container.addPoint(cid, {1, 1, 1}, 100);
+    clock.advance(OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
+    QCOMPARE(expiredPoint.count(), 0);
+    clock.advance(1s);
+    QCOMPARE(expiredPoint.count(), 1);
+
+    // Components
+    clock.advance(OTP_COMPONENT_TIMEOUT - OTP_TRANSFORM_DATA_LOSS_TIMEOUT - 2s);
+    QCOMPARE(removedComponent.count(), 0);
+    clock.advance(2s);
+    QCOMPARE(removedComponent.count(), 1);
+    QVERIFY(container.getComponentList().isEmpty());
+}
+
+void TEST_OTP::Clock::soak()
+{
+    // An hour of components joining each second, and timing out
+    constexpr int perSecond = 20;
+    constexpr auto duration = 1h;
+    const auto components = [](int second) {
+        QList<cid_t> ret;
+        for (int n = 0; n < perSecond; n++)
+            ret.append(QUuid(second, 0, n, 0, 0, 0, 0, 0, 0, 0, 0));
+        return ret;
+    };
+
+    QLoggingCategory::setFilterRules("default.debug=false");
+    CLOCK::virtualClock_t clock;
+    OTP::Container container;
+    QSignalSpy removedComponent(&container, &OTP::Container::removedComponent);
+
+    QElapsedTimer elapsed;
+    elapsed.start();
+    const auto seconds = static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(duration).count());
+    for (int second = 0; second <= seconds; second++)
+    {
+        for (const auto &cid : components(second))
+            container.addComponent(cid, QHostAddress::LocalHost);
+        clock.advance(1s);
+    }
+    QLoggingCategory::setFilterRules("default.debug=true");
+    qInfo() << "Simulated" << seconds << "s in" << elapsed.elapsed() << "ms";
+
+    // Those heard from within the component timeout remain
+    const auto remaining = static_cast<int>(std::chrono::duration_cast<std::chrono::seconds>(OTP_COMPONENT_TIMEOUT).count());
+    QCOMPARE(container.getComponentList().size(), remaining * perSecond);
+    QCOMPARE(removedComponent.count(), (seconds + 1 - remaining) * perSecond);
+    for (const auto &cid : components(seconds))
+        QVERIFY(container.getComponentList().contains(cid));
+}
@@ -0,0 +1,28 @@
+#ifndef TEST_CLOCK_H
+#define TEST_CLOCK_H
+
+#include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+
+#include "clock.hpp"
+
+namespace TEST_OTP
+{
+    class Clock : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        Clock() = default;
+        ~Clock() = default;
+
+    private slots:
+        void ticks();
+        void virtualClock();
+        void timers();
+        void expiry();
+        void soak();
+    };
+}
+
+#endif // TEST_CLOCK_H
@@ -0,0 +1,294 @@
+#include "test_consumer.hpp"
+#include "socket.hpp"
+
+using namespace std::chrono_literals;
+using namespace OTP;
+using XYZ_t = OTP::Consumer::XYZ_t;
+using namespace MODULES::STANDARD;
+
+namespace
+{
+    // Consumer with access to its container, to add points without a producer
+    class consumer_t : public OTP::Consumer
+    {
+    public:
+        using OTP::Consumer::Consumer;
+        Container &network() { return *otpNetwork; }
+    };
+
+    // Add points 1 to count in group 1, each with a position and rotation of its point number
+    QVector<address_t> addPoints(Container &container, const cid_t &cid, system_t system, int count)
+    {
+        QVector<address_t> addresses;
+        QVector<Container::pointUpdate_t> points;
+        for (int point = 1; point <= count; point++)
+        {
+            addresses.append({system, 1, point});
+            points.append({addresses.last(), 100, pointDetails::standardModules_t()});
+            auto &standardModules = points.last().standardModules;
+            for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+            {
+                standardModules.position.setPosition(axis, point);
+                standardModules.rotation.setRotation(axis, point);
+            }
+        }
+        container.applyPointBatch(cid, system, points, {});
+        container.publishSnapshot();
+        return addresses;
+    }
+
+    // Transform folio pages for points 1 to count in group 1, each with an X position of its point number plus offset
+    QList<QByteArray> transformFolio(const cid_t &cid, system_t system, PDU::OTPLayer::folio_t folio, int count, int offset)
+    {
+        using namespace MESSAGES::OTPTransformMessage;
+        QVector<QByteArray> points;
+        for (quint32 point = 1; point <= static_cast<quint32>(count); point++)
+        {
+            PositionModule_t position;
+            position.setPosition(axis_t::X, static_cast<qint32>(point) + offset);
+            additional_t additional;
+            additional << position;
+            points.append(Message::packPoint({{100, {system, 1, point}, 1, {ESTA_MANUFACTURER_ID, POSITION}, additional}}));
+        }
+        return Message::packFolio(cid, QByteArray("Producer"), system, true, folio, points);
+    }
+
+    // Deliver a page to every component on the interface, as if received
+    void receive(const QNetworkInterface &iface, const QByteArray &page)
+    {
+        QVERIFY(SocketManager::writeDatagrams(iface, {QNetworkDatagram(page, QHostAddress::LocalHost, OTP_PORT)}));
+    }
+}
+
+int test_consumer(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    TEST_OTP::Consumer testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::Consumer::initTestCase()
+{
+    const auto interfaces = QNetworkInterface::allInterfaces();
+    for (const auto &interface : interfaces)
+        if (interface.flags().testFlag(QNetworkInterface::IsLoopBack)
+                && interface.flags().testFlag(QNetworkInterface::IsUp))
+        {
+            iface = interface;
+            break;
+        }
+    if (!iface.isValid())
+        QSKIP("No loopback interface available");
+}
+
+void TEST_OTP::Consumer::moduleValues()
+{
+    consumer_t consumer(iface, QAbstractSocket::IPv4Protocol, {});
+    auto &container = consumer.network();
+    const auto cid = cid_t::createUuid();
+    const system_t system = 1;
+    container.addComponent(cid, QHostAddress::LocalHost);
+
+    // Point 1 in mm, point 2 in um, and point 3 relative to point 2
+    QVector<Container::pointUpdate_t> points;
+    for (int point = 1; point <= 3; point++)
+        points.append({{system, 1, point}, 100, pointDetails::standardModules_t()});
+    auto &first = points[0].standardModules;
+    first.position.setScaling(PositionModule_t::mm);
+    first.position.setPosition(axis_t::X, 1);
+    first.position.setPosition(axis_t::Y, 2);
+    first.position.setPosition(axis_t::Z, 3);
+    first.rotation.setRotation(axis_t::Z, 90000000);
+    auto &second = points[1].standardModules;
+    second.position.setScaling(PositionModule_t::um);
+    second.position.setPosition(axis_t::X, 4000);
+    auto &third = points[2].standardModules;
+    third.position.setScaling(PositionModule_t::um);
+    third.position.setPosition(axis_t::X, 10);
+    third.referenceFrame.setSystem(system, 0);
+    third.referenceFrame.setGroup(1, 0);
+    third.referenceFrame.setPoint(2, 0);
+    container.applyPointBatch(cid, system, points, {});
+    container.publishSnapshot();
+
+    const QVector<address_t> addresses({{system, 1, 1}, {system, 1, 2}, {system, 1, 3}, {system, 1, 4}});
+    QVector<XYZ_t> values(addresses.size());
+
+    // Positions in um, unknown addresses zeroed
+    values.fill({1, 1, 1});
+    QCOMPARE(consumer.getModuleValues(VALUES::POSITION, addresses, values.data()), 3);
+    QVERIFY(values[0] == XYZ_t({1000, 2000, 3000}));
+    QVERIFY(values[1] == XYZ_t({4000, 0, 0}));
+    QVERIFY(values[2] == XYZ_t({4010, 0, 0}));
+    QVERIFY(values[3] == XYZ_t({0, 0, 0}));
+
+    // Matches the per axis getters
+    QCOMPARE(values[2][axis_t::X], qint64(consumer.getPosition(addresses[2], axis_t::X).value));
+    QCOMPARE(consumer.getModuleValues(VALUES::POSITION, addresses, values.data(), false), 3);
+    QVERIFY(values[2] == XYZ_t({10, 0, 0}));
+
+    QCOMPARE(consumer.getModuleValues(VALUES::ROTATION, addresses.constData(), 1, values.data()), 1);
+    QVERIFY(values[0] == XYZ_t({0, 0, 90000000}));
+
+    // Not an axis value
+    QCOMPARE(consumer.getModuleValues(VALUES::REFERENCE_FRAME, addresses, values.data()), 0);
+    QVERIFY(values[2] == XYZ_t({0, 0, 0}));
+}
+
+void TEST_OTP::Consumer::partialFolioMode()
+{
+    CLOCK::virtualClock_t clock;
+    consumer_t consumer(iface, QAbstractSocket::IPv4Protocol, {});
+    const auto cid = cid_t::createUuid();
+    const system_t system = 1;
+    const int pointCount = 70;
+
+    QList<quint32> updated;
+    connect(&consumer, &OTP::Consumer::updatedPosition, this,
+        [&updated](cid_t, address_t address, axis_t axis) {
+            if (axis == axis_t::X) updated.append(address.point);
+        });
+    const auto position = [&](quint32 point) {
+        return consumer.getPosition(cid, {system, 1, point}, axis_t::X).value;
+    };
+    const auto range = [](int first, int last) {
+        QList<quint32> ret;
+        for (int point = first; point <= last; point++)
+            ret.append(static_cast<quint32>(point));
+        return ret;
+    };
+
+    // Pages wait for the complete folio by default
+    auto pages = transformFolio(cid, system, 1, pointCount, 0);
+    QCOMPARE(static_cast<int>(pages.size()), 3);
+    const auto firstPagePoints = static_cast<int>(MESSAGES::OTPTransformMessage::Message{QNetworkDatagram(pages.at(0))}.getPoints().size());
+    const auto secondPagePoints = static_cast<int>(MESSAGES::OTPTransformMessage::Message{QNetworkDatagram(pages.at(1))}.getPoints().size());
+    QVERIFY(!consumer.getTransformPartialFolioMode());
+    receive(iface, pages.at(0));
+    receive(iface, pages.at(1));
+    QVERIFY(updated.isEmpty());
+    QVERIFY(consumer.isTransformFolioComplete(cid, system));
+    receive(iface, pages.at(2));
+    QCOMPARE(updated, range(1, pointCount));
+    QCOMPARE(position(pointCount), pointCount);
+
+    // Pages applied as they arrive
+    consumer.setTransformPartialFolioMode(true);
+    updated.clear();
+    pages = transformFolio(cid, system, 2, pointCount, 1000);
+    receive(iface, pages.at(0));
+    QCOMPARE(updated, range(1, firstPagePoints));
+    QCOMPARE(position(1), 1001);
+    QVERIFY(!consumer.isTransformFolioComplete(cid, system));
+
+    clock.advance(10ms);
+    receive(iface, pages.at(1));
+    QCOMPARE(updated, range(1, firstPagePoints + secondPagePoints));
+    QVERIFY(!consumer.isTransformFolioComplete(cid, system));
+
+    // Change an early applied point, it should not be overwritten when the folio completes
+    consumer.network().applyPointBatch(cid, system, {{{system, 1, 1}, 100, pointDetails::standardModules_t()}}, {});
+    consumer.network().publishSnapshot();
+    QCOMPARE(position(1), 0);
+
+    clock.advance(10ms);
+    updated.clear();
+    receive(iface, pages.at(2));
+    QCOMPARE(updated, range(firstPagePoints + secondPagePoints + 1, pointCount));
+    QVERIFY(consumer.isTransformFolioComplete(cid, system));
+    QCOMPARE(position(1), 0);
+    QCOMPARE(position(pointCount), 1000 + pointCount);
+
+    // The first page was applied 20ms early, and the second 10ms
+    QCOMPARE(consumer.getTransformPartialFolioLatencySaved(system), std::chrono::milliseconds(15));
+}
+
+void TEST_OTP::Consumer::frames()
+{
+    consumer_t consumer(iface, QAbstractSocket::IPv4Protocol, {});
+    auto &container = consumer.network();
+    const auto cid = cid_t::createUuid();
+    const system_t system = 1;
+    container.addComponent(cid, QHostAddress::LocalHost);
+
+    QList<system_t> updated;
+    connect(&consumer, &OTP::Consumer::updatedFrame, this, [&updated](system_t updatedSystem) { updated.append(updatedSystem); });
+
+    // None published yet
+    QCOMPARE(int(consumer.getFrame(system)->sequence), 0);
+    QVERIFY(consumer.getFrame(system)->points.isEmpty());
+
+    // One frame per published snapshot, with every point in address order
+    const auto addresses = addPoints(container, cid, system, 3);
+    QCOMPARE(updated, QList<system_t>({system}));
+    const auto first = consumer.getFrame(system);
+    QCOMPARE(int(first->sequence), 1);
+    QCOMPARE(first->points.size(), addresses.size());
+    for (int n = 0; n < addresses.size(); n++)
+    {
+        const auto &point = first->points.at(n);
+        QVERIFY(point.address == addresses.at(n));
+        QCOMPARE(point.sourceCID, cid);
+        QCOMPARE(int(point.priority), 100);
+        QCOMPARE(int(point.standardModules.position.getPosition(axis_t::X)), n + 1);
+    }
+
+    // A held frame is unchanged by later frames
+    for (int frame = 2; frame <= 4; frame++)
+    {
+        pointDetails::standardModules_t standardModules;
+        standardModules.position.setPosition(axis_t::X, 10 * frame);
+        container.applyPointBatch(cid, system, {{addresses.at(1), 100, standardModules}}, {});
+        container.publishSnapshot();
+
+        QCOMPARE(updated.size(), frame);
+        const auto latest = consumer.getFrame(system);
+        QCOMPARE(int(latest->sequence), frame);
+        QCOMPARE(int(latest->points.at(1).standardModules.position.getPosition(axis_t::X)), 10 * frame);
+    }
+    QCOMPARE(int(first->sequence), 1);
+    QCOMPARE(int(first->points.at(1).standardModules.position.getPosition(axis_t::X)), 2);
+
+    // Other systems have no frame
+    QVERIFY(consumer.getFrame(2)->points.isEmpty());
+}
+
+void TEST_OTP::Consumer::benchmarkModuleValues_data()
+{
+    QTest::addColumn<bool>("batch");
+
+    QTest::newRow("Per axis getters") << false;
+    QTest::newRow("Batch") << true;
+}
+
+void TEST_OTP::Consumer::benchmarkModuleValues()
+{
+    // Full pose, position and rotation, of 10k points
+    QFETCH(bool, batch);
+    constexpr int pointCount = 10000;
+
+    consumer_t consumer(iface, QAbstractSocket::IPv4Protocol, {});
+    const auto cid = cid_t::createUuid();
+    consumer.network().addComponent(cid, QHostAddress::LocalHost);
+    const auto addresses = addPoints(consumer.network(), cid, 1, pointCount);
+
+    QVector<XYZ_t> positions(pointCount);
+    QVector<XYZ_t> rotations(pointCount);
+    QBENCHMARK {
+        if (batch)
+        {
+            consumer.getModuleValues(VALUES::POSITION, addresses, positions.data());
+            consumer.getModuleValues(VALUES::ROTATION, addresses, rotations.data());
+        } else {
+            for (int index = 0; index < pointCount; index++)
+                for (auto axis = axis_t::first; axis < axis_t::count; axis++)
+                {
+                    positions[index][axis] = consumer.getPosition(addresses.at(index), axis).value;
+                    rotations[index][axis] = consumer.getRotation(addresses.at(index), axis).value;
+                }
+        }
+    }
+
+    QVERIFY(positions.last() == XYZ_t({pointCount, pointCount, pointCount}));
+    QVERIFY(rotations.last() == XYZ_t({pointCount, pointCount, pointCount}));
+}
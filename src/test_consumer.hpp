@@ -0,0 +1,32 @@
+#ifndef TEST_CONSUMER_H
+#define TEST_CONSUMER_H
+
+#include <QtTest/QTest>
+
+#include "otp.hpp"
+
+namespace TEST_OTP
+{
+    class Consumer : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        Consumer() = default;
+        ~Consumer() = default;
+
+    private slots:
+        void initTestCase();
+
+        void moduleValues();
+        void partialFolioMode();
+        void frames();
+        void benchmarkModuleValues_data();
+        void benchmarkModuleValues();
+
+    private:
+        QNetworkInterface iface;
+    };
+}
+
+#endif // TEST_CONSUMER_H
@@ -0,0 +1,214 @@
+#include "test_container.hpp"
+#include "const.hpp"
+#include "network/modules/modules_const.hpp"
+
+int test_container(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    TEST_OTP::Container testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::Container::applyPointBatch()
+{
+    OTP::Container container;
+    const auto cid = OTP::cid_t::createUuid();
+    const OTP::system_t system = 1;
+    const OTP::component_t::ModuleItem_t position = {OTP::ESTA_MANUFACTURER_ID, OTP::MODULES::STANDARD::POSITION};
+    container.addComponent(cid, QHostAddress::LocalHost);
+
+    QSignalSpy newSystem(&container, &OTP::Container::newSystem);
+    QSignalSpy newGroup(&container, &OTP::Container::newGroup);
+    QSignalSpy newPoint(&container, &OTP::Container::newPoint);
+    QSignalSpy updatedPoint(&container, &OTP::Container::updatedPoint);
+
+    QVector<OTP::Container::pointUpdate_t> points;
+    for (int group = 1; group <= 2; group++)
+        for (int point = 1; point <= 10; point++)
+            points.append({{system, group, point}, 100, OTP::pointDetails::standardModules_t()});
+    points[0].standardModules.position.setPosition(OTP::axis_t::X, 1000);
+
+    // New points
+    auto result = container.applyPointBatch(cid, system, points, {position});
+    QCOMPARE(result.points.size(), points.size());
+    QCOMPARE(result.newModules, OTP::moduleList_t({position}));
+    QCOMPARE(result.points.first().previous.position.getPosition(OTP::axis_t::X), 0);
+    QCOMPARE(result.points.first().current.position.getPosition(OTP::axis_t::X), 1000);
+    QCOMPARE(newSystem.count(), 1);
+    QCOMPARE(newGroup.count(), 2);
+    QCOMPARE(newPoint.count(), points.size());
+    QCOMPARE(updatedPoint.count(), 0);
+    QCOMPARE(container.getPointList(cid, system, 1).size(), 10);
+    QCOMPARE(container.PointDetails(cid, points[0].address)->getPriority(), OTP::priority_t(100));
+    QCOMPARE(container.PointDetails(cid, points[0].address)->standardModules.position.getPosition(OTP::axis_t::X), 1000);
+
+    // Updated points
+    points[0].standardModules.position.setPosition(OTP::axis_t::X, 2000);
+    points[1].priority = 50;
+    result = container.applyPointBatch(cid, system, points, {position});
+    QVERIFY(result.newModules.isEmpty());
+    QCOMPARE(result.points.first().previous.position.getPosition(OTP::axis_t::X), 1000);
+    QCOMPARE(result.points.first().current.position.getPosition(OTP::axis_t::X), 2000);
+    QCOMPARE(newSystem.count(), 1);
+    QCOMPARE(newGroup.count(), 2);
+    QCOMPARE(newPoint.count(), points.size());
+    QCOMPARE(updatedPoint.count(), points.size());
+    QCOMPARE(container.PointDetails(cid, points[1].address)->getPriority(), OTP::priority_t(50));
+}
+
+void TEST_OTP::Container::applyPointBatchIgnored()
+{
+    OTP::Container container;
+    const auto cid = OTP::cid_t::createUuid();
+    const OTP::system_t system = 1;
+    container.addComponent(cid, QHostAddress::LocalHost);
+
+    QSignalSpy newPoint(&container, &OTP::Container::newPoint);
+
+    const QVector<OTP::Container::pointUpdate_t> points = {
+        {{OTP::system_t(2), 1, 1}, 100, {}}, // Different system
+        {{system, 0, 1}, 100, {}}, // Invalid group
+        {{system, 1, 0}, 100, {}}, // Invalid point
+        {{system, 1, 1}, 201, {}}, // Invalid priority
+        {{system, 1, 2}, 100, {}},
+    };
+    const auto result = container.applyPointBatch(cid, system, points, {});
+    QCOMPARE(result.points.size(), 1);
+    QCOMPARE(result.points.first().address, points.last().address);
+    QCOMPARE(newPoint.count(), 1);
+    QCOMPARE(container.getPointList(cid, system, 1), QList<OTP::point_t>({2}));
+}
+
+void TEST_OTP::Container::sources()
+{
+    OTP::Container container;
+    const auto cidA = OTP::cid_t::createUuid();
+    const auto cidB = OTP::cid_t::createUuid();
+    const OTP::address_t address = {1, 1, 1};
+    container.addComponent(cidA, QHostAddress::LocalHost);
+    container.addComponent(cidB, QHostAddress::LocalHost);
+
+    QVERIFY(!container.isValid(address));
+    QVERIFY(container.getSourceList(address).isEmpty());
+
+    container.addPoint(cidA, address);
+    container.addPoint(cidB, address);
+    QVERIFY(container.isValid(address));
+    QVERIFY(container.isValid(cidA, address));
+    auto sources = container.getSourceList(address);
+    std::sort(sources.begin(), sources.end());
+    auto expected = QList<OTP::cid_t>({cidA, cidB});
+    std::sort(expected.begin(), expected.end());
+    QCOMPARE(sources, expected);
+
+    container.removePoint(cidA, address);
+    QVERIFY(!container.isValid(cidA, address));
+    QCOMPARE(container.getSourceList(address), QList<OTP::cid_t>({cidB}));
+
+    container.movePoint(cidB, address, {1, 1, 2});
+    QVERIFY(!container.isValid(address));
+    QCOMPARE(container.getSourceList({1, 1, 2}), QList<OTP::cid_t>({cidB}));
+
+    // Unknown components are not sources
+    container.removeComponent(cidB);
+    QVERIFY(container.getSourceList({1, 1, 2}).isEmpty());
+}
+
+void TEST_OTP::Container::merge()
+{
+    using namespace std::chrono_literals;
+    OTP::CLOCK::virtualClock_t clock;
+    OTP::Container container;
+    const auto cidA = OTP::cid_t::createUuid();
+    const auto cidB = OTP::cid_t::createUuid();
+    const OTP::system_t system = 1;
+    const OTP::address_t address = {system, 1, 1};
+    const OTP::address_t other = {system, 1, 2};
+    container.addComponent(cidA, QHostAddress::LocalHost);
+    container.addComponent(cidB, QHostAddress::LocalHost);
+
+    QSignalSpy winnerChanged(&container, &OTP::Container::winnerChanged);
+
+    // Highest priority wins, reading a winner merges any pending changes first
+    container.applyPointBatch(cidA, system, {{address, 100, {}}, {other, 100, {}}}, {});
+    QCOMPARE(container.getWinningComponent(address), cidA);
+    container.applyPointBatch(cidB, system, {{address, 150, {}}}, {});
+    QCOMPARE(container.getWinningComponent(address), cidB);
+    QCOMPARE(container.getWinningComponent(other), cidA);
+    QTRY_COMPARE(winnerChanged.count(), 3);
+
+    // Priority changed
+    container.applyPointBatch(cidA, system, {{address, 200, {}}}, {});
+    QCOMPARE(container.getWinningComponent(address), cidA);
+
+    // Ties are won by the most recent, refreshed points keep their rank
+    container.applyPointBatch(cidB, system, {{address, 200, {}}}, {});
+    QCOMPARE(container.getWinningComponent(address), cidB);
+    container.applyPointBatch(cidA, system, {{address, 200, {}}}, {});
+    QCOMPARE(container.getWinningComponent(address), cidB);
+
+    // Local priority changed
+    container.setPointPriority(cidB, address, 150);
+    QCOMPARE(container.getWinningComponent(address), cidA);
+    container.setPointPriority(cidB, address, 200);
+    QCOMPARE(container.getWinningComponent(address), cidB);
+    QTRY_COMPARE(winnerChanged.count(), 7);
+
+    // Winner expired, failing over within one expiry tick
+    clock.advance(OTP::OTP_TRANSFORM_DATA_LOSS_TIMEOUT / 2);
+    container.applyPointBatch(cidA, system, {{address, 200, {}}}, {});
+    QCOMPARE(container.getWinningComponent(address), cidB);
+    winnerChanged.clear();
+    clock.advance(OTP::OTP_TRANSFORM_DATA_LOSS_TIMEOUT / 2 + 100ms);
+    QCOMPARE(container.getWinningComponent(address), cidA);
+    QCOMPARE(container.getWinningComponent(other), OTP::cid_t());
+    QTRY_COMPARE(winnerChanged.count(), 2);
+
+    // Winner removed
+    container.removeComponent(cidA);
+    QCOMPARE(container.getWinningComponent(address), OTP::cid_t());
+    QTRY_COMPARE(winnerChanged.count(), 3);
+
+    // Returning component wins again
+    container.addComponent(cidA, QHostAddress::LocalHost);
+    QCOMPARE(container.getWinningComponent(address), cidA);
+
+    // Winner's point removed
+    container.removePoint(cidA, address);
+    QCOMPARE(container.getWinningComponent(address), OTP::cid_t());
+}
+
+void TEST_OTP::Container::mergeWorkers()
+{
+    OTP::Container container;
+    QVERIFY(container.getMergeWorkers() >= 1);
+    container.setMergeWorkers(2);
+    QCOMPARE(container.getMergeWorkers(), 2);
+    QCOMPARE(container.getMergeStatistics().workers, 2);
+    container.setMergeWorkers(0);
+    QCOMPARE(container.getMergeWorkers(), 1);
+    container.setMergeWorkers(3);
+
+    // Every system shares the pool
+    const auto cid = OTP::cid_t::createUuid();
+    container.addComponent(cid, QHostAddress::LocalHost);
+    const auto first = static_cast<int>(OTP::RANGES::System.getMin());
+    const auto last = static_cast<int>(OTP::RANGES::System.getMax());
+    for (int n = first; n <= last; n++)
+    {
+        const OTP::system_t system(n);
+        container.applyPointBatch(cid, system, {{{system, 1, 1}, 100, {}}}, {});
+    }
+    QTRY_COMPARE(container.getMergeStatistics().pending, 0);
+    for (int n = first; n <= last; n++)
+        QCOMPARE(container.getWinningComponent({OTP::system_t(n), 1, 1}), cid);
+
+    const auto statistics = container.getMergeStatistics();
+    QCOMPARE(statistics.workers, 3);
+    QVERIFY(statistics.merges >= quint64(last - first + 1));
+    QVERIFY(statistics.addresses >= quint64(last - first + 1));
+
+    // Idle
+    QTest::qWait(100);
+    QCOMPARE(container.getMergeStatistics().merges, statistics.merges);
+}
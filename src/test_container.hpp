@@ -0,0 +1,28 @@
+#ifndef TEST_CONTAINER_H
+#define TEST_CONTAINER_H
+
+#include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+
+#include "container.hpp"
+
+namespace TEST_OTP
+{
+    class Container : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        Container() = default;
+        ~Container() = default;
+
+    private slots:
+        void applyPointBatch();
+        void applyPointBatchIgnored();
+        void sources();
+        void merge();
+        void mergeWorkers();
+    };
+}
+
+#endif // TEST_CONTAINER_H
@@ -0,0 +1,106 @@
+#include "test_folio.hpp"
+#include "const.hpp"
+
+using reassembler_t = OTP::folioReassembler_t<int>;
+static const OTP::cid_t testCid = OTP::cid_t::createUuid();
+static const OTP::system_t testSystem = 1;
+static const auto testVector = OTP::PDU::VECTOR_OTP_TRANSFORM_MESSAGE;
+
+int test_folio(int argc, char *argv[])
+{
+    TEST_OTP::FolioReassembler testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::FolioReassembler::singlePage()
+{
+    reassembler_t folios(OTP::OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 0, 0, 10), reassembler_t::Complete);
+    QCOMPARE(folios.takePages(testCid, testSystem, testVector), std::vector<int>({10}));
+    QVERIFY(folios.takePages(testCid, testSystem, testVector).empty());
+
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 2, 0, 0, 20), reassembler_t::Complete);
+    QCOMPARE(folios.takePages(testCid, testSystem, testVector), std::vector<int>({20}));
+}
+
+void TEST_OTP::FolioReassembler::reordered()
+{
+    reassembler_t folios(OTP::OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 2, 2, 12), reassembler_t::Incomplete);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 0, 2, 10), reassembler_t::Incomplete);
+    QVERIFY(folios.takePages(testCid, testSystem, testVector).empty());
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 1, 2, 11), reassembler_t::Complete);
+    QCOMPARE(folios.takePages(testCid, testSystem, testVector), std::vector<int>({10, 11, 12}));
+}
+
+void TEST_OTP::FolioReassembler::duplicate()
+{
+    reassembler_t folios(OTP::OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 0, 1, 10), reassembler_t::Incomplete);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 0, 1, 99), reassembler_t::Duplicate);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 1, 1, 11), reassembler_t::Complete);
+    QCOMPARE(folios.takePages(testCid, testSystem, testVector), std::vector<int>({10, 11}));
+
+    // Repeat of a completed folio
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 1, 1, 11), reassembler_t::Stale);
+}
+
+void TEST_OTP::FolioReassembler::stale()
+{
+    reassembler_t folios(OTP::OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 5, 0, 0, 50), reassembler_t::Complete);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 4, 0, 0, 40), reassembler_t::Stale);
+
+    // Older than the folio being assembled
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 7, 0, 1, 70), reassembler_t::Incomplete);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 6, 0, 0, 60), reassembler_t::Stale);
+
+    // Roll over
+    folios.removeComponent(testCid);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 0xFFFFFFFF, 0, 0, 1), reassembler_t::Complete);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 0, 0, 0, 2), reassembler_t::Complete);
+}
+
+void TEST_OTP::FolioReassembler::evictIncomplete()
+{
+    reassembler_t folios(OTP::OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 0, 1, 10), reassembler_t::Incomplete);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 2, 1, 1, 21), reassembler_t::Incomplete);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 1, 1, 11), reassembler_t::Stale);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 2, 0, 1, 20), reassembler_t::Complete);
+    QCOMPARE(folios.takePages(testCid, testSystem, testVector), std::vector<int>({20, 21}));
+
+    // Timeout
+    reassembler_t timeout(std::chrono::milliseconds(10));
+    QCOMPARE(timeout.addPage(testCid, testSystem, testVector, 100, 0, 1, 10), reassembler_t::Incomplete);
+    QTest::qWait(20);
+    QCOMPARE(timeout.addPage(testCid, testSystem, testVector, 1, 0, 0, 1), reassembler_t::Complete);
+}
+
+void TEST_OTP::FolioReassembler::invalid()
+{
+    reassembler_t folios(OTP::OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 2, 1, 0), reassembler_t::Invalid);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 0, 1, 10), reassembler_t::Incomplete);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 1, 2, 11), reassembler_t::Invalid);
+
+    // Largest possible last page, storage follows the pages actually received
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 2, 1, 0xFFFF, 21), reassembler_t::Incomplete);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 3, 1, 1, 31), reassembler_t::Incomplete);
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 3, 0, 1, 30), reassembler_t::Complete);
+    QCOMPARE(folios.takePages(testCid, testSystem, testVector), std::vector<int>({30, 31}));
+}
+
+void TEST_OTP::FolioReassembler::removeComponent()
+{
+    reassembler_t folios(OTP::OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
+    const auto other = OTP::cid_t::createUuid();
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 0, 0, 10), reassembler_t::Complete);
+    QCOMPARE(folios.addPage(other, testSystem, testVector, 1, 0, 0, 20), reassembler_t::Complete);
+    folios.removeComponent(testCid);
+    QVERIFY(folios.takePages(testCid, testSystem, testVector).empty());
+    QCOMPARE(folios.takePages(other, testSystem, testVector), std::vector<int>({20}));
+
+    // Sequence restarts
+    QCOMPARE(folios.addPage(testCid, testSystem, testVector, 1, 0, 0, 10), reassembler_t::Complete);
+}
@@ -0,0 +1,29 @@
+#ifndef TEST_FOLIO_H
+#define TEST_FOLIO_H
+
+#include <QtTest/QTest>
+
+#include "folio.hpp"
+
+namespace TEST_OTP
+{
+    class FolioReassembler : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        FolioReassembler() = default;
+        ~FolioReassembler() = default;
+
+    private slots:
+        void singlePage();
+        void reordered();
+        void duplicate();
+        void stale();
+        void evictIncomplete();
+        void invalid();
+        void removeComponent();
+    };
+}
+
+#endif // TEST_FOLIO_H
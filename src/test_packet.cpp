@@ -0,0 +1,192 @@
+#include "test_packet.hpp"
+#include "network/messages/messages.hpp"
+#include "network/messages/test_appendix_B.hpp"
+#include <QSet>
+#include <vector>
+
+int test_packet(int argc, char *argv[])
+{
+    TEST_OTP::Packet testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::Packet::sharedBuffer()
+{
+    OTP::PacketPool pool(4);
+    QCOMPARE(pool.getStatistics().free, static_cast<quint64>(4));
+    {
+        auto packet = pool.acquire();
+        QVERIFY(!packet.isNull());
+        QCOMPARE(packet.size(), 0);
+        QVERIFY(packet.setData("OTP", 3));
+        QCOMPARE(pool.getStatistics().free, static_cast<quint64>(3));
+
+        auto copy = packet;
+        QCOMPARE(copy.constData(), packet.constData());
+        QCOMPARE(pool.getStatistics().free, static_cast<quint64>(3));
+
+        packet = OTP::Packet();
+        QCOMPARE(copy.size(), 3);
+        QCOMPARE(pool.getStatistics().free, static_cast<quint64>(3));
+    }
+    QCOMPARE(pool.getStatistics().free, static_cast<quint64>(4));
+
+    // Grows when exhausted
+    {
+        std::vector<OTP::Packet> packets;
+        for (int n = 0; n < 5; n++)
+            packets.push_back(pool.acquire());
+        QCOMPARE(pool.getStatistics().slabs, static_cast<quint64>(2));
+    }
+    QCOMPARE(pool.getStatistics().free, static_cast<quint64>(8));
+
+    // Oversized
+    {
+        auto packet = pool.acquire();
+        QVERIFY(!packet.setData(QByteArray(OTP::Packet::capacity + 1, 0).constData(), OTP::Packet::capacity + 1));
+    }
+}
+
+void TEST_OTP::Packet::fromDatagram()
+{
+    const auto payload = QByteArray("fromDatagram");
+    QNetworkDatagram datagram(payload, QHostAddress("239.159.1.1"), 5568);
+    datagram.setSender(QHostAddress("10.0.0.1"), 1234);
+
+    const auto packet = OTP::Packet::fromDatagram(datagram);
+    QVERIFY(!packet.isNull());
+    QCOMPARE(packet.toByteArray(), payload);
+    QCOMPARE(packet.senderAddress(), QHostAddress("10.0.0.1"));
+    QCOMPARE(packet.senderPort(), static_cast<quint16>(1234));
+    QCOMPARE(packet.destinationAddress(), QHostAddress("239.159.1.1"));
+    QCOMPARE(packet.destinationPort(), static_cast<quint16>(5568));
+
+    const auto roundTrip = packet.toQNetworkDatagram();
+    QCOMPARE(roundTrip.data(), payload);
+    QCOMPARE(roundTrip.senderAddress(), datagram.senderAddress());
+    QCOMPARE(roundTrip.destinationAddress(), datagram.destinationAddress());
+
+    // IPv6
+    datagram.setSender(QHostAddress("fe80::1"), 1234);
+    datagram.setDestination(QHostAddress("ff18::9f:0:1:1"), 5568);
+    const auto packet6 = OTP::Packet::fromDatagram(datagram);
+    QCOMPARE(packet6.senderAddress(), QHostAddress("fe80::1"));
+    QCOMPARE(packet6.destinationAddress(), QHostAddress("ff18::9f:0:1:1"));
+}
+
+void TEST_OTP::Packet::view()
+{
+    auto packet = OTP::PacketPool::instance().acquire();
+    packet.setData("0123456789", 10);
+    const auto view = packet.view();
+    QCOMPARE(view.data, packet.constData());
+    QCOMPARE(view.size, 10);
+    QCOMPARE(view.mid(2, 3).data, packet.constData() + 2);
+    QCOMPARE(view.mid(2, 3).size, 3);
+    QCOMPARE(view.mid(8, 10).size, 2);
+    QCOMPARE(view.mid(10, 1).size, 0);
+    QCOMPARE(packet.toByteArray().constData(), packet.constData());
+}
+
+void TEST_OTP::Packet::parseMessage()
+{
+    using namespace TEST_OTP::MESSAGES::APPENDIX_B;
+    const auto example = Examples.first().first + ExampleB_1_Point;
+    auto packet = OTP::PacketPool::instance().acquire();
+    QVERIFY(packet.setData(example.constData(), example.size()));
+
+    OTP::MESSAGES::OTPTransformMessage::Message fromPacket(packet);
+    OTP::MESSAGES::OTPTransformMessage::Message fromDatagram{QNetworkDatagram(example)};
+    QVERIFY(fromPacket.isValid());
+    QVERIFY(fromDatagram.isValid());
+    QCOMPARE(fromPacket.getOTPLayer().toPDUByteArray(), fromDatagram.getOTPLayer().toPDUByteArray());
+    QCOMPARE(fromPacket.getTransformLayer().toPDUByteArray(), fromDatagram.getTransformLayer().toPDUByteArray());
+    QCOMPARE(static_cast<int>(fromPacket.getPoints().size()), 1);
+    QCOMPARE(fromPacket.getPoints().size(), fromDatagram.getPoints().size());
+    QCOMPARE(static_cast<int>(fromPacket.getPoints().front().moduleLayers.size()), 4);
+}
+
+void TEST_OTP::Packet::peekMessage()
+{
+    using namespace TEST_OTP::MESSAGES::APPENDIX_B;
+    using namespace OTP::MESSAGES;
+    for (const auto &example : Examples)
+    {
+        const OTP::PacketView view = {example.first.constData(), example.first.size()};
+        const auto peeked = peek(view);
+        if (example.second.OTPLayer.length + OTP::PDU::OTPLayer::LENGTHOFFSET > example.first.size())
+        {
+            // Table B-1 omits the point data
+            QCOMPARE(peeked.type, Rejected);
+            QCOMPARE(peeked.reason, InvalidLength);
+            continue;
+        }
+
+        QCOMPARE(peeked.reason, Accepted);
+        if (example.second.OTPLayer.vector == OTP::PDU::VECTOR_OTP_TRANSFORM_MESSAGE)
+            QCOMPARE(peeked.type, TransformMessage);
+        else if (example.second.OTPAdvertisementLayer.vector == OTP::PDU::VECTOR_OTP_ADVERTISEMENT_MODULE)
+            QCOMPARE(peeked.type, ModuleAdvertisementMessage);
+        else if (example.second.OTPAdvertisementLayer.vector == OTP::PDU::VECTOR_OTP_ADVERTISEMENT_NAME)
+            QCOMPARE(peeked.type, NameAdvertisementMessage);
+        else if (example.second.OTPAdvertisementLayer.vector == OTP::PDU::VECTOR_OTP_ADVERTISEMENT_SYSTEM)
+            QCOMPARE(peeked.type, SystemAdvertisementMessage);
+
+        // Truncated
+        QCOMPARE(peek(view.mid(0, OTP::PDU::OTPLayer::SIZE - 1)).reason, TooShort);
+
+        // Foreign
+        QByteArray foreign(example.first.constData(), example.first.size());
+        foreign[0] = 'X';
+        QCOMPARE(peek({foreign.constData(), foreign.size()}).reason, InvalidPacketIdent);
+
+        // Unknown vectors
+        QByteArray unknown(example.first.constData(), example.first.size());
+        unknown[OTP::PDU::OTPLayer::OTP_PACKET_IDENT.size() + 1] = static_cast<char>(0xFF);
+        QCOMPARE(peek({unknown.constData(), unknown.size()}).reason, UnknownVector);
+        if (example.second.OTPLayer.vector == OTP::PDU::VECTOR_OTP_ADVERTISEMENT_MESSAGE)
+        {
+            unknown = QByteArray(example.first.constData(), example.first.size());
+            unknown[OTP::PDU::OTPLayer::SIZE + 1] = static_cast<char>(0xFF);
+            QCOMPARE(peek({unknown.constData(), unknown.size()}).reason, UnknownAdvertisementVector);
+        }
+    }
+}
+
+void TEST_OTP::Packet::poolSteadyState()
+{
+    const int folioPages = 16;
+    OTP::PacketPool pool(folioPages);
+    std::vector<OTP::Packet> folio;
+    folio.reserve(folioPages);
+    const QByteArray payload(1472, 0x55);
+
+    // Acquire, hold for reassembly, view, and release, a full folio of pool buffers each pass
+    // Buffer reuse only, the SocketManager and Component receive path is not covered here
+    QSet<const char*> buffers;
+    auto receive = [&]() {
+        for (int page = 0; page < folioPages; page++)
+        {
+            auto packet = pool.acquire();
+            packet.setData(payload.constData(), payload.size());
+            buffers.insert(packet.constData());
+            folio.push_back(packet);
+        }
+        int bytes = 0;
+        for (const auto &packet : folio)
+            bytes += packet.view().mid(0, packet.size()).size;
+        folio.clear();
+        return bytes;
+    };
+
+    receive(); // Warm up
+    const auto slabs = pool.getStatistics().slabs;
+    const auto warmBuffers = buffers;
+    for (int n = 0; n < 1000; n++)
+        QCOMPARE(receive(), folioPages * payload.size());
+
+    // Every pass recycles the warm up buffers, the pool never grows
+    QCOMPARE(buffers, warmBuffers);
+    QCOMPARE(pool.getStatistics().slabs, slabs);
+    QCOMPARE(pool.getStatistics().free, static_cast<quint64>(folioPages));
+}
@@ -0,0 +1,28 @@
+#ifndef TEST_PACKET_H
+#define TEST_PACKET_H
+
+#include <QtTest/QTest>
+
+#include "packet.hpp"
+
+namespace TEST_OTP
+{
+    class Packet : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        Packet() = default;
+        ~Packet() = default;
+
+    private slots:
+        void sharedBuffer();
+        void fromDatagram();
+        void view();
+        void parseMessage();
+        void peekMessage();
+        void poolSteadyState();
+    };
+}
+
+#endif // TEST_PACKET_H
@@ -0,0 +1,281 @@
+#include "test_pointstore.hpp"
+#include <QRandomGenerator>
+
+namespace
+{
+    // Nested layout used by Container before pointStore_t
+    typedef QHash<OTP::point_t, OTP::pointDetails_t> pointMap_t;
+    typedef QHash<OTP::group_t, pointMap_t> groupMap_t;
+    typedef QHash<OTP::system_t, groupMap_t> systemMap_t;
+    typedef QHash<OTP::cid_t, systemMap_t> addressMap_t;
+
+    OTP::address_t benchmarkAddress(int index)
+    {
+        return {
+            OTP::system_t(static_cast<quint8>(1 + (index / 4) % 10)),
+            OTP::group_t(static_cast<quint16>(1 + (index / 40) % 100)),
+            OTP::point_t(static_cast<quint32>(1 + index / 4000))};
+    }
+}
+
+int test_pointstore(int argc, char *argv[])
+{
+    TEST_OTP::PointStore testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::PointStore::initTestCase()
+{
+    for (int n = 0; n < 4; n++)
+        cids.append(OTP::cid_t::createUuid());
+    details = std::make_shared<OTP::pointDetails>();
+}
+
+void TEST_OTP::PointStore::insertFind()
+{
+    OTP::pointStore_t store;
+    const OTP::address_t address = {1, 2, 3};
+    QVERIFY(!store.find(cids[0], address));
+    QVERIFY(!store.contains(address));
+
+    bool inserted;
+    auto details = store.findOrInsert(cids[0], address, inserted).details;
+    QVERIFY(inserted);
+    QVERIFY(details);
+    QCOMPARE(store.findOrInsert(cids[0], address, inserted).details, details);
+    QVERIFY(!inserted);
+
+    QCOMPARE(store.find(cids[0], address), details);
+    QVERIFY(!store.find(cids[1], address));
+    QVERIFY(store.contains(address));
+    QVERIFY(!store.contains({1, 2, 4}));
+
+    QCOMPARE(store.getSystems(cids[0]), QList<OTP::system_t>({1}));
+    QCOMPARE(store.getGroups(cids[0], 1), QList<OTP::group_t>({2}));
+    QCOMPARE(store.getPoints(cids[0], 1, 2), QList<OTP::point_t>({3}));
+    QVERIFY(store.getSystems(cids[1]).isEmpty());
+}
+
+void TEST_OTP::PointStore::remove()
+{
+    // Compare against a reference, across several table resizes
+    OTP::pointStore_t store;
+    QHash<std::pair<int, OTP::address_t>, OTP::pointDetails_t> reference;
+    QRandomGenerator random(1);
+    for (int n = 0; n < 20000; n++)
+    {
+        const auto cid = static_cast<int>(random.bounded(cids.size()));
+        const auto address = benchmarkAddress(static_cast<int>(random.bounded(5000)));
+        if (random.bounded(3) == 0)
+        {
+            QCOMPARE(store.remove(cids[cid], address), reference.remove({cid, address}) > 0);
+        } else {
+            bool inserted;
+            const auto details = store.findOrInsert(cids[cid], address, inserted).details;
+            QCOMPARE(inserted, !reference.contains({cid, address}));
+            if (inserted) reference.insert({cid, address}, details);
+        }
+    }
+
+    QCOMPARE(store.size(), static_cast<size_t>(reference.size()));
+    for (auto it = reference.cbegin(); it != reference.cend(); ++it)
+        QCOMPARE(store.find(cids[it.key().first], it.key().second), it.value());
+    for (const auto &record : store.records())
+        QVERIFY(reference.contains({cids.indexOf(store.getCID(record.handle)), record.address}));
+
+    // Sources
+    for (int index = 0; index < 5000; index++)
+    {
+        const auto address = benchmarkAddress(index);
+        QList<OTP::cid_t> expected;
+        for (int cid = 0; cid < cids.size(); cid++)
+            if (reference.contains({cid, address})) expected.append(cids[cid]);
+        auto sources = store.getSources(address);
+        std::sort(sources.begin(), sources.end());
+        std::sort(expected.begin(), expected.end());
+        QCOMPARE(sources, expected);
+        QCOMPARE(store.contains(address), !expected.isEmpty());
+    }
+}
+
+void TEST_OTP::PointStore::removeGroupSystem()
+{
+    OTP::pointStore_t store;
+    bool inserted;
+    for (int point = 1; point <= 100; point++)
+        for (int group = 1; group <= 2; group++)
+            for (int system = 1; system <= 2; system++)
+                store.findOrInsert(cids[0], {system, group, point}, inserted);
+    store.findOrInsert(cids[1], {1, 1, 1}, inserted);
+    QCOMPARE(store.size(), static_cast<size_t>(401));
+
+    QVERIFY(store.removeGroup(cids[0], 1, 1));
+    QVERIFY(!store.removeGroup(cids[0], 1, 1));
+    QCOMPARE(store.size(), static_cast<size_t>(301));
+    QCOMPARE(store.getGroups(cids[0], 1), QList<OTP::group_t>({2}));
+    QVERIFY(!store.find(cids[0], {1, 1, 1}));
+    QVERIFY(store.find(cids[0], {1, 2, 1}));
+    QVERIFY(store.find(cids[1], {1, 1, 1}));
+    QCOMPARE(store.getSources({1, 1, 1}), QList<OTP::cid_t>({cids[1]}));
+    QVERIFY(!store.contains({1, 1, 2}));
+
+    QVERIFY(store.removeSystem(cids[0], 2));
+    QVERIFY(!store.removeSystem(cids[0], 2));
+    QCOMPARE(store.size(), static_cast<size_t>(101));
+    QCOMPARE(store.getSystems(cids[0]), QList<OTP::system_t>({1}));
+    QVERIFY(!store.find(cids[0], {2, 1, 1}));
+    QVERIFY(store.find(cids[0], {1, 2, 100}));
+
+    // Empty groups and systems are listed
+    store.addGroup(cids[2], 3, 4);
+    QCOMPARE(store.getSystems(cids[2]), QList<OTP::system_t>({3}));
+    QCOMPARE(store.getGroups(cids[2], 3), QList<OTP::group_t>({4}));
+    QVERIFY(store.getPoints(cids[2], 3, 4).isEmpty());
+}
+
+void TEST_OTP::PointStore::changeCID()
+{
+    OTP::pointStore_t store;
+    bool inserted;
+    const auto details = store.findOrInsert(cids[0], {1, 1, 1}, inserted).details;
+    store.findOrInsert(cids[1], {1, 1, 2}, inserted);
+
+    store.changeCID(cids[0], cids[1]);
+    QCOMPARE(store.find(cids[1], {1, 1, 1}), details);
+    QVERIFY(!store.find(cids[1], {1, 1, 2}));
+    QVERIFY(!store.find(cids[0], {1, 1, 1}));
+    QCOMPARE(store.getComponents(), QList<OTP::cid_t>({cids[1]}));
+    QCOMPARE(store.getSources({1, 1, 1}), QList<OTP::cid_t>({cids[1]}));
+    QVERIFY(!store.contains({1, 1, 2}));
+    QCOMPARE(store.size(), static_cast<size_t>(1));
+}
+
+void TEST_OTP::PointStore::rank()
+{
+    OTP::pointStore_t store;
+    const OTP::address_t address = {1, 1, 1};
+    bool inserted;
+    store.findOrInsert(cids[0], address, inserted);
+    store.findOrInsert(cids[1], address, inserted);
+    QCOMPARE(store.getWinner(address), OTP::cid_t());
+
+    store.rank(store.getHandle(cids[0]), address, 100);
+    store.rank(store.getHandle(cids[1]), address, 50);
+    QCOMPARE(store.getWinner(address), cids[0]);
+
+    // Removed points are unranked
+    store.remove(cids[0], address);
+    QCOMPARE(store.getWinner(address), cids[1]);
+    store.unrank(store.getHandle(cids[1]), address);
+    QCOMPARE(store.getWinner(address), OTP::cid_t());
+
+    // Ranks follow a changed CID
+    store.rank(store.getHandle(cids[1]), address, 50);
+    store.changeCID(cids[1], cids[2]);
+    QCOMPARE(store.getWinner(address), cids[2]);
+}
+
+void TEST_OTP::PointStore::benchmarkData()
+{
+    QTest::addColumn<int>("points");
+    QTest::addColumn<bool>("flat");
+    for (const auto points : {1000, 100000, 1000000})
+    {
+        QTest::addRow("nested %d", points) << points << false;
+        QTest::addRow("flat %d", points) << points << true;
+    }
+}
+
+void TEST_OTP::PointStore::benchmarkInsert()
+{
+    QFETCH(int, points);
+    QFETCH(bool, flat);
+
+    QBENCHMARK_ONCE {
+        if (flat)
+        {
+            OTP::pointStore_t store;
+            bool inserted;
+            for (int index = 0; index < points; index++)
+                store.findOrInsert(cids[index % cids.size()], benchmarkAddress(index), inserted).details = details;
+            QCOMPARE(store.size(), static_cast<size_t>(points));
+        } else {
+            addressMap_t addressMap;
+            for (int index = 0; index < points; index++)
+            {
+                const auto address = benchmarkAddress(index);
+                addressMap[cids[index % cids.size()]][address.system][address.group][address.point] = details;
+            }
+        }
+    }
+}
+
+void TEST_OTP::PointStore::benchmarkLookup()
+{
+    QFETCH(int, points);
+    QFETCH(bool, flat);
+
+    OTP::pointStore_t store;
+    addressMap_t addressMap;
+    for (int index = 0; index < points; index++)
+    {
+        const auto address = benchmarkAddress(index);
+        if (flat)
+        {
+            bool inserted;
+            store.findOrInsert(cids[index % cids.size()], address, inserted).details = details;
+        } else
+            addressMap[cids[index % cids.size()]][address.system][address.group][address.point] = details;
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        for (int index = 0; index < points; index++)
+        {
+            const auto address = benchmarkAddress(index);
+            const auto &cid = cids[index % cids.size()];
+            if (flat)
+                found += store.find(cid, address) ? 1 : 0;
+            else
+                found += addressMap.value(cid).value(address.system).value(address.group).value(address.point) ? 1 : 0;
+        }
+    }
+    QCOMPARE(found, points);
+}
+
+void TEST_OTP::PointStore::benchmarkIteration()
+{
+    QFETCH(int, points);
+    QFETCH(bool, flat);
+
+    OTP::pointStore_t store;
+    addressMap_t addressMap;
+    for (int index = 0; index < points; index++)
+    {
+        const auto address = benchmarkAddress(index);
+        if (flat)
+        {
+            bool inserted;
+            store.findOrInsert(cids[index % cids.size()], address, inserted).details = details;
+        } else
+            addressMap[cids[index % cids.size()]][address.system][address.group][address.point] = details;
+    }
+
+    int found = 0;
+    QBENCHMARK {
+        found = 0;
+        if (flat)
+        {
+            for (const auto &record : store.records())
+                found += record.details ? 1 : 0;
+        } else {
+            for (const auto &systems : qAsConst(addressMap))
+                for (const auto &groups : systems)
+                    for (const auto &pointsMap : groups)
+                        for (const auto &pointDetails : pointsMap)
+                            found += pointDetails ? 1 : 0;
+        }
+    }
+    QCOMPARE(found, points);
+}
@@ -0,0 +1,42 @@
+#ifndef TEST_POINTSTORE_H
+#define TEST_POINTSTORE_H
+
+#include <QtTest/QTest>
+
+#include "pointstore.hpp"
+
+namespace TEST_OTP
+{
+    class PointStore : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        PointStore() = default;
+        ~PointStore() = default;
+
+    private slots:
+        void initTestCase();
+
+        void insertFind();
+        void remove();
+        void removeGroupSystem();
+        void changeCID();
+        void rank();
+
+        void benchmarkInsert_data() { benchmarkData(); }
+        void benchmarkInsert();
+        void benchmarkLookup_data() { benchmarkData(); }
+        void benchmarkLookup();
+        void benchmarkIteration_data() { benchmarkData(); }
+        void benchmarkIteration();
+
+    private:
+        void benchmarkData();
+
+        QList<OTP::cid_t> cids;
+        OTP::pointDetails_t details;
+    };
+}
+
+#endif // TEST_POINTSTORE_H
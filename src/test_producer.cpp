@@ -0,0 +1,141 @@
+#include "test_producer.hpp"
+#include "network/messages/otp_transform_message.hpp"
+#include "network/modules/modules_const.hpp"
+
+using namespace std::chrono_literals;
+using namespace OTP;
+
+namespace
+{
+    // Producer with access to the transform folio it would send next
+    class producer_t : public OTP::Producer
+    {
+    public:
+        using OTP::Producer::Producer;
+        Container &network() { return *otpNetwork; }
+        using OTP::Producer::getOTPTransformMessageDatagrams;
+    };
+
+    // Points sent in a folio, and whether it was flagged as a full point set
+    typedef struct sent_s
+    {
+        QList<point_t> points;
+        bool fullPointSet = false;
+    } sent_t;
+    sent_t dissect(const QList<QNetworkDatagram> &datagrams)
+    {
+        sent_t ret;
+        for (const auto &datagram : datagrams)
+        {
+            MESSAGES::OTPTransformMessage::Message message(datagram);
+            if (!message.isValid()) continue;
+            ret.fullPointSet = message.getTransformLayer().getOptions().isFullPointSet();
+            for (const auto &point : message.getPoints())
+                ret.points.append(point.pointLayer.getPoint());
+        }
+        return ret;
+    }
+
+    const system_t System = 1;
+    const QList<point_t> AllPoints = {1, 2, 3};
+
+    // Local points 1 to 3, requested with the position module by a consumer
+    void setup(producer_t &producer)
+    {
+        producer.network().addComponent(
+                    cid_t::createUuid(), QHostAddress::LocalHost, name_t(), component_t::consumer,
+                    {{ESTA_MANUFACTURER_ID, MODULES::STANDARD::POSITION}});
+        producer.addLocalSystem(System);
+        for (const auto &point : AllPoints)
+        {
+            const address_t address(System, 1, point);
+            producer.addLocalPoint(address, 100);
+            OTP::Producer::PositionValue_t position;
+            position.value = static_cast<qint32>(point);
+            position.scale = MODULES::STANDARD::PositionModule_t::mm;
+            producer.setLocalPosition(address, axis_t::X, position);
+        }
+    }
+}
+
+int test_producer(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    TEST_OTP::Producer testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::Producer::initTestCase()
+{
+    const auto interfaces = QNetworkInterface::allInterfaces();
+    for (const auto &interface : interfaces)
+        if (interface.flags().testFlag(QNetworkInterface::IsLoopBack)
+                && interface.flags().testFlag(QNetworkInterface::IsUp))
+        {
+            iface = interface;
+            break;
+        }
+    if (!iface.isValid())
+        QSKIP("No loopback interface available");
+}
+
+void TEST_OTP::Producer::fullPointSetMode()
+{
+    CLOCK::virtualClock_t clock;
+    producer_t producer(iface, QAbstractSocket::IPv4Protocol);
+    setup(producer);
+    QVERIFY(!producer.getTransformDeltaMode());
+
+    // Every folio is a full point set, changed or not
+    for (int n = 0; n < 3; n++)
+    {
+        const auto sent = dissect(producer.getOTPTransformMessageDatagrams(System));
+        QCOMPARE(sent.points, AllPoints);
+        QVERIFY(sent.fullPointSet);
+        clock.advance(OTP_TRANSFORM_TIMING_MAX);
+    }
+}
+
+void TEST_OTP::Producer::deltaMode()
+{
+    CLOCK::virtualClock_t clock;
+    producer_t producer(iface, QAbstractSocket::IPv4Protocol);
+    setup(producer);
+    producer.setTransformDeltaMode(true);
+
+    // Starts with a full point set
+    auto sent = dissect(producer.getOTPTransformMessageDatagrams(System));
+    QCOMPARE(sent.points, AllPoints);
+    QVERIFY(sent.fullPointSet);
+
+    // Nothing changed, nothing sent
+    clock.advance(OTP_TRANSFORM_TIMING_MAX);
+    QVERIFY(producer.getOTPTransformMessageDatagrams(System).isEmpty());
+
+    // Only changed points, and not flagged as a full point set
+    OTP::Producer::PositionValue_t position;
+    position.value = 20;
+    position.scale = MODULES::STANDARD::PositionModule_t::mm;
+    producer.setLocalPosition({System, 1, 2}, axis_t::X, position);
+    clock.advance(OTP_TRANSFORM_TIMING_MAX);
+    sent = dissect(producer.getOTPTransformMessageDatagrams(System));
+    QCOMPARE(sent.points, QList<point_t>({2}));
+    QVERIFY(!sent.fullPointSet);
+    QVERIFY(producer.getOTPTransformMessageDatagrams(System).isEmpty());
+
+    // Next full point set is due once OTP_TRANSFORM_FULL_POINT_SET_TIMING_MIN has passed since the last
+    clock.advance(OTP_TRANSFORM_FULL_POINT_SET_TIMING_MIN - 2 * OTP_TRANSFORM_TIMING_MAX);
+    QVERIFY(producer.getOTPTransformMessageDatagrams(System).isEmpty());
+    clock.advance(1ms);
+    sent = dissect(producer.getOTPTransformMessageDatagrams(System));
+    QCOMPARE(sent.points, AllPoints);
+    QVERIFY(sent.fullPointSet);
+
+    // And then not again, until another period has passed
+    clock.advance(OTP_TRANSFORM_FULL_POINT_SET_TIMING_MIN);
+    QVERIFY(producer.getOTPTransformMessageDatagrams(System).isEmpty());
+    clock.advance(1ms);
+    sent = dissect(producer.getOTPTransformMessageDatagrams(System));
+    QCOMPARE(sent.points, AllPoints);
+    QVERIFY(sent.fullPointSet);
+}
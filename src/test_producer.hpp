@@ -0,0 +1,29 @@
+#ifndef TEST_PRODUCER_H
+#define TEST_PRODUCER_H
+
+#include <QtTest/QTest>
+
+#include "otp.hpp"
+
+namespace TEST_OTP
+{
+    class Producer : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        Producer() = default;
+        ~Producer() = default;
+
+    private slots:
+        void initTestCase();
+
+        void fullPointSetMode();
+        void deltaMode();
+
+    private:
+        QNetworkInterface iface;
+    };
+}
+
+#endif // TEST_PRODUCER_H
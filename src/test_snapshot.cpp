@@ -0,0 +1,255 @@
+#include "test_snapshot.hpp"
+#include <thread>
+
+using namespace OTP;
+using position_t = MODULES::STANDARD::PositionModule_t::position_t;
+
+namespace
+{
+    // Counts live instances
+    class counted_t
+    {
+    public:
+        counted_t(int value = 0) : value(value) { live++; }
+        ~counted_t() { live--; }
+        const int value;
+        static inline std::atomic<int> live{0};
+    };
+
+    // Add, or update, points 1 to count in group 1
+    void addPoints(Container &container, const cid_t &cid, system_t system, int count, position_t position = 0)
+    {
+        QVector<Container::pointUpdate_t> points;
+        for (int point = 1; point <= count; point++)
+        {
+            points.append({{system, 1, point}, 100, pointDetails::standardModules_t()});
+            points.last().standardModules.position.setPosition(axis_t::X, position);
+        }
+        container.applyPointBatch(cid, system, points, {});
+    }
+}
+
+int test_snapshot(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    TEST_OTP::Snapshot testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::Snapshot::epochPointer()
+{
+    epochPointer_t<counted_t> pointer(std::make_unique<const counted_t>(1));
+    QCOMPARE(pointer.read()->value, 1);
+
+    const auto epoch = pointer.getEpoch();
+    pointer.publish(std::make_unique<const counted_t>(2));
+    QCOMPARE(pointer.read()->value, 2);
+    QCOMPARE(pointer.getEpoch(), epoch + 1);
+
+    // Unread values are deleted as soon as replaced
+    QCOMPARE(pointer.retiredCount(), size_t(0));
+    QCOMPARE(counted_t::live.load(), 1);
+}
+
+void TEST_OTP::Snapshot::reclaim()
+{
+    {
+        epochPointer_t<counted_t> pointer(std::make_unique<const counted_t>(1));
+        {
+            const auto reader = pointer.read();
+            pointer.publish(std::make_unique<const counted_t>(2));
+            pointer.publish(std::make_unique<const counted_t>(3));
+
+            // Values replaced while being read are kept
+            QCOMPARE(reader->value, 1);
+            QCOMPARE(pointer.retiredCount(), size_t(2));
+            QCOMPARE(pointer.read()->value, 3);
+        }
+
+        // Deleted by the next publish once released
+        pointer.publish(std::make_unique<const counted_t>(4));
+        QCOMPARE(pointer.retiredCount(), size_t(0));
+        QCOMPARE(counted_t::live.load(), 1);
+    }
+    QCOMPARE(counted_t::live.load(), 0);
+}
+
+void TEST_OTP::Snapshot::publish()
+{
+    Container container;
+    const auto cidA = cid_t::createUuid();
+    const auto cidB = cid_t::createUuid();
+    const system_t system = 1;
+    const address_t address = {system, 1, 1};
+    container.addComponent(cidA, QHostAddress::LocalHost);
+    container.addComponent(cidB, QHostAddress::LocalHost);
+
+    // Not visible until published
+    addPoints(container, cidA, system, 10, 1000);
+    QVERIFY(!container.readSnapshot()->contains(address));
+    container.publishSnapshot();
+    {
+        const auto snapshot = container.readSnapshot();
+        QVERIFY(snapshot->contains(address));
+        QCOMPARE(snapshot->getWinner(address), cidA);
+        QCOMPARE(snapshot->find(cidA, address)->standardModules.position.getPosition(axis_t::X), position_t(1000));
+        QVERIFY(!snapshot->find(cidB, address));
+    }
+
+    // Unchanged systems are shared
+    const auto previous = container.readSnapshot()->systems.value(system);
+    addPoints(container, cidA, system_t(2), 1);
+    container.publishSnapshot();
+    QVERIFY(container.readSnapshot()->systems.value(system) == previous);
+
+    // Changes outside of a folio are published from the event loop
+    container.applyPointBatch(cidB, system, {{address, 150, {}}}, {});
+    QTRY_COMPARE(container.readSnapshot()->getWinner(address), cidB);
+    QCOMPARE(static_cast<int>(container.readSnapshot()->getSources(address).size()), 2);
+
+    container.removeComponent(cidB);
+    QTRY_COMPARE(container.readSnapshot()->getWinner(address), cidA);
+    QCOMPARE(container.readSnapshot()->getSources(address), QList<cid_t>({cidA}));
+
+    container.removeSystem(cidA, system);
+    QTRY_VERIFY(!container.readSnapshot()->contains(address));
+}
+
+void TEST_OTP::Snapshot::referenceFrames()
+{
+    Container container;
+    const auto cid = cid_t::createUuid();
+    const system_t system = 1;
+    container.addComponent(cid, QHostAddress::LocalHost);
+
+    QList<system_t> published;
+    connect(&container, &Container::publishedSnapshot, this,
+            [&published](QList<system_t> systems) { published = systems; });
+
+    // Points 1 to 3 are each relative to the next, with point 3 relative to point 1
+    QVector<Container::pointUpdate_t> points;
+    for (int point = 1; point <= 3; point++)
+    {
+        points.append({{system, 1, point}, 100, pointDetails::standardModules_t()});
+        points.last().standardModules.position.setPosition(axis_t::X, point * 1000);
+        auto &referenceFrame = points.last().standardModules.referenceFrame;
+        referenceFrame.setSystem(system, 0);
+        referenceFrame.setGroup(1, 0);
+        referenceFrame.setPoint((point % 3) + 1, 0);
+    }
+    container.applyPointBatch(cid, system, points, {});
+    container.publishSnapshot();
+    QCOMPARE(static_cast<int>(published.size()), 1);
+    QVERIFY(published.contains(system));
+
+    // Followed until the chain would repeat
+    const auto snapshot = container.readSnapshot();
+    const address_t address = {system, 1, 1};
+    const auto frames = snapshot->getReferenceFrames(address, *snapshot->find(cid, address));
+    QCOMPARE(static_cast<int>(frames.size()), 2);
+    QCOMPARE(frames.at(0)->standardModules.position.getPosition(axis_t::X), position_t(2000));
+    QCOMPARE(frames.at(1)->standardModules.position.getPosition(axis_t::X), position_t(3000));
+
+    // Unknown reference frames end the chain
+    container.removePoint(cid, {system, 1, 3});
+    container.publishSnapshot();
+    const auto removed = container.readSnapshot();
+    QCOMPARE(static_cast<int>(removed->getReferenceFrames(address, *removed->find(cid, address)).size()), 1);
+}
+
+void TEST_OTP::Snapshot::concurrentReaders()
+{
+    // Each published folio sets every point to the same position, so readers never see a mix
+    Container container;
+    const auto cid = cid_t::createUuid();
+    const system_t system = 1;
+    constexpr int pointCount = 100;
+    container.addComponent(cid, QHostAddress::LocalHost);
+    addPoints(container, cid, system, pointCount, 0);
+    container.publishSnapshot();
+
+    std::atomic<bool> stop{false};
+    std::atomic<int> mixed{0};
+    std::vector<std::thread> readers;
+    for (int n = 0; n < 8; n++)
+        readers.emplace_back([&]()
+        {
+            while (!stop)
+            {
+                const auto snapshot = container.readSnapshot();
+                const auto expected = snapshot->find(cid, {system, 1, 1})->standardModules.position.getPosition(axis_t::X);
+                for (int point = 2; point <= pointCount; point++)
+                    if (snapshot->find(cid, {system, 1, point})->standardModules.position.getPosition(axis_t::X) != expected)
+                        mixed++;
+            }
+        });
+
+    for (position_t position = 1; position <= 500; position++)
+    {
+        addPoints(container, cid, system, pointCount, position);
+        container.publishSnapshot();
+    }
+    stop = true;
+    for (auto &reader : readers)
+        reader.join();
+
+    QCOMPARE(mixed.load(), 0);
+    QCOMPARE(container.readSnapshot()->find(cid, {system, 1, pointCount})->standardModules.position.getPosition(axis_t::X), position_t(500));
+}
+
+void TEST_OTP::Snapshot::benchmarkReaders_data()
+{
+    QTest::addColumn<int>("threads");
+    QTest::addColumn<bool>("locked");
+    for (const auto threads : {1, 2, 4, 8, 16})
+    {
+        QTest::newRow(qPrintable(QString("Snapshot, %1 readers").arg(threads))) << threads << false;
+        QTest::newRow(qPrintable(QString("Locked, %1 readers").arg(threads))) << threads << true;
+    }
+}
+
+void TEST_OTP::Snapshot::benchmarkReaders()
+{
+    // Each reader polls every point's winning position, as a render thread would
+    QFETCH(int, threads);
+    QFETCH(bool, locked);
+    constexpr int pointCount = 1000;
+    constexpr int passes = 50;
+
+    Container container;
+    const auto cid = cid_t::createUuid();
+    const system_t system = 1;
+    container.addComponent(cid, QHostAddress::LocalHost);
+    addPoints(container, cid, system, pointCount, 1);
+    container.publishSnapshot();
+
+    std::atomic<qint64> total{0};
+    QBENCHMARK {
+        std::vector<std::thread> readers;
+        for (int n = 0; n < threads; n++)
+            readers.emplace_back([&]()
+            {
+                qint64 sum = 0;
+                for (int pass = 0; pass < passes; pass++)
+                    for (int point = 1; point <= pointCount; point++)
+                    {
+                        const address_t address = {system, 1, point};
+                        if (locked)
+                        {
+                            // As Consumer getters did before snapshots
+                            const auto winner = container.getWinningComponent(address);
+                            if (!container.isValid(winner, address)) continue;
+                            sum += container.PointDetails(winner, address)->standardModules.position.getPosition(axis_t::X);
+                        } else {
+                            const auto snapshot = container.readSnapshot();
+                            if (const auto details = snapshot->find(snapshot->getWinner(address), address))
+                                sum += details->standardModules.position.getPosition(axis_t::X);
+                        }
+                    }
+                total += sum;
+            });
+        for (auto &reader : readers)
+            reader.join();
+    }
+    QVERIFY(total > 0);
+}
@@ -0,0 +1,30 @@
+#ifndef TEST_SNAPSHOT_H
+#define TEST_SNAPSHOT_H
+
+#include <QtTest/QTest>
+
+#include "container.hpp"
+
+namespace TEST_OTP
+{
+    class Snapshot : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        Snapshot() = default;
+        ~Snapshot() = default;
+
+    private slots:
+        void epochPointer();
+        void reclaim();
+        void publish();
+        void referenceFrames();
+        void concurrentReaders();
+
+        void benchmarkReaders_data();
+        void benchmarkReaders();
+    };
+}
+
+#endif // TEST_SNAPSHOT_H
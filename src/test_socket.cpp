@@ -0,0 +1,138 @@
+#include "test_socket.hpp"
+#include "const.hpp"
+#include "network/messages/message_const.hpp"
+
+int test_socket(int argc, char *argv[])
+{
+    QCoreApplication app(argc, argv);
+    TEST_OTP::SocketManager testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::SocketManager::initTestCase()
+{
+    const auto interfaces = QNetworkInterface::allInterfaces();
+    for (const auto &interface : interfaces)
+        if (interface.flags().testFlag(QNetworkInterface::IsLoopBack)
+                && interface.flags().testFlag(QNetworkInterface::IsUp))
+        {
+            iface = interface;
+            break;
+        }
+    if (!iface.isValid())
+        QSKIP("No loopback interface available");
+
+    datagram = QNetworkDatagram(
+                QByteArray(static_cast<int>(OTP::MESSAGES::OTPTransformMessage::RANGES::MESSAGE_SIZE.getMax()), '\0'),
+                OTP::OTP_Transform_Message_IPv4,
+                OTP::OTP_PORT);
+}
+
+void TEST_OTP::SocketManager::writeDatagram()
+{
+    auto socket = OTP::SocketManager::getSocket(iface, QAbstractSocket::IPv4Protocol);
+    QVERIFY(socket);
+    QVERIFY(socket->writeDatagram(datagram));
+    QVERIFY(socket->writeDatagram(datagram));
+}
+
+void TEST_OTP::SocketManager::writeDatagrams()
+{
+    auto socket = OTP::SocketManager::getSocket(iface, QAbstractSocket::IPv4Protocol);
+    QVERIFY(socket);
+
+    // Full folio of equally sized pages, with a shorter final page
+    QList<QNetworkDatagram> folio;
+    for (int page = 0; page < 16; page++)
+        folio.append(datagram);
+    auto lastPage = datagram;
+    lastPage.setData(datagram.data().left(static_cast<int>(OTP::MESSAGES::OTPTransformMessage::RANGES::MESSAGE_SIZE.getMin())));
+    folio.append(lastPage);
+
+    const auto before = socket->getTXStatistics();
+    QVERIFY(OTP::SocketManager::writeDatagrams(iface, folio));
+    const auto after = socket->getTXStatistics();
+    QCOMPARE(after.datagrams - before.datagrams, static_cast<quint64>(folio.count()));
+    QVERIFY(after.syscalls - before.syscalls <= static_cast<quint64>(folio.count()));
+#if defined(Q_OS_LINUX)
+    QVERIFY(after.syscallsSaved() > before.syscallsSaved());
+#endif
+    qDebug() << "Syscalls saved" << after.syscallsSaved() - before.syscallsSaved() << "of" << folio.count();
+
+    // Mixed transports handed to a single socket, every IPv4 datagram must still be sent
+    QList<QNetworkDatagram> mixed;
+    for (int page = 0; page < 4; page++)
+    {
+        mixed.append(datagram);
+        mixed.append(QNetworkDatagram(datagram.data(), OTP::OTP_Transform_Message_IPv6, OTP::OTP_PORT));
+    }
+    mixed.append(datagram);
+    const auto mixedBefore = socket->getTXStatistics();
+    socket->writeDatagrams(mixed);
+    const auto mixedAfter = socket->getTXStatistics();
+    QVERIFY(mixedAfter.datagrams - mixedBefore.datagrams >= 5);
+}
+
+void TEST_OTP::SocketManager::receiveThread()
+{
+    auto socket = OTP::SocketManager::getSocket(iface, QAbstractSocket::IPv4Protocol);
+    QVERIFY(socket);
+    if (!socket->setRXMode(OTP::SocketManager::Thread))
+        QSKIP("Receive thread not supported on this platform");
+    QCOMPARE(socket->getRXMode(), OTP::SocketManager::Thread);
+    if (!socket->joinMulticastGroup(OTP::OTP_Advertisement_Message_IPv4))
+        QSKIP("Unable to join multicast group on loopback interface");
+
+    QSignalSpy spy(socket.get(), &OTP::SocketManager::newDatagram);
+    const auto payload = QByteArray("receiveThread");
+    QVERIFY(socket->writeDatagram(QNetworkDatagram(payload, OTP::OTP_Advertisement_Message_IPv4, OTP::OTP_PORT)));
+
+    auto received = [&spy, &payload]() {
+        for (const auto &args : qAsConst(spy))
+        {
+            const auto datagram = args.at(0).value<QNetworkDatagram>();
+            if (datagram.data() == payload)
+                return datagram.destinationAddress() == OTP::OTP_Advertisement_Message_IPv4;
+        }
+        return false;
+    };
+    QTRY_VERIFY(received());
+    QVERIFY(socket->getRXStatistics().datagrams > 0);
+
+    socket->leaveMulticastGroup(OTP::OTP_Advertisement_Message_IPv4);
+    QVERIFY(socket->setRXMode(OTP::SocketManager::EventLoop));
+}
+
+void TEST_OTP::SocketManager::benchmarkPerDatagramSocket()
+{
+    // Previous behaviour, a new socket bound and configured for every datagram
+    QBENCHMARK {
+        auto socket = QUdpSocket();
+        const auto addressEntries = iface.addressEntries();
+        for (const auto &ifaceAddr : addressEntries)
+            if (ifaceAddr.ip().protocol() == QAbstractSocket::IPv4Protocol)
+                socket.bind(ifaceAddr.ip());
+        socket.setSocketOption(QAbstractSocket::MulticastLoopbackOption, QVariant(1));
+        socket.setMulticastInterface(iface);
+        socket.writeDatagram(datagram);
+    }
+}
+
+void TEST_OTP::SocketManager::benchmarkPersistentSocket()
+{
+    auto socket = OTP::SocketManager::getSocket(iface, QAbstractSocket::IPv4Protocol);
+    QBENCHMARK {
+        socket->writeDatagram(datagram);
+    }
+}
+
+void TEST_OTP::SocketManager::benchmarkBatchedSocket()
+{
+    auto socket = OTP::SocketManager::getSocket(iface, QAbstractSocket::IPv4Protocol);
+    QList<QNetworkDatagram> folio;
+    for (int page = 0; page < 16; page++)
+        folio.append(datagram);
+    QBENCHMARK {
+        socket->writeDatagrams(folio);
+    }
+}
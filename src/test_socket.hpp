@@ -0,0 +1,35 @@
+#ifndef TEST_SOCKET_H
+#define TEST_SOCKET_H
+
+#include <QtTest/QTest>
+#include <QtTest/QSignalSpy>
+
+#include "socket.hpp"
+
+namespace TEST_OTP
+{
+    class SocketManager : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        SocketManager() = default;
+        ~SocketManager() = default;
+
+    private slots:
+        void initTestCase();
+
+        void writeDatagram();
+        void writeDatagrams();
+        void receiveThread();
+        void benchmarkPerDatagramSocket();
+        void benchmarkPersistentSocket();
+        void benchmarkBatchedSocket();
+
+    private:
+        QNetworkInterface iface;
+        QNetworkDatagram datagram;
+    };
+}
+
+#endif // TEST_SOCKET_H
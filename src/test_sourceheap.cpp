@@ -0,0 +1,100 @@
+#include "test_sourceheap.hpp"
+#include <QRandomGenerator>
+#include <QMap>
+
+using heap_t = OTP::sourceHeap_t<int>;
+
+int test_sourceheap(int argc, char *argv[])
+{
+    TEST_OTP::SourceHeap testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::SourceHeap::priority()
+{
+    heap_t heap;
+    QVERIFY(heap.isEmpty());
+
+    heap.set(1, 100, 1);
+    QCOMPARE(heap.top(), 1);
+    heap.set(2, 150, 2);
+    QCOMPARE(heap.top(), 2);
+    heap.set(3, 50, 3);
+    QCOMPARE(heap.top(), 2);
+    QCOMPARE(heap.size(), 3);
+    QVERIFY(heap.contains(3));
+    QVERIFY(!heap.contains(4));
+}
+
+void TEST_OTP::SourceHeap::ties()
+{
+    heap_t heap;
+    heap.set(1, 100, 1);
+    heap.set(2, 100, 2);
+    QCOMPARE(heap.top(), 2);
+
+    // Unchanged priority keeps its rank
+    heap.set(1, 100, 3);
+    QCOMPARE(heap.top(), 2);
+}
+
+void TEST_OTP::SourceHeap::change()
+{
+    heap_t heap;
+    heap.set(1, 100, 1);
+    heap.set(2, 150, 2);
+    heap.set(3, 120, 3);
+
+    heap.set(2, 50, 4);
+    QCOMPARE(heap.top(), 3);
+    heap.set(1, 200, 5);
+    QCOMPARE(heap.top(), 1);
+    heap.set(2, 200, 6);
+    QCOMPARE(heap.top(), 2);
+    QCOMPARE(heap.size(), 3);
+}
+
+void TEST_OTP::SourceHeap::remove()
+{
+    heap_t heap;
+    heap.set(1, 100, 1);
+    heap.set(2, 150, 2);
+    heap.set(3, 120, 3);
+
+    QVERIFY(heap.remove(2));
+    QVERIFY(!heap.remove(2));
+    QCOMPARE(heap.top(), 3);
+    QVERIFY(heap.remove(1));
+    QCOMPARE(heap.top(), 3);
+    QVERIFY(heap.remove(3));
+    QVERIFY(heap.isEmpty());
+}
+
+void TEST_OTP::SourceHeap::random()
+{
+    // Compared with a linear search of every source
+    heap_t heap;
+    QMap<int, std::pair<int, quint64>> sources; // Priority and sequence, by source
+    auto *random = QRandomGenerator::global();
+    for (quint64 sequence = 1; sequence <= 10000; sequence++)
+    {
+        const auto source = static_cast<int>(random->bounded(20));
+        if (random->bounded(4) == 0)
+        {
+            QCOMPARE(heap.remove(source), sources.contains(source));
+            sources.remove(source);
+        } else {
+            const auto priority = static_cast<int>(random->bounded(5)) * 50;
+            heap.set(source, OTP::priority_t(priority), sequence);
+            if (!sources.contains(source) || (sources.value(source).first != priority))
+                sources.insert(source, {priority, sequence});
+        }
+
+        QCOMPARE(heap.size(), static_cast<int>(sources.size()));
+        if (sources.isEmpty()) continue;
+        auto expected = sources.cbegin();
+        for (auto it = sources.cbegin(); it != sources.cend(); ++it)
+            if (it.value() > expected.value()) expected = it;
+        QCOMPARE(heap.top(), expected.key());
+    }
+}
@@ -0,0 +1,27 @@
+#ifndef TEST_SOURCEHEAP_H
+#define TEST_SOURCEHEAP_H
+
+#include <QtTest/QTest>
+
+#include "sourceheap.hpp"
+
+namespace TEST_OTP
+{
+    class SourceHeap : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        SourceHeap() = default;
+        ~SourceHeap() = default;
+
+    private slots:
+        void priority();
+        void ties();
+        void change();
+        void remove();
+        void random();
+    };
+}
+
+#endif // TEST_SOURCEHEAP_H
@@ -0,0 +1,94 @@
+#include "test_timingwheel.hpp"
+
+using wheel_t = OTP::timingWheel_t<int>;
+using namespace std::chrono_literals;
+
+namespace
+{
+    // Number of ticks until each key is due
+    QMap<int, int> run(wheel_t &wheel, int ticks)
+    {
+        QMap<int, int> ret;
+        for (int tick = 1; tick <= ticks; tick++)
+            wheel.tick([&ret, tick](int key) { ret.insert(key, tick); });
+        return ret;
+    }
+}
+
+int test_timingwheel(int argc, char *argv[])
+{
+    TEST_OTP::TimingWheel testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::TimingWheel::due()
+{
+    wheel_t wheel(100ms, 8);
+    QVERIFY(wheel.schedule(1, 0ms));
+    QVERIFY(wheel.schedule(2, 100ms));
+    QVERIFY(wheel.schedule(3, 101ms));
+    QVERIFY(wheel.schedule(4, 500ms));
+    QCOMPARE(wheel.size(), 4);
+
+    const auto due = run(wheel, 10);
+    QCOMPARE(due.value(1), 1);
+    QCOMPARE(due.value(2), 1);
+    QCOMPARE(due.value(3), 2);
+    QCOMPARE(due.value(4), 5);
+    QCOMPARE(wheel.size(), 0);
+}
+
+void TEST_OTP::TimingWheel::rounds()
+{
+    wheel_t wheel(100ms, 8);
+    run(wheel, 3);
+    QVERIFY(wheel.schedule(1, 800ms));
+    QVERIFY(wheel.schedule(2, 900ms));
+    QVERIFY(wheel.schedule(3, 2500ms));
+
+    const auto due = run(wheel, 30);
+    QCOMPARE(due.value(1), 8);
+    QCOMPARE(due.value(2), 9);
+    QCOMPARE(due.value(3), 25);
+}
+
+void TEST_OTP::TimingWheel::duplicate()
+{
+    wheel_t wheel(100ms, 8);
+    QVERIFY(wheel.schedule(1, 200ms));
+    QVERIFY(!wheel.schedule(1, 500ms));
+    QVERIFY(wheel.isScheduled(1));
+
+    const auto due = run(wheel, 10);
+    QCOMPARE(due.size(), 1);
+    QCOMPARE(due.value(1), 2);
+    QVERIFY(!wheel.isScheduled(1));
+}
+
+void TEST_OTP::TimingWheel::cancel()
+{
+    wheel_t wheel(100ms, 8);
+    QVERIFY(wheel.schedule(1, 200ms));
+    wheel.cancel(1);
+    QVERIFY(!wheel.isScheduled(1));
+
+    // Cancelled entry must not fire for a new schedule of the same key
+    QVERIFY(wheel.schedule(1, 400ms));
+    const auto due = run(wheel, 10);
+    QCOMPARE(due.size(), 1);
+    QCOMPARE(due.value(1), 4);
+}
+
+void TEST_OTP::TimingWheel::reschedule()
+{
+    wheel_t wheel(100ms, 8);
+    QVERIFY(wheel.schedule(1, 100ms));
+
+    QList<int> due;
+    for (int tick = 1; tick <= 20; tick++)
+        wheel.tick([&wheel, &due, tick](int key) {
+            due.append(tick);
+            if (due.size() < 3) wheel.schedule(key, 800ms);
+        });
+    QCOMPARE(due, QList<int>({1, 9, 17}));
+}
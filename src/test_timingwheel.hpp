@@ -0,0 +1,27 @@
+#ifndef TEST_TIMINGWHEEL_H
+#define TEST_TIMINGWHEEL_H
+
+#include <QtTest/QTest>
+
+#include "timingwheel.hpp"
+
+namespace TEST_OTP
+{
+    class TimingWheel : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        TimingWheel() = default;
+        ~TimingWheel() = default;
+
+    private slots:
+        void due();
+        void rounds();
+        void duplicate();
+        void cancel();
+        void reschedule();
+    };
+}
+
+#endif // TEST_TIMINGWHEEL_H
@@ -0,0 +1,127 @@
+#include "test_triplebuffer.hpp"
+#include <QVector>
+#include <deque>
+#include <thread>
+
+using buffer_t = OTP::tripleBuffer_t<QVector<int>>;
+
+int test_triplebuffer(int argc, char *argv[])
+{
+    TEST_OTP::TripleBuffer testObject;
+    return QTest::qExec(&testObject, argc, argv);
+}
+
+void TEST_OTP::TripleBuffer::latest()
+{
+    buffer_t buffer;
+    QVERIFY(buffer.read()->isEmpty());
+
+    auto value = buffer.beginWrite();
+    QVERIFY(value);
+    *value = {1, 2, 3};
+    QVERIFY(buffer.read()->isEmpty());
+    buffer.publish();
+    QCOMPARE(*buffer.read(), QVector<int>({1, 2, 3}));
+
+    // Written in place, over an older value
+    value = buffer.beginWrite();
+    QVERIFY(value);
+    QVERIFY(value != buffer.read().get());
+    *value = {4};
+    buffer.publish();
+    QCOMPARE(*buffer.read(), QVector<int>({4}));
+}
+
+void TEST_OTP::TripleBuffer::spare()
+{
+    buffer_t buffer;
+    {
+        // A reader holding the latest value does not block the writer
+        const auto first = buffer.read();
+        *buffer.beginWrite() = {1};
+        buffer.publish();
+        QVERIFY(first->isEmpty());
+
+        // Refused once both spare buffers are being read
+        const auto second = buffer.read();
+        *buffer.beginWrite() = {2};
+        buffer.publish();
+        QVERIFY(!buffer.beginWrite());
+        QCOMPARE(*second, QVector<int>({1}));
+        QCOMPARE(*buffer.read(), QVector<int>({2}));
+    }
+
+    // Spare again once released
+    QVERIFY(buffer.beginWrite());
+}
+
+void TEST_OTP::TripleBuffer::concurrentReaders()
+{
+    // Each value is filled with one number, so readers never see a mix
+    buffer_t buffer;
+    std::atomic<bool> stop{false};
+    std::atomic<int> mixed{0};
+    std::vector<std::thread> readers;
+    for (int n = 0; n < 8; n++)
+        readers.emplace_back([&]()
+        {
+            while (!stop)
+            {
+                const auto value = buffer.read();
+                for (const auto item : *value)
+                    if (item != value->first()) mixed++;
+            }
+        });
+
+    int published = 0;
+    for (int n = 1; n <= 5000; n++)
+    {
+        auto value = buffer.beginWrite();
+        if (!value) continue;
+        value->fill(n, 100);
+        buffer.publish();
+        published++;
+    }
+    stop = true;
+    for (auto &reader : readers)
+        reader.join();
+
+    QCOMPARE(mixed.load(), 0);
+    QVERIFY(published > 0);
+    QCOMPARE(buffer.read()->first(), buffer.read()->last());
+}
+
+void TEST_OTP::TripleBuffer::boundedReaderCount()
+{
+    // Room for 15 readers at once, far fewer than the reads made
+    OTP::tripleBuffer_t<int, 4> buffer;
+    *buffer.beginWrite() = 1;
+    buffer.publish();
+    for (int n = 0; n < 1000; n++)
+        QCOMPARE(*buffer.read(), 1);
+
+    // Readers still holding a replaced value are counted out of its buffer
+    for (int n = 2; n < 200; n++)
+    {
+        std::deque<OTP::tripleBuffer_t<int, 4>::reader_t> held;
+        for (int reader = 0; reader < 10; reader++)
+            held.emplace_back(buffer);
+
+        auto value = buffer.beginWrite();
+        QVERIFY(value);
+        *value = n;
+        buffer.publish();
+        for (int reads = 0; reads < 100; reads++)
+            QCOMPARE(*buffer.read(), n);
+        for (const auto &reader : held)
+            QCOMPARE(*reader, n - 1);
+    }
+
+    // Both spare buffers free once every reader is released
+    auto value = buffer.beginWrite();
+    QVERIFY(value);
+    *value = 0;
+    buffer.publish();
+    QVERIFY(buffer.beginWrite());
+    QCOMPARE(*buffer.read(), 0);
+}
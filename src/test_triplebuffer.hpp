@@ -0,0 +1,26 @@
+#ifndef TEST_TRIPLEBUFFER_H
+#define TEST_TRIPLEBUFFER_H
+
+#include <QtTest/QTest>
+
+#include "triplebuffer.hpp"
+
+namespace TEST_OTP
+{
+    class TripleBuffer : public QObject
+    {
+        Q_OBJECT
+
+    public:
+        TripleBuffer() = default;
+        ~TripleBuffer() = default;
+
+    private slots:
+        void latest();
+        void spare();
+        void concurrentReaders();
+        void boundedReaderCount();
+    };
+}
+
+#endif // TEST_TRIPLEBUFFER_H
@@ -0,0 +1,155 @@
+/**
+ * @file        timingwheel.hpp
+ * @brief       Hashed timing wheel
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef TIMINGWHEEL_HPP
+#define TIMINGWHEEL_HPP
+
+#include <QHash>
+#include <algorithm>
+#include <chrono>
+#include <vector>
+
+namespace OTP
+{
+    /**
+     * @internal
+     * @brief Hashed timing wheel
+     * @details Schedules many keys against a single periodic tick, each key costing O(1) to schedule and cancel.
+     * Delays longer than one revolution of the wheel wait for additional rounds.
+     *
+     * The owner calls tick() once per resolution period.
+     *
+     * @tparam Key Scheduled key type, must be hashable with qHash()
+     */
+    template <typename Key>
+    class timingWheel_t
+    {
+    public:
+        /**
+         * @brief Construct a new timing wheel
+         *
+         * @param resolution Period between each tick()
+         * @param slotCount Number of slots in one revolution of the wheel
+         */
+        explicit timingWheel_t(std::chrono::milliseconds resolution, size_t slotCount = 512) :
+            resolution(resolution),
+            wheel(slotCount)
+        {}
+
+        /**
+         * @brief Get period between each tick()
+         *
+         * @return Tick period
+         */
+        std::chrono::milliseconds getResolution() const { return resolution; }
+
+        /**
+         * @brief Schedule a key
+         * @details A key already scheduled is left unchanged
+         *
+         * @param key Key to schedule
+         * @param delay Time until key is due, rounded up to the resolution
+         * @return true Key was scheduled
+         * @return false Key was already scheduled
+         */
+        bool schedule(const Key &key, std::chrono::milliseconds delay)
+        {
+            if (scheduled.contains(key)) return false;
+
+            const auto ticks = std::max<qint64>(1, (delay.count() + resolution.count() - 1) / resolution.count());
+            const auto slot = (current + static_cast<size_t>(ticks)) % wheel.size();
+            const auto generation = ++lastGeneration;
+            wheel[slot].push_back({key, static_cast<quint64>(ticks - 1) / wheel.size(), generation});
+            scheduled.insert(key, generation);
+            return true;
+        }
+
+        /**
+         * @brief Cancel a scheduled key
+         *
+         * @param key Key to cancel
+         */
+        void cancel(const Key &key) { scheduled.remove(key); }
+
+        /**
+         * @brief Is a key scheduled
+         *
+         * @param key Key to query
+         * @return true Key is scheduled
+         * @return false Key is not scheduled
+         */
+        bool isScheduled(const Key &key) const { return scheduled.contains(key); }
+
+        /**
+         * @brief Get number of scheduled keys
+         *
+         * @return Scheduled keys
+         */
+        int size() const { return scheduled.size(); }
+
+        /**
+         * @brief Advance the wheel by one slot
+         * @details Due keys are unscheduled before being passed to expired, so may be scheduled again from it
+         *
+         * @param expired Called with each due key
+         */
+        template <typename Expired>
+        void tick(Expired expired)
+        {
+            current = (current + 1) % wheel.size();
+            auto entries = std::move(wheel[current]);
+            wheel[current].clear();
+
+            for (auto &entry : entries)
+            {
+                // Cancelled, or since rescheduled
+                const auto generation = scheduled.constFind(entry.key);
+                if ((generation == scheduled.cend()) || (generation.value() != entry.generation)) continue;
+
+                if (entry.rounds)
+                {
+                    entry.rounds--;
+                    wheel[current].push_back(std::move(entry));
+                    continue;
+                }
+
+                scheduled.remove(entry.key);
+                expired(entry.key);
+            }
+        }
+
+    private:
+        typedef struct {
+            Key key;
+            quint64 rounds;
+            quint64 generation;
+        } entry_t;
+
+        const std::chrono::milliseconds resolution;
+        std::vector<std::vector<entry_t>> wheel;
+        size_t current = 0;
+
+        QHash<Key, quint64> scheduled;
+        quint64 lastGeneration = 0;
+    };
+}
+
+#endif // TIMINGWHEEL_HPP
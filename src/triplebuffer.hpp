@@ -0,0 +1,183 @@
+/**
+ * @file        triplebuffer.hpp
+ * @brief       Triple buffer, for wait free reads of the latest value
+ * @details     Part of OTPLib - A QT interface for E1.59
+ * @authors     Marcus Birkin
+ * @copyright   Copyright (C) 2019 Marcus Birkin
+ *
+ *  This program is free software: you can redistribute it and/or modify
+ *  it under the terms of the GNU Lesser General Public License as published by
+ *  the Free Software Foundation, either version 3 of the License, or
+ *  (at your option) any later version.
+ *
+ *  This program is distributed in the hope that it will be useful,
+ *  but WITHOUT ANYs WARRANTY; without even the implied warranty of
+ *  MERCHANTABILITY or FITNESS FOR A PARTICULAR PURPOSE.  See the
+ *  GNU Lesser General Public License for more details.
+ *
+ *  You should have received a copy of the GNU Lesser General Public License
+ *  along with this program.  If not, see <https://www.gnu.org/licenses/>.
+ *
+ */
+#ifndef TRIPLEBUFFER_HPP
+#define TRIPLEBUFFER_HPP
+
+#include <QtGlobal>
+#include <array>
+#include <atomic>
+
+namespace OTP
+{
+    /**
+     * @internal
+     * @brief Triple buffer, for wait free reads of the latest value
+     * @details A single writer fills a spare buffer in place, then publishes it as the latest.
+     * Any number of readers acquire the latest buffer, without copying, using a single atomic increment.
+     * Releasing a reader is lock free.
+     *
+     * The latest buffer index and the number of readers holding it share one atomic word.
+     * On publish the writer swaps in the new index, and moves the count of readers holding the replaced buffer to that buffer.
+     * A reader of the latest buffer counts itself back out of the shared word, otherwise out of the buffer it acquired,
+     * so a buffer is spare once its count returns to zero.
+     * The shared count is therefore bounded by the readers alive at once, however many reads are made.
+     *
+     * A single reader can never hold both spare buffers, but many slow readers can.
+     * The writer is then refused a buffer, rather than waiting for them.
+     *
+     * @tparam T Value type
+     * @tparam countBits Width of the shared reader count, fewer than 2^countBits readers may be alive at once
+     */
+    template <typename T, unsigned countBits = 32>
+    class tripleBuffer_t
+    {
+        static_assert((countBits > 1) && (countBits < 62), "Reader count must leave room for the buffer index");
+
+        struct buffer_t;
+
+    public:
+        /**
+         * @brief Read access to the latest value
+         * @details The value remains valid, and unchanged, for the lifetime of the reader
+         */
+        class reader_t
+        {
+        public:
+            /**
+             * @brief Start reading
+             *
+             * @param source Buffer to read
+             */
+            explicit reader_t(const tripleBuffer_t &source) :
+                owner(source),
+                bufferIndex(tripleBuffer_t::index(source.state.fetch_add(1, std::memory_order_acq_rel))),
+                buffer(&owner.buffers[bufferIndex])
+            {}
+
+            ~reader_t()
+            {
+                // Still the latest, count out of the shared word.
+                // A held buffer cannot be written, so can not have been replaced and published again
+                auto current = owner.state.load(std::memory_order_acquire);
+                while (tripleBuffer_t::index(current) == bufferIndex)
+                {
+                    if (owner.state.compare_exchange_weak(current, current - 1,
+                            std::memory_order_acq_rel, std::memory_order_acquire))
+                        return;
+                }
+
+                // Replaced, the writer moved the count to the buffer
+                buffer->readers.fetch_sub(1, std::memory_order_release);
+            }
+
+            reader_t(const reader_t&) = delete;
+            reader_t& operator=(const reader_t&) = delete;
+
+            /**
+             * @brief Get the value
+             *
+             * @return Value
+             */
+            const T *get() const { return &buffer->value; }
+            const T *operator->() const { return &buffer->value; }
+            const T &operator*() const { return buffer->value; }
+
+        private:
+            const tripleBuffer_t &owner;
+            const size_t bufferIndex;
+            buffer_t *buffer;
+        };
+
+        tripleBuffer_t() = default;
+        tripleBuffer_t(const tripleBuffer_t&) = delete;
+        tripleBuffer_t& operator=(const tripleBuffer_t&) = delete;
+
+        /**
+         * @brief Read the latest value
+         *
+         * @return Reader, holding the value
+         */
+        reader_t read() const { return reader_t(*this); }
+
+        /**
+         * @brief Get a spare buffer to write the next value into
+         * @details Not thread safe, writing must be serialised by the caller.
+         * The buffer holds an older value, to be overwritten in place.
+         *
+         * @return Buffer to write, or nullptr if both spare buffers are still being read
+         */
+        T *beginWrite()
+        {
+            for (size_t buffer = 0; buffer < buffers.size(); buffer++)
+            {
+                if (buffer == latest) continue;
+                if (buffers[buffer].readers.load(std::memory_order_acquire) == 0)
+                {
+                    writing = buffer;
+                    return &buffers[buffer].value;
+                }
+            }
+            return nullptr;
+        }
+
+        /**
+         * @brief Publish the buffer returned by beginWrite() as the latest value
+         * @details Not thread safe, writing must be serialised by the caller.
+         */
+        void publish()
+        {
+            const auto replaced = state.exchange(static_cast<quint64>(writing) << indexShift, std::memory_order_acq_rel);
+            buffers[index(replaced)].readers.fetch_add(
+                        static_cast<qint64>(replaced & countMask),
+                        std::memory_order_relaxed);
+            latest = writing;
+        }
+
+    private:
+        static constexpr quint64 indexShift = countBits;
+        static constexpr quint64 countMask = (quint64(1) << indexShift) - 1;
+        static size_t index(quint64 word) { return static_cast<size_t>(word >> indexShift); }
+
+        struct buffer_t
+        {
+            T value = T();
+
+            /**
+             * @brief Readers still holding this buffer
+             * @details Readers still holding the latest buffer are only added once it is replaced,
+             * so this may briefly be negative while the writer moves them
+             */
+            std::atomic<qint64> readers{0};
+        };
+        mutable std::array<buffer_t, 3> buffers;
+
+        /**
+         * @brief Latest buffer index, and count of readers holding it
+         */
+        mutable std::atomic<quint64> state{0};
+
+        size_t latest = 0;
+        size_t writing = 0;
+    };
+}
+
+#endif // TRIPLEBUFFER_HPP
@@ -25,67 +25,8 @@
 
 namespace OTP
 {
-    void folioMap_t::addPage(
-        cid_t cid,
-        system_t system,
-        OTP::PDU::vector_t vector,
-        OTP::PDU::OTPLayer::folio_t folio,
-        OTP::PDU::OTPLayer::page_t page,
-        QNetworkDatagram datagram)
-    {
-        key_t key = {cid, {system, vector}};
-        if (folioMap[key].folio != folio)
-        {
-            folioMap[key].pages.clear();
-            folioMap[key].datagrams.clear();
-            folioMap[key].folio = folio;
-        }
-        folioMap[key].pages.append(page);
-        folioMap[key].datagrams.append(datagram);
-    }
-
-    bool folioMap_t::checkAllPages(
-            cid_t cid,
-            system_t system,
-            OTP::PDU::vector_t vector,
-            OTP::PDU::OTPLayer::folio_t folio,
-            OTP::PDU::OTPLayer::page_t lastPage)
-    {
-        key_t key = {cid, {system, vector}};
-        if (folioMap[key].folio != folio) return false;
-        if (folioMap[key].pages.count() != (lastPage + 1)) return false;
-        for (int page = 0; page <= lastPage; page++)
-        {
-            if (!folioMap[key].pages.contains(page)) return false;
-        }
-        return true;
-    }
-
-    QVector<QNetworkDatagram> folioMap_t::getDatagrams(
-            cid_t cid,
-            system_t system,
-            OTP::PDU::vector_t vector,
-            OTP::PDU::OTPLayer::folio_t folio)
-    {
-        key_t key = {cid, {system, vector}};
-        if (folioMap[key].folio != folio) return QVector<QNetworkDatagram>();
-        return folioMap[key].datagrams;
-    }
-
-    void folioMap_t::removeComponent(cid_t cid)
-    {
-        const auto keys = folioMap.keys();
-        for (const auto &key : keys) {
-            if (key.first == cid)
-                folioMap.remove(key);
-        }
-    }
-
     bool pointDetails::isExpired() const {
-        return (QDateTime::currentDateTime()
-                > getLastSeen().addMSecs(
-                    std::chrono::duration_cast<std::chrono::milliseconds>(
-                        OTP_TRANSFORM_DATA_LOSS_TIMEOUT).count()));
+        return CLOCK::isExpired(getLastSeenTicks(), OTP_TRANSFORM_DATA_LOSS_TIMEOUT);
     }
 
     bool address_t::isValid()
@@ -98,18 +39,11 @@ namespace OTP
 
     bool component_t::isExpired(ModuleItem_t item) const
     {
-        if (!moduleList.contains(item)) return true;
-        return (QDateTime::currentDateTime()
-                > moduleList.value(item).addMSecs(
-                    std::chrono::duration_cast<std::chrono::milliseconds>(
-                        OTP_ADVERTISEMENT_TIMEOUT).count()));
+        return CLOCK::isExpired(moduleList.value(item, CLOCK::never), OTP_ADVERTISEMENT_TIMEOUT);
     }
 
     bool component_t::isExpired() const {
-        return (QDateTime::currentDateTime()
-                > getLastSeen().addMSecs(
-                    std::chrono::duration_cast<std::chrono::milliseconds>(
-                        OTP_COMPONENT_TIMEOUT).count()));
+        return CLOCK::isExpired(getLastSeenTicks(), OTP_COMPONENT_TIMEOUT);
     }
 
     QString component_t::getModuleString(ModuleItem_t item, bool includeManf) {
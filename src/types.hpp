@@ -24,6 +24,7 @@
 
 #include "network/pdu/pdu_types.hpp"
 #include "network/modules/modules_types.hpp"
+#include "clock.hpp"
 #include <memory>
 #include <QMap>
 #include <QList>
@@ -142,7 +143,7 @@ namespace OTP
          * @param item Module item to add
          */
         void addModuleItem(const ModuleItem_t &item) {
-            moduleList[item] = QDateTime::currentDateTime();
+            moduleList[item] = CLOCK::now();
             updateLastSeen();
         }
 
@@ -178,7 +179,15 @@ namespace OTP
          * 
          * @return Last activity time
          */
-        QDateTime getLastSeen() const { return lastSeen; };
+        QDateTime getLastSeen() const { return CLOCK::toDateTime(lastSeen); };
+
+        /**
+         * @internal
+         * @brief Get the time this component was last heard from
+         * 
+         * @return Last activity time, in library clock ticks
+         */
+        CLOCK::ticks_t getLastSeenTicks() const { return lastSeen; };
 
         /**
          * @brief Is the component still active
@@ -195,13 +204,13 @@ namespace OTP
          * @details Used for component expiry checking
          * 
          */
-        void updateLastSeen() { lastSeen = QDateTime::currentDateTime(); }
+        void updateLastSeen() { lastSeen = CLOCK::now(); }
 
     private:
         name_t name;
         QHostAddress ipAddr;
-        QDateTime lastSeen;
-        QMap<ModuleItem_t, QDateTime> moduleList;
+        CLOCK::ticks_t lastSeen = CLOCK::never;
+        QMap<ModuleItem_t, CLOCK::ticks_t> moduleList;
         type_t type;
     } component_t;
     /**
@@ -211,192 +220,6 @@ namespace OTP
      */
     typedef QMap<cid_t, component_t> componentMap_t;
 
-    /**
-     * @internal
-     * @brief Folio container
-     * @details Used to assemble and access a folios split over several datagram
-     * 
-     * <b>OTP Folio:</b> An OTP Folio is a set of OTP Messages with the same folio number. 
-     * Together they make up a snapshot of information which due to its size has to be split across multiple messages.
-     * 
-     */
-    typedef struct folioMap_t {
-    private: auto noSystem() { return system_t().getMin() - 1; }
-    public:
-        /**
-         * @brief Check Folio sequence
-         * @details 
-         * The Folio Number for the relevant OTP Advertisement Message type shall be incremented by one 
-         * for every OTP Folio sent of that type. 
-         * The Folio Number for the relevant System shall be incremented by one for every OTP Folio sent for that System.
-         * Folio Numbers shall roll over from 0xFFFFFFFF to 0x00000000.
-         * 
-         * @param cid Component IDentifier of folio source
-         * @param vector OTP Advertisement Message type
-         * @param value Folio sequence to compare against previos folio message
-         * @return true Value is next in sequence
-         * @return false Value is out of sequence
-         */
-        bool checkSequence(cid_t cid, vector_t vector, OTPLayer::folio_t value)
-        {
-            return checkSequence(cid, noSystem(), vector, value);
-        }
-
-        /**
-         * @brief Check Folio sequence, for a specific system
-         * @details 
-         * The Folio Number for the relevant OTP Advertisement Message type shall be incremented by one 
-         * for every OTP Folio sent of that type. 
-         * The Folio Number for the relevant System shall be incremented by one for every OTP Folio sent for that System.
-         * Folio Numbers shall roll over from 0xFFFFFFFF to 0x00000000.
-         * 
-         * @param cid Component IDentifier of folio source
-         * @param system System to query
-         * @param vector OTP Advertisement Message type
-         * @param value Folio sequence to compare against previos folio message
-         * @return true Value is next in sequence
-         * @return false Value is out of sequence
-         */
-        bool checkSequence(cid_t cid, system_t system, vector_t vector, OTPLayer::folio_t value)
-        {
-            auto folio = folioMap[{cid,{system, vector}}];
-            auto ret = folio.checkSequence(value);
-            return ret;
-        }
-
-        /**
-         * @brief Add a new folio page to the container
-         * 
-         * @param cid Component IDentifier of folio source
-         * @param vector OTP Advertisement Message type
-         * @param folio Folio page to add
-         * @param page Page number
-         * @param datagram Raw network datagram
-         */
-        void addPage(
-                cid_t cid,
-                vector_t vector,
-                OTPLayer::folio_t folio,
-                OTPLayer::page_t page,
-                QNetworkDatagram datagram)
-        {
-            addPage(cid, noSystem(), vector, folio, page, datagram);
-        }
-
-        /**
-         * @brief Add a new folio page to the container, for a specfic system
-         * 
-         * @param cid Component IDentifier of folio source
-         * @param system System of folio source
-         * @param vector OTP Advertisement Message type
-         * @param folio Folio page to add
-         * @param page Page number
-         * @param datagram Raw network datagram
-         */
-        void addPage(
-                cid_t cid,
-                system_t system,
-                vector_t vector,
-                OTPLayer::folio_t folio,
-                OTPLayer::page_t page,
-                QNetworkDatagram datagram);
-
-        /**
-         * @brief Check we have all the expected pages for this folio
-         * 
-         * @param cid Component IDentifier of folio source
-         * @param vector OTP Advertisement Message type
-         * @param folio Folio to check
-         * @param lastPage Last page number
-         * @return true All pages are present
-         * @return false Pages are missing
-         */
-        bool checkAllPages(
-                cid_t cid,
-                vector_t vector,
-                OTPLayer::folio_t folio,
-                OTPLayer::page_t lastPage)
-        {
-            return checkAllPages(cid, noSystem(), vector, folio, lastPage);
-        }
-
-        /**
-         * @brief Check we have all the expected pages for this folio, for a specfic system
-         * 
-         * @param cid Component IDentifier of folio source
-         * @param system System of folio source
-         * @param vector OTP Advertisement Message type
-         * @param folio Folio to check
-         * @param lastPage Last page number
-         * @return true All pages are present
-         * @return false Pages are missing
-         */
-        bool checkAllPages(
-                cid_t cid,
-                system_t system,
-                vector_t vector,
-                OTPLayer::folio_t folio,
-                OTPLayer::page_t lastPage);
-
-        /**
-         * @brief Get the Datagrams for this Folio
-         * 
-         * @param cid Component IDentifier of folio source
-         * @param vector OTP Advertisement Message type
-         * @param folio Folio to retrieve
-         * @return List of datagrams
-         */
-        QVector<QNetworkDatagram> getDatagrams(
-                cid_t cid,
-                vector_t vector,
-                OTPLayer::folio_t folio)
-        {
-            return getDatagrams(cid, noSystem(), vector, folio);
-        }
-
-        /**
-         * @brief Get the Datagrams for this Folio
-         * 
-         * @param cid Component IDentifier of folio source
-         * @param system System of folio source
-         * @param vector OTP Advertisement Message type
-         * @param folio Folio to retrieve
-         * @return List of datagrams
-         */
-        QVector<QNetworkDatagram> getDatagrams(
-                cid_t cid,
-                system_t system,
-                vector_t vector,
-                OTPLayer::folio_t folio);
-
-        /**
-         * @brief Remove all folios owned by a specfic component
-         * 
-         * @param cid Component IDentifier of folio source
-         */
-        void removeComponent(cid_t cid);
-
-    private:
-        typedef std::pair<cid_t, std::pair<system_t, vector_t>> key_t;
-        struct folioMapPrivate_t {
-            folioMapPrivate_t() : folio(0) {}
-            explicit folioMapPrivate_t(OTPLayer::folio_t folio)
-                : folio(folio) {}
-
-            bool checkSequence(OTPLayer::folio_t value) { return folio.checkSequence(value); }
-
-            OTPLayer::folio_t folio;
-            QVector<OTPLayer::page_t> pages;
-            QVector<QNetworkDatagram> datagrams;
-        };
-        /**
-         * @internal
-         * @brief Underlying container of all known folios
-         * 
-         */
-        QMap<key_t, folioMapPrivate_t> folioMap; 
-    } folioMap_t;
-
     /**
      * @internal
      * @brief Details on a point
@@ -406,14 +229,14 @@ namespace OTP
     class pointDetails
     {
     public:
-        pointDetails() : lastSeen(QDateTime()) {}
+        pointDetails() {}
         /**
          * @brief Construct a new point details object
          * 
          * @param priority Points priority
          */
         pointDetails(priority_t priority) :
-            lastSeen(QDateTime::currentDateTime()),
+            lastSeen(CLOCK::now()),
             priority(priority) {}
 
         /**
@@ -424,7 +247,7 @@ namespace OTP
          */
         pointDetails(const QString &name, priority_t priority) :
             name(name),
-            lastSeen(QDateTime::currentDateTime()),
+            lastSeen(CLOCK::now()),
             priority(priority) {}
 
         /**
@@ -446,13 +269,21 @@ namespace OTP
          * 
          * @return Time of last activity 
          */
-        QDateTime getLastSeen() const { return std::max(lastSeen, standardModules.getLastSeen()); }
+        QDateTime getLastSeen() const { return CLOCK::toDateTime(getLastSeenTicks()); }
+
+        /**
+         * @internal
+         * @brief Get the time this point was last active or updated
+         * 
+         * @return Time of last activity, in library clock ticks
+         */
+        CLOCK::ticks_t getLastSeenTicks() const { return std::max(lastSeen, standardModules.getLastSeenTicks()); }
 
         /**
          * @brief Update the last active time for the point
          * 
          */
-        void updateLastSeen() { lastSeen = QDateTime::currentDateTime(); }
+        void updateLastSeen() { lastSeen = CLOCK::now(); }
 
         /**
          * @brief Is the point still active
@@ -506,20 +337,19 @@ namespace OTP
             }
 
             /**
-             * @brief et the most recent module activity for the point
+             * @brief Get the most recent module activity for the point
              * 
-             * @return Most recent activity time 
+             * @return Most recent activity time, in library clock ticks
              */
-            QDateTime getLastSeen() const
+            CLOCK::ticks_t getLastSeenTicks() const
             {
-                QDateTime ret;
-                ret = std::max(ret, position.getLastSeen());
-                ret = std::max(ret, positionVelAcc.getLastSeen());
-                ret = std::max(ret, rotation.getLastSeen());
-                ret = std::max(ret, rotationVelAcc.getLastSeen());
-                ret = std::max(ret, scale.getLastSeen());
-                ret = std::max(ret, referenceFrame.getLastSeen());
-                return ret;
+                return std::max({
+                    position.getLastSeenTicks(),
+                    positionVelAcc.getLastSeenTicks(),
+                    rotation.getLastSeenTicks(),
+                    rotationVelAcc.getLastSeenTicks(),
+                    scale.getLastSeenTicks(),
+                    referenceFrame.getLastSeenTicks()});
             }
 
             /**
@@ -619,7 +449,7 @@ namespace OTP
 
     private:
         QString name;
-        QDateTime lastSeen;
+        CLOCK::ticks_t lastSeen = CLOCK::never;
         priority_t priority;
     };
     /**
@@ -716,34 +546,6 @@ namespace OTP
         #endif
     }
 
-    /**
-     * @internal
-     * @brief Map type of point details by point
-     * 
-     */
-    typedef QHash<point_t, pointDetails_t> pointMap_t;
-
-    /**
-     * @internal
-     * @brief Map type of points by group
-     * 
-     */
-    typedef QHash<group_t, pointMap_t> groupMap_t;
-
-    /**
-     * @internal
-     * @brief Map type of groups by system
-     * 
-     */
-    typedef QHash<system_t, groupMap_t> systemMap_t;
-
-    /**
-     * @internal
-     * @brief Map type of systems by CID
-     * 
-     */
-    typedef QHash<cid_t, systemMap_t> addressMap_t;
-
     /**
      * @internal
      * @brief Range type